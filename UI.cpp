@@ -1,6 +1,10 @@
 #include "UI.h"
 #include "imgui_internal.h"
 
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
 // Version de l'application
 const char* APP_VERSION = "1.0.0";
 
@@ -9,11 +13,87 @@ const char* WheelTestApp::testModes[] = {
 	"Mode Manuel", "Mode Automatique", "Mode Enregistrement"
 };
 
+// Noms des premiers boutons (numérotation au-delà)
+static const char* defaultButtonNames[] = {
+	"X", "Square", "Circle", "Triangle",
+	"L1", "R1", "L2", "R2",
+	"Share", "Options", "L3", "R3",
+	"PS", "TouchPad", "Up", "Down",
+	"Left", "Right", "1", "2",
+	"3", "4", "5", "6", "7", "8", "9", "10", "11", "12"
+};
+
+// Compteur d'allocations: activé par défaut en debug pour vérifier qu'une frame stable n'alloue rien, dans
+// l'application seulement (WHEELTEST_APP, défini par CMake pour ImGuiSDLApp). Le banc de mesure ne paie pas
+// le compteur et la cible de fuzzing garde les opérateurs interceptés par AddressSanitizer.
+#if defined( WHEELTEST_APP ) && !defined( NDEBUG ) && !defined( WHEELTEST_COUNT_ALLOCATIONS )
+#define WHEELTEST_COUNT_ALLOCATIONS 1
+#endif
+
+#if WHEELTEST_COUNT_ALLOCATIONS
+static thread_local Uint64 threadAllocationCount = 0;
+
+void* operator new( size_t size )
+{
+	threadAllocationCount++;
+	if( void* block = malloc( size ? size : 1 ) )
+	{
+		return block;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[]( size_t size )
+{
+	return operator new( size );
+}
+
+void operator delete( void* block ) noexcept
+{
+	free( block );
+}
+
+void operator delete[]( void* block ) noexcept
+{
+	free( block );
+}
+
+void operator delete( void* block, size_t ) noexcept
+{
+	free( block );
+}
+
+void operator delete[]( void* block, size_t ) noexcept
+{
+	free( block );
+}
+
+Uint64 getThreadAllocationCount()
+{
+	return threadAllocationCount;
+}
+
+bool isAllocationCountingEnabled()
+{
+	return true;
+}
+#else
+Uint64 getThreadAllocationCount()
+{
+	return 0;
+}
+
+bool isAllocationCountingEnabled()
+{
+	return false;
+}
+#endif
+
 // =============================================================================
 // IMPLÉMENTATION DE LA CLASSE LOGGER
 // =============================================================================
 
-Logger::Logger() : toFile( false ), verbose( false )
+Logger::Logger() : toFile( false ), verbose( false ), messageCount( 0 )
 {
 }
 
@@ -83,6 +163,7 @@ void Logger::log( LogLevel level, const std::string& message )
 	}
 
 	std::string logMessage = getCurrentTimestamp() + " [" + levelStr + "] " + message;
+	messageCount++;
 
 	// Affichage console
 	printf( "%s\n", logMessage.c_str() );
@@ -145,1337 +226,6784 @@ void Logger::setLogToFile( bool logToFile, const std::string& filename )
 }
 
 // =============================================================================
-// IMPLÉMENTATION DE LA CLASSE RECORDINGMANAGER
+// IMPLÉMENTATION DE LA STRUCTURE BUTTONBITS
 // =============================================================================
 
-RecordingManager::RecordingManager() : isRecording( false ), currentTime( 0.0f )
+static int popcount64( Uint64 value )
 {
+#if defined( _MSC_VER ) && defined( _M_X64 )
+	return static_cast<int>( __popcnt64( value ) );
+#elif defined( _MSC_VER )
+	return static_cast<int>( __popcnt( static_cast<unsigned>( value ) ) + __popcnt( static_cast<unsigned>( value >> 32 ) ) );
+#else
+	return __builtin_popcountll( value );
+#endif
 }
 
-ResultCode RecordingManager::startRecording()
+// value doit être non nul
+static int countTrailingZeros64( Uint64 value )
 {
-	if( isRecording )
+#if defined( _MSC_VER ) && defined( _M_X64 )
+	unsigned long index;
+	_BitScanForward64( &index, value );
+	return static_cast<int>( index );
+#elif defined( _MSC_VER )
+	unsigned long index;
+	if( _BitScanForward( &index, static_cast<unsigned long>( value ) ) )
 	{
-		return ERROR_RECORDING_ALREADY_ACTIVE;
+		return static_cast<int>( index );
 	}
-
-	recordedData.clear();
-	startTime   = std::chrono::steady_clock::now();
-	isRecording = true;
-	currentTime = 0.0f;
-	return SUCCESS;
+	_BitScanForward( &index, static_cast<unsigned long>( value >> 32 ) );
+	return static_cast<int>( index ) + 32;
+#else
+	return __builtin_ctzll( value );
+#endif
 }
 
-ResultCode RecordingManager::stopRecording()
+void ButtonBits::clear()
 {
-	if( !isRecording )
-	{
-		return ERROR_RECORDING_NOT_ACTIVE;
-	}
-
-	isRecording = false;
-	return SUCCESS;
+	memset( words, 0, sizeof( words ) );
 }
 
-bool RecordingManager::getIsRecording() const
+bool ButtonBits::test( int index ) const
 {
-	return isRecording;
-}
+	if( index < 0 || index >= MAX_BUTTONS )
+	{
+		return false;
+	}
 
-float RecordingManager::getRecordingDuration() const
-{
-	return currentTime;
+	return ( words[index >> 6] >> ( index & 63 ) ) & 1;
 }
 
-void RecordingManager::addSnapshot( const std::vector<AxisInfo>& axes, const std::vector<bool>& buttons )
+void ButtonBits::set( int index, bool pressed )
 {
-	if( !isRecording )
+	if( index < 0 || index >= MAX_BUTTONS )
 	{
 		return;
 	}
 
-	auto   now     = std::chrono::steady_clock::now();
-	double elapsed = std::chrono::duration<double>( now - startTime ).count();
-	currentTime    = static_cast<float>( elapsed );
-
-	InputSnapshot snapshot;
-	snapshot.timestamp = elapsed;
-
-	// Enregistrer les valeurs des axes
-	for( const auto& axis : axes )
+	Uint64 mask = Uint64( 1 ) << ( index & 63 );
+	if( pressed )
 	{
-		snapshot.axisValues.push_back( axis.value );
+		words[index >> 6] |= mask;
+	}
+	else
+	{
+		words[index >> 6] &= ~mask;
 	}
-
-	// Enregistrer les états des boutons
-	snapshot.buttonStates = buttons;
-
-	recordedData.push_back( snapshot );
 }
 
-bool RecordingManager::getSnapshotAtTime( float time, InputSnapshot& outSnapshot )
+int ButtonBits::count() const
 {
-	if( recordedData.empty() )
+	int total = 0;
+	for( int w = 0; w < BUTTON_WORDS; ++w )
 	{
-		return false;
+		total += popcount64( words[w] );
 	}
 
-	// Trouver le snapshot le plus proche du temps demandé
-	auto it = std::lower_bound(
-		recordedData.begin(),
-		recordedData.end(),
-		time,
-		[]( const InputSnapshot& snapshot, double t )
-		{
-			return snapshot.timestamp < t;
-		}
-	);
+	return total;
+}
 
-	if( it == recordedData.end() )
-	{
-		outSnapshot = recordedData.back();
-	}
-	else if( it == recordedData.begin() )
+int ButtonBits::findNext( int from ) const
+{
+	if( from < 0 )
 	{
-		outSnapshot = *it;
+		from = 0;
 	}
-	else
-	{
-		auto prevIt = it - 1;
-
-		// Interpolation linéaire entre les deux snapshots les plus proches
-		double t1     = prevIt->timestamp;
-		double t2     = it->timestamp;
-		double factor = ( time - t1 ) / ( t2 - t1 );
 
-		outSnapshot.timestamp = time;
-		outSnapshot.axisValues.resize( it->axisValues.size() );
-		outSnapshot.buttonStates = it->buttonStates; // Les boutons ne sont pas interpolés
+	for( int w = from >> 6; w < BUTTON_WORDS; ++w )
+	{
+		// Masquer les bits avant le point de départ dans le premier mot
+		Uint64 bits = words[w];
+		if( w == ( from >> 6 ) )
+		{
+			bits &= ~Uint64( 0 ) << ( from & 63 );
+		}
 
-		for( size_t i = 0; i < it->axisValues.size(); ++i )
+		if( bits )
 		{
-			outSnapshot.axisValues[i] = static_cast<float>(
-				prevIt->axisValues[i] + factor * ( it->axisValues[i] - prevIt->axisValues[i] )
-			);
+			return ( w << 6 ) + countTrailingZeros64( bits );
 		}
 	}
 
-	return true;
+	return -1;
 }
 
-ResultCode RecordingManager::saveRecording( const std::string& filename )
+bool ButtonBits::operator==( const ButtonBits& other ) const
 {
-	if( recordedData.empty() )
+	Uint64 diff = 0;
+	for( int w = 0; w < BUTTON_WORDS; ++w )
 	{
-		return ERROR_INVALID_PARAMETER;
+		diff |= words[w] ^ other.words[w];
 	}
 
-	std::ofstream file( filename, std::ios::binary );
-	if( !file.is_open() )
-	{
-		return ERROR_FILE_OPEN_FAILED;
-	}
+	return diff == 0;
+}
 
-	// Écrire le nombre d'instantanés
-	size_t count = recordedData.size();
-	file.write( reinterpret_cast<const char*>( &count ), sizeof( count ) );
+bool ButtonBits::operator!=( const ButtonBits& other ) const
+{
+	return !( *this == other );
+}
 
-	// Écrire les dimensions (nombre d'axes et de boutons)
-	if( !recordedData.empty() )
+ButtonBits ButtonBits::operator^( const ButtonBits& other ) const
+{
+	ButtonBits result;
+	for( int w = 0; w < BUTTON_WORDS; ++w )
 	{
-		size_t axisCount   = recordedData[0].axisValues.size();
-		size_t buttonCount = recordedData[0].buttonStates.size();
-		file.write( reinterpret_cast<const char*>( &axisCount ), sizeof( axisCount ) );
-		file.write( reinterpret_cast<const char*>( &buttonCount ), sizeof( buttonCount ) );
+		result.words[w] = words[w] ^ other.words[w];
 	}
 
-	// Écrire les données
-	for( const auto& snapshot : recordedData )
-	{
-		file.write( reinterpret_cast<const char*>( &snapshot.timestamp ), sizeof( snapshot.timestamp ) );
-
-		for( const auto& axisValue : snapshot.axisValues )
-		{
-			file.write( reinterpret_cast<const char*>( &axisValue ), sizeof( axisValue ) );
-		}
-
-		for( const auto& buttonState : snapshot.buttonStates )
-		{
-			file.write( reinterpret_cast<const char*>( &buttonState ), sizeof( buttonState ) );
-		}
-	}
+	return result;
+}
 
-	if( file.fail() )
+ButtonBits ButtonBits::operator&( const ButtonBits& other ) const
+{
+	ButtonBits result;
+	for( int w = 0; w < BUTTON_WORDS; ++w )
 	{
-		return ERROR_FILE_WRITE_FAILED;
+		result.words[w] = words[w] & other.words[w];
 	}
 
-	file.close();
-	return SUCCESS;
+	return result;
 }
 
-ResultCode RecordingManager::loadRecording( const std::string& filename )
+ButtonBits ButtonBits::operator|( const ButtonBits& other ) const
 {
-	std::ifstream file( filename, std::ios::binary );
-	if( !file.is_open() )
+	ButtonBits result;
+	for( int w = 0; w < BUTTON_WORDS; ++w )
 	{
-		return ERROR_FILE_OPEN_FAILED;
+		result.words[w] = words[w] | other.words[w];
 	}
 
-	recordedData.clear();
-
-	// Lire le nombre d'instantanés
-	size_t count = 0;
-	file.read( reinterpret_cast<char*>( &count ), sizeof( count ) );
+	return result;
+}
 
-	// Lire les dimensions
-	size_t axisCount   = 0;
-	size_t buttonCount = 0;
-	file.read( reinterpret_cast<char*>( &axisCount ), sizeof( axisCount ) );
-	file.read( reinterpret_cast<char*>( &buttonCount ), sizeof( buttonCount ) );
+ButtonBits ButtonBits::pressedEdges( const ButtonBits& previous, const ButtonBits& current )
+{
+	return ( previous ^ current ) & current;
+}
 
-	// Lire les données
-	for( size_t i = 0; i < count; ++i )
-	{
-		InputSnapshot snapshot;
+ButtonBits ButtonBits::releasedEdges( const ButtonBits& previous, const ButtonBits& current )
+{
+	return ( previous ^ current ) & previous;
+}
 
-		file.read( reinterpret_cast<char*>( &snapshot.timestamp ), sizeof( snapshot.timestamp ) );
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE RECORDINGOVERVIEW
+// =============================================================================
 
-		snapshot.axisValues.resize( axisCount );
-		for( size_t j = 0; j < axisCount; ++j )
-		{
-			file.read( reinterpret_cast<char*>( &snapshot.axisValues[j] ), sizeof( float ) );
-		}
+// Versions uniques entre toutes les vues: une vue remplacée par une nouvelle est toujours détectée
+static std::atomic<Uint32> overviewVersions( 0 );
 
-		snapshot.buttonStates.resize( buttonCount );
-		for( size_t j = 0; j < buttonCount; ++j )
-		{
-			bool tempBool;
-			file.read( reinterpret_cast<char*>( &tempBool ), sizeof( bool ) );
-			snapshot.buttonStates[j] = tempBool;
-		}
+RecordingOverview::RecordingOverview() : buttonCount( 0 ), version( 0 )
+{
+}
 
-		recordedData.push_back( snapshot );
+void RecordingOverview::build( const std::vector<InputSnapshot>& snapshots, int numButtons )
+{
+	clear();
+	if( snapshots.empty() )
+	{
+		return;
 	}
 
-	if( file.fail() )
+	// Colonnes par axe: chaque niveau se lit de façon contiguë
+	size_t count     = snapshots.size();
+	size_t axisCount = snapshots[0].axisValues.size();
+	for( const auto& snapshot : snapshots )
 	{
-		recordedData.clear();
-		return ERROR_FILE_READ_FAILED;
+		axisCount = std::min( axisCount, snapshot.axisValues.size() );
 	}
 
-	file.close();
+	times.resize( count );
+	buttons.resize( count );
+	buttonCount = numButtons;
+	values.assign( axisCount, std::vector<float>( count ) );
+	for( size_t i = 0; i < count; ++i )
+	{
+		times[i]   = snapshots[i].timestamp;
+		buttons[i] = snapshots[i].buttonStates;
+		for( size_t axis = 0; axis < axisCount; ++axis )
+		{
+			values[axis][i] = snapshots[i].axisValues[axis];
+		}
+	}
 
-	if( !recordedData.empty() )
+	// Chaque niveau divise le nombre de seaux par deux jusqu'à un seul seau
+	levels.resize( axisCount );
+	for( size_t axis = 0; axis < axisCount; ++axis )
 	{
-		currentTime = static_cast<float>( recordedData.back().timestamp );
+		const float* lowerMin = values[axis].data();
+		const float* lowerMax = values[axis].data();
+		size_t       lower    = count;
+
+		while( lower > 1 )
+		{
+			size_t upper = ( lower + 1 ) / 2;
+			levels[axis].emplace_back();
+			Level& level = levels[axis].back();
+			level.mins.resize( upper );
+			level.maxs.resize( upper );
+
+			for( size_t i = 0; i < upper; ++i )
+			{
+				size_t second = std::min( 2 * i + 1, lower - 1 );
+				level.mins[i] = std::min( lowerMin[2 * i], lowerMin[second] );
+				level.maxs[i] = std::max( lowerMax[2 * i], lowerMax[second] );
+			}
+
+			lowerMin = level.mins.data();
+			lowerMax = level.maxs.data();
+			lower    = upper;
+		}
 	}
+}
 
-	return SUCCESS;
+void RecordingOverview::clear()
+{
+	times.clear();
+	values.clear();
+	levels.clear();
+	buttons.clear();
+	buttonCount = 0;
+	version     = ++overviewVersions;
 }
 
-float RecordingManager::getTotalDuration() const
+const std::vector<double>& RecordingOverview::getTimes() const
 {
-	if( recordedData.empty() )
-	{
-		return 0.0f;
-	}
-	return static_cast<float>( recordedData.back().timestamp );
+	return times;
 }
 
-bool RecordingManager::hasRecording() const
+const std::vector<float>& RecordingOverview::getValues( int axis ) const
 {
-	return !recordedData.empty();
+	return values[axis];
 }
 
-// =============================================================================
-// IMPLÉMENTATION DE LA CLASSE AUTOTESTMANAGER
-// =============================================================================
+const std::vector<ButtonBits>& RecordingOverview::getButtons() const
+{
+	return buttons;
+}
 
-AutoTestManager::AutoTestManager() : isRunning( false ), startTime( 0.0f ), currentTime( 0.0f ),
-									 duration( 30.0f ), testButtons( true ), testAxes( true ), testFFB( false )
+int RecordingOverview::getButtonCount() const
 {
+	return buttonCount;
 }
 
-ResultCode AutoTestManager::startTest( float testDuration, bool buttons, bool axes, bool ffb )
+bool RecordingOverview::isEmpty() const
 {
-	duration    = testDuration;
-	testButtons = buttons;
-	testAxes    = axes;
-	testFFB     = ffb;
+	return times.empty();
+}
 
-	isRunning   = true;
-	startTime   = ImGui::GetTime();
-	currentTime = 0.0f;
+int RecordingOverview::getAxisCount() const
+{
+	return static_cast<int>( values.size() );
+}
 
-	return SUCCESS;
+size_t RecordingOverview::getSampleCount() const
+{
+	return times.size();
 }
 
-ResultCode AutoTestManager::stopTest()
+int RecordingOverview::getLevelCount() const
 {
-	isRunning = false;
-	return SUCCESS;
+	return levels.empty() ? ( times.empty() ? 0 : 1 ) : static_cast<int>( levels[0].size() ) + 1;
 }
 
-bool AutoTestManager::isTestRunning() const
+double RecordingOverview::getStartTime() const
 {
-	return isRunning;
+	return times.empty() ? 0.0 : times.front();
 }
 
-float AutoTestManager::getTestDuration() const
+double RecordingOverview::getEndTime() const
 {
-	return duration;
+	return times.empty() ? 0.0 : times.back();
 }
 
-float AutoTestManager::getCurrentTime() const
+Uint32 RecordingOverview::getVersion() const
 {
-	return currentTime;
+	return version;
 }
 
-float AutoTestManager::getAxisValue( int axisIndex, float time )
+int RecordingOverview::query( int axis, double startTime, double endTime, int columnCount, float* outMin, float* outMax ) const
 {
-	switch( axisIndex )
+	if( axis < 0 || axis >= values.size() || columnCount <= 0 || endTime <= startTime )
 	{
-		case 0: // Volant - mouvement sinusoïdal
-			return sinf( time * 2.0f ) * 0.8f;
-
-		case 1: // Accélérateur - accélération progressive
-			return std::min( 1.0f, time / ( duration * 0.2f ) );
+		return -1;
+	}
 
-		case 2: // Frein - pression périodique
-			return ( sinf( time * 1.5f ) + 1.0f ) * 0.5f;
+	const std::vector<float>& base       = values[axis];
+	const std::vector<Level>& axisLevels = levels[axis];
+	double                    step       = ( endTime - startTime ) / columnCount;
+	int                       coarsest   = -1;
 
-		case 3: // Embrayage - plusieurs embrayages rapides
-			return ( time - floorf( time * 0.5f ) * 2.0f ) < 1.0f ? 0.0f : 1.0f;
+	size_t first = std::lower_bound( times.begin(), times.end(), startTime ) - times.begin();
+	for( int column = 0; column < columnCount; ++column )
+	{
+		double columnEnd = startTime + ( column + 1 ) * step;
+		size_t last      = std::lower_bound( times.begin() + first, times.end(), columnEnd ) - times.begin();
+		float  low       = FLT_MAX;
+		float  high      = -FLT_MAX;
 
-		default: // Autres axes - mouvement aléatoire
-			return sinf( time * 0.5f + axisIndex * 1.3f ) * 0.8f;
-	}
-}
+		if( first == last )
+		{
+			// Zoom plus fin que l'échantillonnage: la valeur précédente est tenue (rien au-delà de la fin)
+			if( first > 0 && first < times.size() )
+			{
+				low  = base[first - 1];
+				high = base[first - 1];
+			}
+		}
 
-bool AutoTestManager::getButtonState( int buttonIndex, float time )
+		// Découper [first, last) en seaux alignés, du plus grand possible au plus petit
+		for( size_t index = first; index < last; )
+		{
+			int level = 0;
+			while( level < axisLevels.size() && ( index & ( ( static_cast<size_t>( 2 ) << level ) - 1 ) ) == 0 &&
+				   index + ( static_cast<size_t>( 2 ) << level ) <= last )
+			{
+				level++;
+			}
+
+			if( level == 0 )
+			{
+				low  = std::min( low, base[index] );
+				high = std::max( high, base[index] );
+			}
+			else
+			{
+				const Level& bucket = axisLevels[level - 1];
+				low                 = std::min( low, bucket.mins[index >> level] );
+				high                = std::max( high, bucket.maxs[index >> level] );
+			}
+
+			coarsest = std::max( coarsest, level );
+			index += static_cast<size_t>( 1 ) << level;
+		}
+
+		outMin[column] = low;
+		outMax[column] = high;
+		first          = last;
+	}
+
+	return coarsest;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE RECORDINGMANAGER
+// =============================================================================
+
+RecordingManager::RecordingManager() : buttonCount( 0 ), startTicks( 0 ), isRecording( false ), currentTime( 0.0f ), overview( std::make_shared<RecordingOverview>() )
+{
+}
+
+ResultCode RecordingManager::startRecording()
+{
+	if( isRecording )
+	{
+		return ERROR_RECORDING_ALREADY_ACTIVE;
+	}
+
+	waitForOverview();
+	recordedData.clear();
+	recordedEvents.clear();
+	overview    = std::make_shared<RecordingOverview>();
+	buttonCount = 0;
+	startTime   = std::chrono::steady_clock::now();
+	startTicks  = SDL_GetTicks();
+	isRecording = true;
+	currentTime = 0.0f;
+	return SUCCESS;
+}
+
+ResultCode RecordingManager::stopRecording()
+{
+	if( !isRecording )
+	{
+		return ERROR_RECORDING_NOT_ACTIVE;
+	}
+
+	isRecording = false;
+
+	// Index de navigation de la capture terminée, construit sans bloquer la frame
+	startOverview();
+	return SUCCESS;
+}
+
+void RecordingManager::startOverview()
+{
+	// Nouvelle vue: une comparaison en cours garde l'ancienne
+	const std::vector<InputSnapshot>* snapshots  = &recordedData;
+	int                               numButtons = buttonCount;
+	overviewTask = std::async( std::launch::async, [snapshots, numButtons]() {
+		auto built = std::make_shared<RecordingOverview>();
+		built->build( *snapshots, numButtons );
+		return built;
+	} );
+}
+
+bool RecordingManager::updateOverview()
+{
+	if( !overviewTask.valid() || overviewTask.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+	{
+		return false;
+	}
+
+	overview = overviewTask.get();
+	return true;
+}
+
+bool RecordingManager::isOverviewBuilding() const
+{
+	return overviewTask.valid();
+}
+
+void RecordingManager::waitForOverview()
+{
+	if( overviewTask.valid() )
+	{
+		overview = overviewTask.get();
+	}
+}
+
+bool RecordingManager::getIsRecording() const
+{
+	return isRecording;
+}
+
+float RecordingManager::getRecordingDuration() const
+{
+	return currentTime;
+}
+
+void RecordingManager::addSnapshot( const std::vector<AxisInfo>& axes, const ButtonBits& buttons, int numButtons )
+{
+	if( !isRecording )
+	{
+		return;
+	}
+
+	auto   now     = std::chrono::steady_clock::now();
+	double elapsed = std::chrono::duration<double>( now - startTime ).count();
+	currentTime    = static_cast<float>( elapsed );
+
+	InputSnapshot snapshot;
+	snapshot.timestamp = elapsed;
+
+	// Enregistrer les valeurs des axes
+	for( const auto& axis : axes )
+	{
+		snapshot.axisValues.push_back( axis.value );
+	}
+
+	// Enregistrer les états des boutons (copie de quelques mots)
+	snapshot.buttonStates = buttons;
+	buttonCount           = std::max( buttonCount, std::min( numButtons, MAX_BUTTONS ) );
+
+	recordedData.push_back( snapshot );
+}
+
+void RecordingManager::addEvent( const InputEvent& event )
+{
+	if( !isRecording )
+	{
+		return;
+	}
+
+	// Ramener l'horodatage SDL à l'origine de l'enregistrement
+	double origin = startTicks / 1000.0;
+	if( event.timestamp < origin )
+	{
+		return;
+	}
+
+	InputEvent recorded = event;
+	recorded.timestamp  = event.timestamp - origin;
+	recordedEvents.push_back( recorded );
+}
+
+void RecordingManager::addMarker( InputEventType type, Uint8 deviceIndex )
+{
+	if( !isRecording )
+	{
+		return;
+	}
+
+	// Même horloge que addSnapshot: le trou tombe exactement entre les instantanés qui l'encadrent
+	double elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count();
+	recordedEvents.push_back( { elapsed, type, deviceIndex, 0 } );
+}
+
+const std::vector<InputSnapshot>& RecordingManager::getSnapshots() const
+{
+	return recordedData;
+}
+
+const std::vector<InputEvent>& RecordingManager::getEvents() const
+{
+	return recordedEvents;
+}
+
+bool RecordingManager::getSnapshotAtTime( float time, InputSnapshot& outSnapshot )
+{
+	if( recordedData.empty() )
+	{
+		return false;
+	}
+
+	// Trouver le snapshot le plus proche du temps demandé
+	auto it = std::lower_bound(
+		recordedData.begin(),
+		recordedData.end(),
+		time,
+		[]( const InputSnapshot& snapshot, double t )
+		{
+			return snapshot.timestamp < t;
+		}
+	);
+
+	if( it == recordedData.end() )
+	{
+		outSnapshot = recordedData.back();
+	}
+	else if( it == recordedData.begin() )
+	{
+		outSnapshot = *it;
+	}
+	else
+	{
+		auto prevIt = it - 1;
+
+		// Interpolation linéaire entre les deux snapshots les plus proches
+		double t1     = prevIt->timestamp;
+		double t2     = it->timestamp;
+		double factor = ( time - t1 ) / ( t2 - t1 );
+
+		outSnapshot.timestamp = time;
+		outSnapshot.axisValues.resize( it->axisValues.size() );
+		outSnapshot.buttonStates = it->buttonStates; // Les boutons ne sont pas interpolés
+
+		for( size_t i = 0; i < it->axisValues.size(); ++i )
+		{
+			outSnapshot.axisValues[i] = static_cast<float>(
+				prevIt->axisValues[i] + factor * ( it->axisValues[i] - prevIt->axisValues[i] )
+			);
+		}
+	}
+
+	return true;
+}
+
+ResultCode RecordingManager::saveRecording( const std::string& filename )
+{
+	if( recordedData.empty() )
+	{
+		return ERROR_INVALID_PARAMETER;
+	}
+
+	std::ofstream file( filename, std::ios::binary );
+	if( !file.is_open() )
+	{
+		return ERROR_FILE_OPEN_FAILED;
+	}
+
+	// En-tête du format versionné
+	file.write( reinterpret_cast<const char*>( &RECORDING_MAGIC ), sizeof( RECORDING_MAGIC ) );
+	file.write( reinterpret_cast<const char*>( &RECORDING_VERSION ), sizeof( RECORDING_VERSION ) );
+
+	// Écrire le nombre d'instantanés
+	size_t count = recordedData.size();
+	file.write( reinterpret_cast<const char*>( &count ), sizeof( count ) );
+
+	// Écrire les dimensions (nombre d'axes et de boutons)
+	size_t axisCount       = recordedData[0].axisValues.size();
+	size_t numButtons      = buttonCount;
+	size_t buttonWordCount = ( numButtons + 63 ) / 64;
+	file.write( reinterpret_cast<const char*>( &axisCount ), sizeof( axisCount ) );
+	file.write( reinterpret_cast<const char*>( &numButtons ), sizeof( numButtons ) );
+
+	// Écrire les données
+	for( const auto& snapshot : recordedData )
+	{
+		file.write( reinterpret_cast<const char*>( &snapshot.timestamp ), sizeof( snapshot.timestamp ) );
+
+		for( const auto& axisValue : snapshot.axisValues )
+		{
+			file.write( reinterpret_cast<const char*>( &axisValue ), sizeof( axisValue ) );
+		}
+
+		// Boutons: mots de 64 bits (version 3)
+		file.write( reinterpret_cast<const char*>( snapshot.buttonStates.words ), buttonWordCount * sizeof( Uint64 ) );
+	}
+
+	// Écrire les transitions d'entrée dans l'ordre de réception
+	size_t eventCount = recordedEvents.size();
+	file.write( reinterpret_cast<const char*>( &eventCount ), sizeof( eventCount ) );
+	for( const auto& event : recordedEvents )
+	{
+		file.write( reinterpret_cast<const char*>( &event.timestamp ), sizeof( event.timestamp ) );
+		file.write( reinterpret_cast<const char*>( &event.type ), sizeof( event.type ) );
+		file.write( reinterpret_cast<const char*>( &event.index ), sizeof( event.index ) );
+		file.write( reinterpret_cast<const char*>( &event.value ), sizeof( event.value ) );
+	}
+
+	if( file.fail() )
+	{
+		return ERROR_FILE_WRITE_FAILED;
+	}
+
+	file.close();
+	return SUCCESS;
+}
+
+ResultCode RecordingManager::loadRecording( const std::string& filename, bool buildOverview )
+{
+	RecordingReader reader;
+	ResultCode      result = reader.open( filename );
+	if( result != SUCCESS )
+	{
+		lastError = reader.getError();
+		return result;
+	}
+	return load( reader, buildOverview );
+}
+
+// Flux en lecture seule sur un bloc mémoire, sans copie
+struct MemoryStreamBuffer : std::streambuf
+{
+	MemoryStreamBuffer( const char* data, size_t size )
+	{
+		char* begin = const_cast<char*>( data );
+		setg( begin, begin, begin + size );
+	}
+
+	pos_type seekoff( off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode ) override
+	{
+		off_type base   = direction == std::ios_base::beg ? 0 : direction == std::ios_base::cur ? gptr() - eback() : egptr() - eback();
+		off_type target = base + offset;
+		if( target < 0 || target > egptr() - eback() )
+		{
+			return pos_type( off_type( -1 ) );
+		}
+		setg( eback(), eback() + target, egptr() );
+		return pos_type( target );
+	}
+
+	pos_type seekpos( pos_type position, std::ios_base::openmode mode ) override
+	{
+		return seekoff( off_type( position ), std::ios_base::beg, mode );
+	}
+};
+
+ResultCode RecordingManager::loadRecordingFromMemory( const void* data, size_t size, bool buildOverview )
+{
+	MemoryStreamBuffer buffer( static_cast<const char*>( data ), size );
+	std::istream       input( &buffer );
+	RecordingReader    reader;
+	ResultCode         result = reader.open( input );
+	if( result != SUCCESS )
+	{
+		lastError = reader.getError();
+		return result;
+	}
+	return load( reader, buildOverview );
+}
+
+ResultCode RecordingManager::load( RecordingReader& reader, bool buildOverview )
+{
+	// Le lecteur a vérifié le nombre d'instantanés contre la taille du fichier: la réservation est bornée
+	std::vector<InputSnapshot> snapshots;
+	std::vector<InputEvent>    events;
+	RecordingChunk             chunk;
+	size_t                     axisCount = reader.getAxisCount();
+
+	snapshots.reserve( reader.getSnapshotCount() );
+	while( reader.readChunk( RecordingReader::CHUNK_SIZE, chunk ) > 0 )
+	{
+		for( size_t i = 0; i < chunk.count; ++i )
+		{
+			InputSnapshot snapshot;
+			snapshot.timestamp = chunk.times[i];
+			snapshot.axisValues.resize( axisCount );
+			for( size_t axis = 0; axis < axisCount; ++axis )
+			{
+				snapshot.axisValues[axis] = chunk.values[axis * chunk.count + i];
+			}
+			snapshot.buttonStates = chunk.buttons[i];
+			snapshots.push_back( std::move( snapshot ) );
+		}
+	}
+
+	ResultCode result = reader.hasFailed() ? ERROR_FILE_READ_FAILED : reader.readEvents( events );
+	if( result != SUCCESS )
+	{
+		lastError = reader.getError();
+		return result;
+	}
+
+	waitForOverview();
+	recordedData.swap( snapshots );
+	recordedEvents.swap( events );
+	buttonCount = reader.getButtonCount();
+	currentTime = recordedData.empty() ? 0.0f : static_cast<float>( recordedData.back().timestamp );
+	lastError.clear();
+
+	overview = std::make_shared<RecordingOverview>();
+	if( buildOverview )
+	{
+		startOverview();
+	}
+	return SUCCESS;
+}
+
+const std::string& RecordingManager::getLastError() const
+{
+	return lastError;
+}
+
+int RecordingManager::getButtonCount() const
+{
+	return buttonCount;
+}
+
+float RecordingManager::getTotalDuration() const
+{
+	if( recordedData.empty() )
+	{
+		return 0.0f;
+	}
+	return static_cast<float>( recordedData.back().timestamp );
+}
+
+bool RecordingManager::hasRecording() const
+{
+	return !recordedData.empty();
+}
+
+const RecordingOverview& RecordingManager::getOverview() const
+{
+	return *overview;
+}
+
+std::shared_ptr<const RecordingOverview> RecordingManager::getSharedOverview() const
+{
+	return overview;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE WORKERPOOL
+// =============================================================================
+
+WorkerPool::WorkerPool( size_t threadCount )
+	: task( nullptr ), count( 0 ), next( 0 ), generation( 0 ), activeCount( 0 ), stopping( false )
+{
+	if( threadCount == 0 )
+	{
+		threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+	}
+	for( size_t i = 1; i < threadCount; ++i )
+	{
+		threads.emplace_back( &WorkerPool::loop, this );
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		stopping = true;
+	}
+	wake.notify_all();
+	for( auto& thread : threads )
+	{
+		thread.join();
+	}
+}
+
+void WorkerPool::work()
+{
+	for( size_t index = next++; index < count; index = next++ )
+	{
+		( *task )( index );
+	}
+}
+
+// Chaque thread prend part à chaque lot: le suivant ne démarre qu'une fois activeCount revenu à zéro
+void WorkerPool::loop()
+{
+	Uint64                       seen = 0;
+	std::unique_lock<std::mutex> lock( mutex );
+	while( true )
+	{
+		wake.wait( lock, [&] { return stopping || generation != seen; } );
+		if( stopping )
+		{
+			return;
+		}
+		seen = generation;
+
+		lock.unlock();
+		work();
+		lock.lock();
+
+		if( --activeCount == 0 )
+		{
+			done.notify_all();
+		}
+	}
+}
+
+void WorkerPool::run( size_t taskCount, const std::function<void( size_t )>& batchTask )
+{
+	std::lock_guard<std::mutex> runLock( runMutex );
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		task        = &batchTask;
+		count       = taskCount;
+		next        = 0;
+		activeCount = threads.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	work();
+
+	std::unique_lock<std::mutex> lock( mutex );
+	done.wait( lock, [this] { return activeCount == 0; } );
+	task = nullptr;
+}
+
+// =============================================================================
+// COMPARAISON D'ENREGISTREMENTS
+// =============================================================================
+
+// Exécuter task( i ) pour chaque i < count sur les threads partagés
+static void parallelFor( size_t count, const std::function<void( size_t )>& task )
+{
+	static WorkerPool pool;
+	pool.run( count, task );
+}
+
+// Colonne interpolée linéairement sur la grille start + i * step (valeurs extrêmes tenues hors de l'enregistrement)
+static void resampleColumn( const std::vector<double>& times, const std::vector<float>& values, double start, double step, float* output, size_t count )
+{
+	size_t j = 0;
+	for( size_t i = 0; i < count; ++i )
+	{
+		double t = start + i * step;
+		while( j + 1 < times.size() && times[j + 1] <= t )
+		{
+			j++;
+		}
+
+		if( j + 1 >= times.size() || t <= times[j] )
+		{
+			output[i] = t <= times.front() ? values.front() : values[j];
+		}
+		else
+		{
+			double factor = ( t - times[j] ) / ( times[j + 1] - times[j] );
+			output[i]     = static_cast<float>( values[j] + factor * ( values[j + 1] - values[j] ) );
+		}
+	}
+}
+
+RecordingComparison compareRecordings( const RecordingOverview& reference, const RecordingOverview& candidate, float divergenceThreshold,
+									   double maxOffset )
+{
+	auto                clockStart = std::chrono::steady_clock::now();
+	RecordingComparison result     = { false, 0.0, 0.0, 0.0, 0.0, {}, {}, {} };
+
+	int axisCount = std::min( reference.getAxisCount(), candidate.getAxisCount() );
+	if( reference.getSampleCount() < 2 || candidate.getSampleCount() < 2 )
+	{
+		result.error = "enregistrements trop courts";
+		return result;
+	}
+
+	// Grille commune: intervalle médian des instantanés de la référence
+	const auto&         refTimes  = reference.getTimes();
+	const auto&         candTimes = candidate.getTimes();
+	std::vector<double> intervals;
+	size_t              stride = std::max<size_t>( 1, refTimes.size() / 4096 );
+	for( size_t i = stride; i < refTimes.size(); i += stride )
+	{
+		intervals.push_back( ( refTimes[i] - refTimes[i - stride] ) / stride );
+	}
+	std::nth_element( intervals.begin(), intervals.begin() + intervals.size() / 2, intervals.end() );
+	double step = std::max( 0.0005, std::min( 0.05, intervals[intervals.size() / 2] ) );
+
+	double refStart  = reference.getStartTime();
+	double candStart = candidate.getStartTime();
+	size_t refCount  = static_cast<size_t>( ( reference.getEndTime() - refStart ) / step ) + 1;
+	size_t candCount = static_cast<size_t>( ( candidate.getEndTime() - candStart ) / step ) + 1;
+
+	// Intercorrélation de chaque axe (signaux centrés, complétés de zéros pour éviter le repliement), en parallèle.
+	// Grille décimée pour l'alignement afin de borner la taille de la FFT sur les enregistrements longs
+	const size_t maxCorrelationSamples = 1 << 20;
+	size_t       decimation            = ( refCount + candCount + maxCorrelationSamples - 1 ) / maxCorrelationSamples;
+	double       correlationStep       = step * decimation;
+	size_t       refDecimated          = ( refCount - 1 ) / decimation + 1;
+	size_t       candDecimated         = ( candCount - 1 ) / decimation + 1;
+
+	int fftSize = 4;
+	while( static_cast<size_t>( fftSize ) < refDecimated + candDecimated )
+	{
+		fftSize <<= 1;
+	}
+
+	std::vector<std::vector<float>>               refGrid( axisCount );
+	std::vector<std::vector<float>>               candGrid( axisCount );
+	std::vector<std::vector<std::complex<float>>> cross( axisCount );
+	std::vector<double>                           refEnergy( axisCount, 0.0 );
+	std::vector<double>                           candEnergy( axisCount, 0.0 );
+
+	parallelFor( axisCount, [&]( size_t axis ) {
+		refGrid[axis].resize( refCount );
+		candGrid[axis].resize( candCount );
+		resampleColumn( refTimes, reference.getValues( static_cast<int>( axis ) ), refStart, step, refGrid[axis].data(), refCount );
+		resampleColumn( candTimes, candidate.getValues( static_cast<int>( axis ) ), candStart, step, candGrid[axis].data(), candCount );
+
+		std::vector<float> a( fftSize, 0.0f );
+		std::vector<float> b( fftSize, 0.0f );
+		for( size_t i = 0; i < refDecimated; ++i )
+		{
+			a[i] = refGrid[axis][i * decimation];
+		}
+		for( size_t i = 0; i < candDecimated; ++i )
+		{
+			b[i] = candGrid[axis][i * decimation];
+		}
+
+		double refMean  = std::accumulate( a.begin(), a.begin() + refDecimated, 0.0 ) / refDecimated;
+		double candMean = std::accumulate( b.begin(), b.begin() + candDecimated, 0.0 ) / candDecimated;
+		for( size_t i = 0; i < refDecimated; ++i )
+		{
+			a[i] = static_cast<float>( a[i] - refMean );
+			refEnergy[axis] += a[i] * a[i];
+		}
+		for( size_t i = 0; i < candDecimated; ++i )
+		{
+			b[i] = static_cast<float>( b[i] - candMean );
+			candEnergy[axis] += b[i] * b[i];
+		}
+
+		RealFFT                          fft;
+		std::vector<std::complex<float>> spectrumA;
+		std::vector<std::complex<float>> spectrumB;
+		fft.setSize( fftSize );
+		fft.forward( a.data(), spectrumA );
+		fft.forward( b.data(), spectrumB );
+
+		cross[axis].resize( spectrumA.size() );
+		for( size_t k = 0; k < spectrumA.size(); ++k )
+		{
+			cross[axis][k] = std::conj( spectrumA[k] ) * spectrumB[k];
+		}
+	} );
+
+	// Somme des intercorrélations: r[lag] = somme de a[n] * b[n + lag] (lags négatifs en fin de tableau)
+	std::vector<std::complex<float>> total( fftSize / 2 + 1, std::complex<float>( 0.0f, 0.0f ) );
+	for( const auto& spectrum : cross )
+	{
+		for( size_t k = 0; k < total.size(); ++k )
+		{
+			total[k] += spectrum[k];
+		}
+	}
+
+	std::vector<float> correlation( fftSize );
+	RealFFT            inverseFft;
+	inverseFft.setSize( fftSize );
+	inverseFft.inverse( total, correlation.data() );
+
+	auto correlationAt = [&]( int lag ) { return correlation[( lag + fftSize ) % fftSize]; };
+
+	int maxLag = static_cast<int>( std::min<double>( maxOffset / correlationStep, fftSize / 2 - 1 ) );
+	int best   = 0;
+	for( int lag = -maxLag; lag <= maxLag; ++lag )
+	{
+		if( correlationAt( lag ) > correlationAt( best ) )
+		{
+			best = lag;
+		}
+	}
+
+	// Affinage sous-échantillon par interpolation parabolique du pic
+	double refined  = best;
+	double previous = correlationAt( best - 1 );
+	double next     = correlationAt( best + 1 );
+	double curve    = previous - 2.0 * correlationAt( best ) + next;
+	if( best > -maxLag && best < maxLag && curve < 0.0 )
+	{
+		refined += 0.5 * ( previous - next ) / curve;
+	}
+
+	double energy      = sqrt( std::accumulate( refEnergy.begin(), refEnergy.end(), 0.0 ) * std::accumulate( candEnergy.begin(), candEnergy.end(), 0.0 ) );
+	result.offset      = candStart - refStart + refined * correlationStep;
+	result.correlation = energy > 0.0 ? correlationAt( best ) / energy : 0.0;
+
+	double overlapStart = std::max( refStart, candStart - result.offset );
+	double overlapEnd   = std::min( reference.getEndTime(), candidate.getEndTime() - result.offset );
+	result.overlap      = std::max( 0.0, overlapEnd - overlapStart );
+
+	// Écarts par axe sur la grille de la référence, et intervalles de boutons différents: une tâche par canal
+	result.axes.resize( axisCount );
+	parallelFor( axisCount + 1, [&]( size_t task ) {
+		if( task < axisCount )
+		{
+			const auto&     refValues  = refGrid[task];
+			const auto&     candValues = candGrid[task];
+			AxisComparison& stats      = result.axes[task];
+			double          sumSquares = 0.0;
+			size_t          compared   = 0;
+			stats                      = { 0.0, 0.0, 0.0, -1.0 };
+
+			for( size_t n = 0; n < refCount; ++n )
+			{
+				double t        = refStart + n * step;
+				double position = ( t + result.offset - candStart ) / step;
+				if( position < 0.0 || position > candCount - 1 )
+				{
+					continue;
+				}
+
+				size_t index     = static_cast<size_t>( position );
+				double factor    = position - index;
+				double candValue = index + 1 < candCount ? candValues[index] + factor * ( candValues[index + 1] - candValues[index] ) : candValues[index];
+				double deviation = fabs( refValues[n] - candValue );
+
+				sumSquares += deviation * deviation;
+				compared++;
+				if( deviation > stats.maxDeviation )
+				{
+					stats.maxDeviation     = deviation;
+					stats.maxDeviationTime = t;
+				}
+				if( stats.divergenceTime < 0.0 && deviation > divergenceThreshold )
+				{
+					stats.divergenceTime = t;
+				}
+			}
+
+			stats.rmse = compared > 0 ? sqrt( sumSquares / compared ) : 0.0;
+			return;
+		}
+
+		// Boutons: état du candidat tenu depuis son dernier instantané, comparé mot par mot. Les
+		// intervalles plus courts que deux périodes d'échantillonnage (gigue des fronts) sont ignorés
+		const auto& refButtons  = reference.getButtons();
+		const auto& candButtons = candidate.getButtons();
+		int         buttonCount = std::min( reference.getButtonCount(), candidate.getButtonCount() );
+		ButtonBits  mask;
+		ButtonBits  open;
+		double      openSince[MAX_BUTTONS];
+		double      lastTime = refStart;
+		double      jitter   = 2.0 * step;
+		size_t      j        = 0;
+
+		mask.clear();
+		open.clear();
+		for( int b = 0; b < buttonCount; ++b )
+		{
+			mask.set( b, true );
+		}
+
+		for( size_t i = 0; i < refTimes.size(); ++i )
+		{
+			double t = refTimes[i] + result.offset;
+			if( t < candTimes.front() || t > candTimes.back() )
+			{
+				continue;
+			}
+			while( j + 1 < candTimes.size() && candTimes[j + 1] <= t )
+			{
+				j++;
+			}
+
+			// Seuls les boutons dont l'état de différence change ouvrent ou ferment un intervalle
+			ButtonBits differs = ( refButtons[i] ^ candButtons[j] ) & mask;
+			ButtonBits changed = differs ^ open;
+			for( int b = changed.findNext( 0 ); b >= 0; b = changed.findNext( b + 1 ) )
+			{
+				if( differs.test( b ) )
+				{
+					openSince[b] = refTimes[i];
+				}
+				else if( refTimes[i] - openSince[b] > jitter )
+				{
+					result.buttonMismatches.push_back( { b, openSince[b], refTimes[i] } );
+				}
+			}
+
+			open     = differs;
+			lastTime = refTimes[i];
+		}
+
+		// Intervalles encore ouverts à la fin: même filtre de durée minimale
+		for( int b = open.findNext( 0 ); b >= 0; b = open.findNext( b + 1 ) )
+		{
+			if( lastTime - openSince[b] > jitter )
+			{
+				result.buttonMismatches.push_back( { b, openSince[b], lastTime } );
+			}
+		}
+
+		std::sort( result.buttonMismatches.begin(), result.buttonMismatches.end(),
+				   []( const ButtonMismatch& a, const ButtonMismatch& b ) { return a.startTime < b.startTime; } );
+	} );
+
+	result.valid     = true;
+	result.elapsedMs = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - clockStart ).count();
+	return result;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE BATCHANALYZER
+// =============================================================================
+
+BatchAnalyzer::BatchAnalyzer() : fileCount( 0 ), completedCount( 0 ), stolenCount( 0 ), elapsedSeconds( 0.0 )
+{
+}
+
+void BatchAnalyzer::analyzeRecording( const std::string& filename, RecordingManager& recording, RecordingSummary& summary )
+{
+	summary          = RecordingSummary();
+	summary.filename = filename;
+
+	if( recording.loadRecording( filename, false ) != SUCCESS )
+	{
+		summary.anomalies = ANOMALY_UNREADABLE;
+		return;
+	}
+
+	const auto& snapshots = recording.getSnapshots();
+	summary.snapshotCount = snapshots.size();
+	summary.buttonCount   = recording.getButtonCount();
+	if( snapshots.size() < 2 )
+	{
+		summary.anomalies = ANOMALY_EMPTY;
+		return;
+	}
+
+	size_t axisCount = snapshots[0].axisValues.size();
+	summary.duration = snapshots.back().timestamp - snapshots.front().timestamp;
+
+	// Statistiques par axe en une passe: moyenne et variance par l'algorithme de Welford
+	std::vector<double> means( axisCount, 0.0 );
+	std::vector<double> m2s( axisCount, 0.0 );
+	std::vector<size_t> counts( axisCount, 0 );
+
+	// Différences secondes par axe: un mouvement régulier s'annule, le bruit reste
+	std::vector<std::vector<float>> curvatures( axisCount );
+
+	std::vector<double> intervals;
+	ButtonBits          used = snapshots[0].buttonStates;
+
+	summary.axes.assign( axisCount, { FLT_MAX, -FLT_MAX, 0.0, 0.0, 0.0 } );
+	intervals.reserve( snapshots.size() - 1 );
+
+	for( size_t i = 0; i < snapshots.size(); ++i )
+	{
+		const InputSnapshot& snapshot = snapshots[i];
+		size_t               axes     = std::min( axisCount, snapshot.axisValues.size() );
+
+		for( size_t axis = 0; axis < axes; ++axis )
+		{
+			float value = snapshot.axisValues[axis];
+			if( !std::isfinite( value ) )
+			{
+				summary.anomalies |= ANOMALY_OUT_OF_RANGE;
+				continue;
+			}
+			if( fabs( value ) > 1.001f )
+			{
+				summary.anomalies |= ANOMALY_OUT_OF_RANGE;
+			}
+
+			AxisSummary& stats = summary.axes[axis];
+			stats.minValue     = std::min( stats.minValue, value );
+			stats.maxValue     = std::max( stats.maxValue, value );
+
+			double delta = value - means[axis];
+			means[axis] += delta / ++counts[axis];
+			m2s[axis] += delta * ( value - means[axis] );
+
+			if( i > 1 && axis < snapshots[i - 1].axisValues.size() && axis < snapshots[i - 2].axisValues.size() )
+			{
+				float curvature = value - 2.0f * snapshots[i - 1].axisValues[axis] + snapshots[i - 2].axisValues[axis];
+				if( std::isfinite( curvature ) )
+				{
+					curvatures[axis].push_back( fabs( curvature ) );
+				}
+			}
+		}
+
+		if( i > 0 )
+		{
+			double interval = snapshot.timestamp - snapshots[i - 1].timestamp;
+			if( interval < 0.0 )
+			{
+				summary.anomalies |= ANOMALY_TIME_BACKWARDS;
+			}
+			summary.maxGap = std::max( summary.maxGap, interval );
+			intervals.push_back( interval );
+
+			ButtonBits pressed = ButtonBits::pressedEdges( snapshots[i - 1].buttonStates, snapshot.buttonStates );
+			summary.pressCount += pressed.count();
+			used = used | pressed;
+		}
+	}
+
+	std::nth_element( intervals.begin(), intervals.begin() + intervals.size() / 2, intervals.end() );
+	summary.medianInterval = intervals[intervals.size() / 2];
+	summary.buttonsUsed    = used.count();
+	if( summary.medianInterval > 0.0 && summary.maxGap > 10.0 * summary.medianInterval )
+	{
+		summary.anomalies |= ANOMALY_GAP;
+	}
+
+	// Bruit: estimation robuste par la médiane des différences secondes (écart type 6^0.5 sigma pour un
+	// bruit blanc, médiane des valeurs absolues 0.6745 écart type), insensible aux mouvements brusques
+	bool moving = summary.pressCount > 0;
+	for( size_t axis = 0; axis < axisCount; ++axis )
+	{
+		AxisSummary& stats = summary.axes[axis];
+		if( counts[axis] == 0 )
+		{
+			stats.minValue = stats.maxValue = 0.0f;
+			continue;
+		}
+
+		stats.mean   = means[axis];
+		stats.stdDev = sqrt( m2s[axis] / counts[axis] );
+		if( !curvatures[axis].empty() )
+		{
+			auto& values = curvatures[axis];
+			std::nth_element( values.begin(), values.begin() + values.size() / 2, values.end() );
+			stats.noise = values[values.size() / 2] / ( 0.6745 * sqrt( 6.0 ) );
+		}
+		moving = moving || stats.maxValue > stats.minValue;
+
+		if( stats.noise > NOISE_THRESHOLD )
+		{
+			summary.anomalies |= ANOMALY_NOISY_AXIS;
+		}
+	}
+
+	if( !moving )
+	{
+		summary.anomalies |= ANOMALY_NO_INPUT;
+	}
+}
+
+bool BatchAnalyzer::nextTask( std::vector<std::unique_ptr<WorkQueue>>& queues, size_t worker, size_t& task )
+{
+	{
+		WorkQueue&                  own = *queues[worker];
+		std::lock_guard<std::mutex> lock( own.mutex );
+		if( !own.tasks.empty() )
+		{
+			task = own.tasks.front();
+			own.tasks.pop_front();
+			return true;
+		}
+	}
+
+	// File vide: prendre la plus petite tâche restante d'un autre thread
+	for( size_t i = 1; i < queues.size(); ++i )
+	{
+		WorkQueue&                  victim = *queues[( worker + i ) % queues.size()];
+		std::lock_guard<std::mutex> lock( victim.mutex );
+		if( !victim.tasks.empty() )
+		{
+			task = victim.tasks.back();
+			victim.tasks.pop_back();
+			stolenCount++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+ResultCode BatchAnalyzer::run( const std::string& directory, int threadCount )
+{
+	auto clockStart = std::chrono::steady_clock::now();
+
+	// Lister les enregistrements avec leur taille
+	std::vector<std::pair<uintmax_t, std::string>> found;
+	std::error_code                                error;
+	std::filesystem::directory_iterator            entry( directory, error );
+	for( ; !error && entry != std::filesystem::directory_iterator(); entry.increment( error ) )
+	{
+		std::error_code entryError;
+		if( entry->is_regular_file( entryError ) && entry->path().extension() == ".dat" )
+		{
+			uintmax_t size = entry->file_size( entryError );
+			found.emplace_back( entryError ? 0 : size, entry->path().string() );
+		}
+	}
+
+	if( error )
+	{
+		return ERROR_FILE_OPEN_FAILED;
+	}
+
+	// Les plus gros d'abord, répartis à tour de rôle: les petits fichiers équilibrent la fin
+	std::sort( found.begin(), found.end(), []( const auto& a, const auto& b ) { return a.first > b.first; } );
+
+	files.clear();
+	for( auto& file : found )
+	{
+		files.push_back( std::move( file.second ) );
+	}
+	summaries.assign( files.size(), RecordingSummary() );
+	completedCount = 0;
+	stolenCount    = 0;
+	fileCount      = files.size();
+
+	size_t workerCount = threadCount > 0 ? threadCount : std::max( 1u, std::thread::hardware_concurrency() );
+	workerCount        = std::max<size_t>( 1, std::min( workerCount, files.size() ) );
+
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	for( size_t i = 0; i < workerCount; ++i )
+	{
+		queues.push_back( std::make_unique<WorkQueue>() );
+	}
+	for( size_t i = 0; i < files.size(); ++i )
+	{
+		queues[i % workerCount]->tasks.push_back( i );
+	}
+
+	// Un RecordingManager par thread: ses tampons servent pour tous les fichiers du thread
+	auto work = [&]( size_t worker ) {
+		RecordingManager recording;
+		size_t           task = 0;
+		while( nextTask( queues, worker, task ) )
+		{
+			analyzeRecording( files[task], recording, summaries[task] );
+			completedCount++;
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for( size_t i = 1; i < workerCount; ++i )
+	{
+		workers.emplace_back( work, i );
+	}
+	work( 0 );
+
+	for( auto& worker : workers )
+	{
+		worker.join();
+	}
+
+	elapsedSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - clockStart ).count();
+	return SUCCESS;
+}
+
+// Champ CSV entre guillemets, guillemets internes doublés (RFC 4180): virgules et sauts de ligne restent dans le champ
+static std::string quoteCSV( const std::string& field )
+{
+	std::string quoted = "\"";
+	for( char c : field )
+	{
+		if( c == '"' )
+		{
+			quoted += '"';
+		}
+		quoted += c;
+	}
+	return quoted + "\"";
+}
+
+ResultCode BatchAnalyzer::exportCSV( const std::string& filename ) const
+{
+	std::ofstream file( filename );
+	if( !file.is_open() )
+	{
+		return ERROR_FILE_OPEN_FAILED;
+	}
+
+	size_t axisCount = 0;
+	for( const auto& summary : summaries )
+	{
+		axisCount = std::max( axisCount, summary.axes.size() );
+	}
+
+	// En-tête: résumé puis cinq colonnes par axe
+	file << "file,duration_s,snapshots,median_interval_ms,max_gap_ms,buttons,presses,buttons_used,anomalies";
+	for( size_t axis = 0; axis < axisCount; ++axis )
+	{
+		file << ",axis" << axis << "_min,axis" << axis << "_max,axis" << axis << "_mean,axis" << axis << "_stddev,axis" << axis << "_noise";
+	}
+	file << "\n";
+
+	file << std::fixed << std::setprecision( 4 );
+	for( const auto& summary : summaries )
+	{
+		file << quoteCSV( summary.filename ) << "," << summary.duration << "," << summary.snapshotCount << "," << summary.medianInterval * 1000.0 << ","
+			 << summary.maxGap * 1000.0 << "," << summary.buttonCount << "," << summary.pressCount << "," << summary.buttonsUsed << ","
+			 << describeAnomalies( summary.anomalies );
+
+		for( size_t axis = 0; axis < axisCount; ++axis )
+		{
+			if( axis < summary.axes.size() )
+			{
+				const AxisSummary& stats = summary.axes[axis];
+				file << "," << stats.minValue << "," << stats.maxValue << "," << stats.mean << "," << stats.stdDev << "," << stats.noise;
+			}
+			else
+			{
+				file << ",,,,,";
+			}
+		}
+		file << "\n";
+	}
+
+	return file.good() ? SUCCESS : ERROR_FILE_WRITE_FAILED;
+}
+
+size_t BatchAnalyzer::getFileCount() const
+{
+	return fileCount;
+}
+
+size_t BatchAnalyzer::getCompletedCount() const
+{
+	return completedCount;
+}
+
+size_t BatchAnalyzer::getStolenCount() const
+{
+	return stolenCount;
+}
+
+double BatchAnalyzer::getElapsedSeconds() const
+{
+	return elapsedSeconds;
+}
+
+double BatchAnalyzer::getThroughput() const
+{
+	return elapsedSeconds > 0.0 ? completedCount / elapsedSeconds : 0.0;
+}
+
+size_t BatchAnalyzer::getAnomalyCount() const
+{
+	return std::count_if( summaries.begin(), summaries.end(), []( const RecordingSummary& summary ) { return summary.anomalies != ANOMALY_NONE; } );
+}
+
+const std::vector<RecordingSummary>& BatchAnalyzer::getSummaries() const
+{
+	return summaries;
+}
+
+std::string BatchAnalyzer::describeAnomalies( Uint32 anomalies )
+{
+	static const char* names[] = { "illisible", "vide", "temps_inverse", "trou", "hors_plage", "bruit", "inactif" };
+
+	std::string result;
+	for( int i = 0; i < IM_ARRAYSIZE( names ); ++i )
+	{
+		if( anomalies & ( 1u << i ) )
+		{
+			result += result.empty() ? names[i] : std::string( "|" ) + names[i];
+		}
+	}
+	return result;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE RECORDINGREADER
+// =============================================================================
+
+RecordingReader::RecordingReader() : stream( nullptr ), remaining( 0 ), version( 1 ), snapshotCount( 0 ), axisCount( 0 ), buttonCount( 0 ),
+									 recordSize( 0 ), readCount( 0 ), failed( false )
+{
+}
+
+ResultCode RecordingReader::open( const std::string& filename )
+{
+	file.close();
+	file.clear();
+	file.open( filename, std::ios::binary );
+	if( !file.is_open() )
+	{
+		error = "impossible d'ouvrir " + filename;
+		return ERROR_FILE_OPEN_FAILED;
+	}
+	return open( file );
+}
+
+bool RecordingReader::readBytes( void* destination, size_t size )
+{
+	if( size > remaining )
+	{
+		remaining = 0;
+		return false;
+	}
+	stream->read( static_cast<char*>( destination ), size );
+	remaining -= size;
+	return !stream->fail();
+}
+
+ResultCode RecordingReader::open( std::istream& input )
+{
+	stream        = &input;
+	version       = 1;
+	snapshotCount = 0;
+	readCount     = 0;
+	failed        = false;
+	error.clear();
+
+	stream->seekg( 0, std::ios::end );
+	std::streamoff size = stream->tellg();
+	stream->seekg( 0 );
+	if( size < 0 || stream->fail() )
+	{
+		error = "taille du fichier inconnue";
+		return ERROR_FILE_READ_FAILED;
+	}
+	remaining = static_cast<Uint64>( size );
+
+	// Les fichiers sans en-tête (version 1) commencent directement par le nombre d'instantanés
+	Uint32 magic = 0;
+	if( remaining >= sizeof( magic ) + sizeof( version ) )
+	{
+		readBytes( &magic, sizeof( magic ) );
+		if( magic == RECORDING_MAGIC )
+		{
+			readBytes( &version, sizeof( version ) );
+		}
+		else
+		{
+			stream->seekg( 0 );
+			remaining = static_cast<Uint64>( size );
+		}
+	}
+
+	const size_t dimensionsSize = sizeof( snapshotCount ) + sizeof( axisCount ) + sizeof( buttonCount );
+	if( remaining < dimensionsSize )
+	{
+		error = "en-tête tronqué (" + std::to_string( size ) + " octets)";
+		return ERROR_FILE_TRUNCATED;
+	}
+
+	readBytes( &snapshotCount, sizeof( snapshotCount ) );
+	readBytes( &axisCount, sizeof( axisCount ) );
+	if( !readBytes( &buttonCount, sizeof( buttonCount ) ) )
+	{
+		error = "lecture de l'en-tête impossible";
+		return ERROR_FILE_READ_FAILED;
+	}
+
+	if( version == 0 || version > RECORDING_VERSION )
+	{
+		error = "version " + std::to_string( version ) + " non supportée (maximum " + std::to_string( RECORDING_VERSION ) + ")";
+		return ERROR_FILE_CORRUPTED;
+	}
+	if( axisCount > MAX_FILE_AXES || buttonCount > MAX_FILE_BUTTONS )
+	{
+		error = "dimensions invalides (" + std::to_string( axisCount ) + " axes, " + std::to_string( buttonCount ) + " boutons)";
+		return ERROR_FILE_CORRUPTED;
+	}
+
+	// Instantanés de taille fixe: le nombre annoncé doit tenir dans le reste du fichier
+	size_t buttonBytes = version >= 3 ? ( buttonCount + 63 ) / 64 * sizeof( Uint64 ) : buttonCount * sizeof( bool );
+	recordSize         = sizeof( double ) + axisCount * sizeof( float ) + buttonBytes;
+	if( snapshotCount > remaining / recordSize )
+	{
+		error = std::to_string( snapshotCount ) + " instantanés annoncés, le fichier n'en contient que " + std::to_string( remaining / recordSize );
+		return ERROR_FILE_TRUNCATED;
+	}
+
+	return SUCCESS;
+}
+
+size_t RecordingReader::readChunk( size_t maxCount, RecordingChunk& chunk )
+{
+	size_t count = failed ? 0 : std::min( maxCount, snapshotCount - readCount );
+	chunk.count  = 0;
+	if( count == 0 )
+	{
+		return 0;
+	}
+
+	// Une seule lecture pour tout le bloc, puis répartition en colonnes
+	buffer.resize( count * recordSize );
+	if( !readBytes( buffer.data(), buffer.size() ) )
+	{
+		error  = "lecture interrompue après " + std::to_string( readCount ) + " instantanés";
+		failed = true;
+		return 0;
+	}
+
+	size_t keptButtons = std::min( buttonCount, static_cast<size_t>( MAX_BUTTONS ) );
+	size_t keptWords   = ( keptButtons + 63 ) / 64;
+
+	chunk.times.resize( count );
+	chunk.values.resize( count * axisCount );
+	chunk.buttons.resize( count );
+
+	for( size_t i = 0; i < count; ++i )
+	{
+		const char* record = buffer.data() + i * recordSize;
+		memcpy( &chunk.times[i], record, sizeof( double ) );
+		record += sizeof( double );
+
+		for( size_t axis = 0; axis < axisCount; ++axis )
+		{
+			memcpy( &chunk.values[axis * count + i], record + axis * sizeof( float ), sizeof( float ) );
+		}
+		record += axisCount * sizeof( float );
+
+		ButtonBits& buttons = chunk.buttons[i];
+		buttons.clear();
+		if( version >= 3 )
+		{
+			memcpy( buttons.words, record, keptWords * sizeof( Uint64 ) );
+		}
+		else
+		{
+			for( size_t j = 0; j < keptButtons; ++j )
+			{
+				buttons.set( static_cast<int>( j ), record[j] != 0 );
+			}
+		}
+	}
+
+	readCount += count;
+	chunk.count = count;
+	return count;
+}
+
+bool RecordingReader::hasFailed() const
+{
+	return failed;
+}
+
+ResultCode RecordingReader::readEvents( std::vector<InputEvent>& events )
+{
+	events.clear();
+	if( version < 2 )
+	{
+		return SUCCESS;
+	}
+	if( failed || readCount < snapshotCount )
+	{
+		error = "instantanés non lus avant les événements";
+		return ERROR_INVALID_PARAMETER;
+	}
+
+	// Transition: horodatage, type, indice, valeur (format de RecordingManager::saveRecording)
+	const size_t eventSize  = sizeof( double ) + sizeof( Uint8 ) + sizeof( Uint8 ) + sizeof( Sint16 );
+	size_t       eventCount = 0;
+	if( remaining < sizeof( eventCount ) )
+	{
+		error = "nombre d'événements manquant";
+		return ERROR_FILE_TRUNCATED;
+	}
+	readBytes( &eventCount, sizeof( eventCount ) );
+	if( eventCount > remaining / eventSize )
+	{
+		error = std::to_string( eventCount ) + " événements annoncés, le fichier n'en contient que " + std::to_string( remaining / eventSize );
+		return ERROR_FILE_TRUNCATED;
+	}
+
+	buffer.resize( eventCount * eventSize );
+	if( !readBytes( buffer.data(), buffer.size() ) )
+	{
+		error = "lecture des événements interrompue";
+		return ERROR_FILE_READ_FAILED;
+	}
+
+	events.resize( eventCount );
+	for( size_t i = 0; i < eventCount; ++i )
+	{
+		const char* record = buffer.data() + i * eventSize;
+		InputEvent& event  = events[i];
+		memcpy( &event.timestamp, record, sizeof( double ) );
+		memcpy( &event.type, record + 8, sizeof( Uint8 ) );
+		memcpy( &event.index, record + 9, sizeof( Uint8 ) );
+		memcpy( &event.value, record + 10, sizeof( Sint16 ) );
+	}
+	return SUCCESS;
+}
+
+const std::string& RecordingReader::getError() const
+{
+	return error;
+}
+
+Uint32 RecordingReader::getVersion() const
+{
+	return version;
+}
+
+size_t RecordingReader::getSnapshotCount() const
+{
+	return snapshotCount;
+}
+
+size_t RecordingReader::getAxisCount() const
+{
+	return axisCount;
+}
+
+int RecordingReader::getButtonCount() const
+{
+	return static_cast<int>( std::min( buttonCount, static_cast<size_t>( MAX_BUTTONS ) ) );
+}
+
+// =============================================================================
+// EXPORT DES ENREGISTREMENTS
+// =============================================================================
+
+ResultCode exportRecordingCSV( const std::string& input, const std::string& output )
+{
+	RecordingReader reader;
+	ResultCode      result = reader.open( input );
+	if( result != SUCCESS )
+	{
+		return result;
+	}
+
+	std::ofstream file( output, std::ios::binary );
+	if( !file.is_open() )
+	{
+		return ERROR_FILE_OPEN_FAILED;
+	}
+
+	size_t axisCount   = reader.getAxisCount();
+	int    buttonCount = reader.getButtonCount();
+
+	std::string header = "time";
+	for( size_t axis = 0; axis < axisCount; ++axis )
+	{
+		header += ",axis" + std::to_string( axis );
+	}
+	for( int b = 0; b < buttonCount; ++b )
+	{
+		header += ",button" + std::to_string( b + 1 );
+	}
+	header += "\n";
+	file.write( header.data(), header.size() );
+
+	// Chaque bloc est découpé en tranches formatées en parallèle, chacune dans son propre tampon, puis
+	// écrites dans l'ordre: sur plusieurs cœurs, le formatage suit le débit du disque
+	size_t                         rowMax     = 32 + axisCount * 17 + buttonCount * 2 + 1;
+	size_t                         sliceCount = std::max( 1u, std::thread::hardware_concurrency() );
+	std::vector<std::vector<char>> slices( sliceCount );
+	std::vector<size_t>            sliceSizes( sliceCount );
+	RecordingChunk                 chunk;
+
+	while( reader.readChunk( RecordingReader::CHUNK_SIZE, chunk ) > 0 )
+	{
+		size_t rowsPerSlice = ( chunk.count + sliceCount - 1 ) / sliceCount;
+
+		parallelFor( sliceCount, [&]( size_t slice ) {
+			size_t first = std::min( chunk.count, slice * rowsPerSlice );
+			size_t last  = std::min( chunk.count, first + rowsPerSlice );
+			auto&  text  = slices[slice];
+			text.resize( ( last - first ) * rowMax + 1 );
+
+			char* out = text.data();
+			char* end = text.data() + text.size();
+			for( size_t i = first; i < last; ++i )
+			{
+				out = std::to_chars( out, end, chunk.times[i] ).ptr;
+				for( size_t axis = 0; axis < axisCount; ++axis )
+				{
+					*out++ = ',';
+					out    = std::to_chars( out, end, chunk.values[axis * chunk.count + i] ).ptr;
+				}
+				for( int b = 0; b < buttonCount; ++b )
+				{
+					*out++ = ',';
+					*out++ = chunk.buttons[i].test( b ) ? '1' : '0';
+				}
+				*out++ = '\n';
+			}
+			sliceSizes[slice] = out - text.data();
+		} );
+
+		for( size_t slice = 0; slice < sliceCount; ++slice )
+		{
+			file.write( slices[slice].data(), sliceSizes[slice] );
+		}
+	}
+
+	if( reader.hasFailed() )
+	{
+		return ERROR_FILE_READ_FAILED;
+	}
+	return file.good() ? SUCCESS : ERROR_FILE_WRITE_FAILED;
+}
+
+// Construction de métadonnées FlatBuffers d'avant en arrière: chaque vtable précède sa table, les
+// objets référencés (chaînes, vecteurs, sous-tables) sont écrits ensuite et leurs décalages corrigés
+struct FlatBuilder
+{
+	struct Table
+	{
+		size_t vtable;
+		size_t start;
+	};
+
+	std::vector<Uint8> data;
+
+	void align( size_t alignment )
+	{
+		data.resize( ( data.size() + alignment - 1 ) / alignment * alignment, 0 );
+	}
+
+	template<typename T> size_t put( T value )
+	{
+		align( sizeof( T ) );
+		size_t position = data.size();
+		data.resize( position + sizeof( T ) );
+		memcpy( &data[position], &value, sizeof( T ) );
+		return position;
+	}
+
+	template<typename T> void patch( size_t position, T value )
+	{
+		memcpy( &data[position], &value, sizeof( T ) );
+	}
+
+	// Faire pointer le décalage écrit en field vers target (toujours plus loin dans le tampon)
+	void link( size_t field, size_t target )
+	{
+		patch<Uint32>( field, static_cast<Uint32>( target - field ) );
+	}
+
+	// Table alignée sur 8 octets, ses champs doivent être ajoutés avant tout autre objet
+	Table beginTable( int fieldCount )
+	{
+		size_t vtableSize = 4 + 2 * fieldCount;
+		align( 2 );
+		while( ( data.size() + vtableSize ) % 8 != 0 )
+		{
+			put<Uint16>( 0 );
+		}
+
+		Table table;
+		table.vtable = put<Uint16>( static_cast<Uint16>( vtableSize ) );
+		put<Uint16>( 0 );
+		for( int i = 0; i < fieldCount; ++i )
+		{
+			put<Uint16>( 0 );
+		}
+		table.start = put<Sint32>( static_cast<Sint32>( data.size() - table.vtable ) );
+		return table;
+	}
+
+	template<typename T> size_t field( const Table& table, int index, T value )
+	{
+		size_t position = put( value );
+		patch<Uint16>( table.vtable + 4 + 2 * index, static_cast<Uint16>( position - table.start ) );
+		return position;
+	}
+
+	// Champ décalage, à relier à l'objet référencé une fois écrit
+	size_t offsetField( const Table& table, int index )
+	{
+		return field<Uint32>( table, index, 0 );
+	}
+
+	void endTable( const Table& table )
+	{
+		patch<Uint16>( table.vtable + 2, static_cast<Uint16>( data.size() - table.start ) );
+	}
+
+	size_t string( const std::string& text )
+	{
+		size_t position = put<Uint32>( static_cast<Uint32>( text.size() ) );
+		data.insert( data.end(), text.begin(), text.end() );
+		data.push_back( 0 );
+		return position;
+	}
+
+	// Vecteur de décalages: retourne la position du premier élément (élément i à + 4 * i)
+	size_t offsetVector( size_t count )
+	{
+		put<Uint32>( static_cast<Uint32>( count ) );
+		size_t first = data.size();
+		data.resize( first + 4 * count, 0 );
+		return first;
+	}
+
+	// Vecteur de structures 64 bits (Int64 successifs), éléments alignés sur 8 octets
+	size_t structVector( size_t count, const std::vector<Sint64>& values )
+	{
+		align( 4 );
+		if( data.size() % 8 == 0 )
+		{
+			put<Uint32>( 0 );
+		}
+		size_t position = put<Uint32>( static_cast<Uint32>( count ) );
+		for( Sint64 value : values )
+		{
+			put<Sint64>( value );
+		}
+		return position;
+	}
+};
+
+// Colonne Arrow: type Arrow (3: FloatingPoint, 6: Bool) et précision des flottants (1: simple, 2: double)
+struct ArrowColumn
+{
+	std::string name;
+	Uint8       type;
+	Sint16      precision;
+};
+
+// Constantes du format Arrow IPC (Schema.fbs, Message.fbs, File.fbs)
+static const Sint16 ARROW_METADATA_V5    = 4;
+static const Uint8  ARROW_HEADER_SCHEMA  = 1;
+static const Uint8  ARROW_HEADER_BATCH   = 3;
+static const Uint8  ARROW_TYPE_FLOAT     = 3;
+static const Uint8  ARROW_TYPE_BOOL      = 6;
+static const Uint32 ARROW_CONTINUATION   = 0xFFFFFFFF;
+static const char   ARROW_MAGIC[8]       = { 'A', 'R', 'R', 'O', 'W', '1', 0, 0 };
+
+// Table Schema { fields: [Field] }, partagée par le message de schéma et le pied de fichier
+static size_t writeArrowSchema( FlatBuilder& builder, const std::vector<ArrowColumn>& columns )
+{
+	FlatBuilder::Table schema = builder.beginTable( 2 );
+	size_t             fields = builder.offsetField( schema, 1 );
+	builder.endTable( schema );
+
+	size_t slots = builder.offsetVector( columns.size() );
+	builder.link( fields, slots - 4 );
+
+	for( size_t i = 0; i < columns.size(); ++i )
+	{
+		// Field { name, nullable, type_type, type, dictionary, children }
+		FlatBuilder::Table field = builder.beginTable( 6 );
+		builder.link( slots + 4 * i, field.start );
+		size_t name = builder.offsetField( field, 0 );
+		builder.field<Uint8>( field, 2, columns[i].type );
+		size_t type     = builder.offsetField( field, 3 );
+		size_t children = builder.offsetField( field, 5 );
+		builder.endTable( field );
+
+		builder.link( name, builder.string( columns[i].name ) );
+
+		FlatBuilder::Table typeTable = builder.beginTable( 1 );
+		if( columns[i].type == ARROW_TYPE_FLOAT )
+		{
+			builder.field<Sint16>( typeTable, 0, columns[i].precision );
+		}
+		builder.endTable( typeTable );
+		builder.link( type, typeTable.start );
+
+		builder.link( children, builder.offsetVector( 0 ) - 4 );
+	}
+
+	return schema.start;
+}
+
+// Message { version, header_type, header, bodyLength }: retourne la position de l'en-tête à relier
+static size_t beginArrowMessage( FlatBuilder& builder, Uint8 headerType, Sint64 bodyLength )
+{
+	size_t root = builder.put<Uint32>( 0 );
+
+	FlatBuilder::Table message = builder.beginTable( 4 );
+	builder.link( root, message.start );
+	builder.field<Sint16>( message, 0, ARROW_METADATA_V5 );
+	builder.field<Uint8>( message, 1, headerType );
+	size_t header = builder.offsetField( message, 2 );
+	builder.field<Sint64>( message, 3, bodyLength );
+	builder.endTable( message );
+	return header;
+}
+
+// Écrire un message encapsulé (marqueur, taille, métadonnées alignées sur 8, corps);
+// retourne la taille des métadonnées préfixe compris, telle que référencée par le pied de fichier
+static Sint32 writeArrowMessage( std::ofstream& file, FlatBuilder& builder, const std::vector<char>& body )
+{
+	builder.align( 8 );
+	Sint32 metadataSize = static_cast<Sint32>( builder.data.size() );
+	file.write( reinterpret_cast<const char*>( &ARROW_CONTINUATION ), sizeof( ARROW_CONTINUATION ) );
+	file.write( reinterpret_cast<const char*>( &metadataSize ), sizeof( metadataSize ) );
+	file.write( reinterpret_cast<const char*>( builder.data.data() ), builder.data.size() );
+	file.write( body.data(), body.size() );
+	return metadataSize + 8;
+}
+
+ResultCode exportRecordingArrow( const std::string& input, const std::string& output )
+{
+	RecordingReader reader;
+	ResultCode      result = reader.open( input );
+	if( result != SUCCESS )
+	{
+		return result;
+	}
+
+	std::ofstream file( output, std::ios::binary );
+	if( !file.is_open() )
+	{
+		return ERROR_FILE_OPEN_FAILED;
+	}
+
+	size_t axisCount   = reader.getAxisCount();
+	int    buttonCount = reader.getButtonCount();
+
+	std::vector<ArrowColumn> columns;
+	columns.push_back( { "time", ARROW_TYPE_FLOAT, 2 } );
+	for( size_t axis = 0; axis < axisCount; ++axis )
+	{
+		columns.push_back( { "axis" + std::to_string( axis ), ARROW_TYPE_FLOAT, 1 } );
+	}
+	for( int b = 0; b < buttonCount; ++b )
+	{
+		columns.push_back( { "button" + std::to_string( b + 1 ), ARROW_TYPE_BOOL, 0 } );
+	}
+
+	// Fichier: magique, schéma, un lot par bloc lu, fin de flux, pied (schéma + position des lots), magique
+	file.write( ARROW_MAGIC, sizeof( ARROW_MAGIC ) );
+	Sint64 position = sizeof( ARROW_MAGIC );
+
+	FlatBuilder schemaMessage;
+	schemaMessage.link( beginArrowMessage( schemaMessage, ARROW_HEADER_SCHEMA, 0 ), writeArrowSchema( schemaMessage, columns ) );
+	position += writeArrowMessage( file, schemaMessage, std::vector<char>() );
+
+	std::vector<Sint64> blocks; // Block { offset, metaDataLength (+ bourrage), bodyLength } par lot
+	std::vector<char>   body;
+	std::vector<Sint64> nodes;
+	std::vector<Sint64> buffers;
+	RecordingChunk      chunk;
+
+	while( reader.readChunk( RecordingReader::CHUNK_SIZE, chunk ) > 0 )
+	{
+		size_t count = chunk.count;
+
+		// Corps: pour chaque colonne, validité vide (aucune valeur nulle) puis données alignées sur 8
+		body.clear();
+		nodes.clear();
+		buffers.clear();
+		auto addBuffer = [&]( const void* bytes, size_t size ) {
+			buffers.push_back( static_cast<Sint64>( body.size() ) );
+			buffers.push_back( 0 );
+			buffers.push_back( static_cast<Sint64>( body.size() ) );
+			buffers.push_back( static_cast<Sint64>( size ) );
+			body.insert( body.end(), static_cast<const char*>( bytes ), static_cast<const char*>( bytes ) + size );
+			body.resize( ( body.size() + 7 ) / 8 * 8, 0 );
+			nodes.push_back( static_cast<Sint64>( count ) );
+			nodes.push_back( 0 );
+		};
+
+		addBuffer( chunk.times.data(), count * sizeof( double ) );
+		for( size_t axis = 0; axis < axisCount; ++axis )
+		{
+			addBuffer( &chunk.values[axis * count], count * sizeof( float ) );
+		}
+
+		std::vector<Uint8> bits( ( count + 7 ) / 8 );
+		for( int b = 0; b < buttonCount; ++b )
+		{
+			std::fill( bits.begin(), bits.end(), 0 );
+			for( size_t i = 0; i < count; ++i )
+			{
+				bits[i >> 3] |= static_cast<Uint8>( chunk.buttons[i].test( b ) ) << ( i & 7 );
+			}
+			addBuffer( bits.data(), bits.size() );
+		}
+
+		// RecordBatch { length, nodes: [FieldNode], buffers: [Buffer] }
+		FlatBuilder        batchMessage;
+		size_t             header = beginArrowMessage( batchMessage, ARROW_HEADER_BATCH, static_cast<Sint64>( body.size() ) );
+		FlatBuilder::Table batch  = batchMessage.beginTable( 3 );
+		batchMessage.link( header, batch.start );
+		batchMessage.field<Sint64>( batch, 0, static_cast<Sint64>( count ) );
+		size_t nodesField   = batchMessage.offsetField( batch, 1 );
+		size_t buffersField = batchMessage.offsetField( batch, 2 );
+		batchMessage.endTable( batch );
+		batchMessage.link( nodesField, batchMessage.structVector( nodes.size() / 2, nodes ) );
+		batchMessage.link( buffersField, batchMessage.structVector( buffers.size() / 2, buffers ) );
+
+		blocks.push_back( position );
+		Sint32 metadataSize = writeArrowMessage( file, batchMessage, body );
+		blocks.push_back( metadataSize );
+		blocks.push_back( static_cast<Sint64>( body.size() ) );
+		position += metadataSize + body.size();
+	}
+
+	if( reader.hasFailed() )
+	{
+		return ERROR_FILE_READ_FAILED;
+	}
+
+	Uint32 endOfStream[2] = { ARROW_CONTINUATION, 0 };
+	file.write( reinterpret_cast<const char*>( endOfStream ), sizeof( endOfStream ) );
+
+	// Footer { version, schema, dictionaries, recordBatches: [Block] }
+	FlatBuilder        footer;
+	size_t             root  = footer.put<Uint32>( 0 );
+	FlatBuilder::Table table = footer.beginTable( 4 );
+	footer.link( root, table.start );
+	footer.field<Sint16>( table, 0, ARROW_METADATA_V5 );
+	size_t schemaField  = footer.offsetField( table, 1 );
+	size_t batchesField = footer.offsetField( table, 3 );
+	footer.endTable( table );
+	footer.link( schemaField, writeArrowSchema( footer, columns ) );
+	footer.link( batchesField, footer.structVector( blocks.size() / 3, blocks ) );
+
+	Sint32 footerSize = static_cast<Sint32>( footer.data.size() );
+	file.write( reinterpret_cast<const char*>( footer.data.data() ), footer.data.size() );
+	file.write( reinterpret_cast<const char*>( &footerSize ), sizeof( footerSize ) );
+	file.write( ARROW_MAGIC, 6 );
+
+	return file.good() ? SUCCESS : ERROR_FILE_WRITE_FAILED;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE AUTOTESTMANAGER
+// =============================================================================
+
+AutoTestManager::AutoTestManager() : isRunning( false ), startTime( 0.0f ), currentTime( 0.0f ),
+									 duration( 30.0f ), testButtons( true ), testAxes( true ), testFFB( false )
+{
+}
+
+ResultCode AutoTestManager::startTest( float testDuration, bool buttons, bool axes, bool ffb )
+{
+	duration    = testDuration;
+	testButtons = buttons;
+	testAxes    = axes;
+	testFFB     = ffb;
+
+	// Horloge SDL: le test avance même quand l'interface n'est pas redessinée
+	isRunning   = true;
+	startTime   = SDL_GetTicks() / 1000.0f;
+	currentTime = 0.0f;
+
+	return SUCCESS;
+}
+
+ResultCode AutoTestManager::stopTest()
+{
+	isRunning = false;
+	return SUCCESS;
+}
+
+bool AutoTestManager::isTestRunning() const
+{
+	return isRunning;
+}
+
+float AutoTestManager::getTestDuration() const
+{
+	return duration;
+}
+
+float AutoTestManager::getCurrentTime() const
+{
+	return currentTime;
+}
+
+float AutoTestManager::getAxisValue( int axisIndex, float time )
+{
+	switch( axisIndex )
+	{
+		case 0: // Volant - mouvement sinusoïdal
+			return sinf( time * 2.0f ) * 0.8f;
+
+		case 1: // Accélérateur - accélération progressive
+			return std::min( 1.0f, time / ( duration * 0.2f ) );
+
+		case 2: // Frein - pression périodique
+			return ( sinf( time * 1.5f ) + 1.0f ) * 0.5f;
+
+		case 3: // Embrayage - plusieurs embrayages rapides
+			return ( time - floorf( time * 0.5f ) * 2.0f ) < 1.0f ? 0.0f : 1.0f;
+
+		default: // Autres axes - mouvement aléatoire
+			return sinf( time * 0.5f + axisIndex * 1.3f ) * 0.8f;
+	}
+}
+
+bool AutoTestManager::getButtonState( int buttonIndex, float time )
+{
+	// Différents patterns selon le groupe de boutons
+	if( buttonIndex < 6 )
+	{
+		// Groupe 1: séquence
+		int cycle = static_cast<int>( time * 2.0f ) % 6;
+		return buttonIndex == cycle;
+	}
+	else if( buttonIndex < 12 )
+	{
+		// Groupe 2: alternance
+		return fmodf( time + buttonIndex * 0.7f, 2.0f ) < 1.0f;
+	}
+	else if( buttonIndex < 18 )
+	{
+		// Groupe 3: courts appuis périodiques
+		return fmodf( time * 3.0f + buttonIndex, 10.0f ) < 0.3f;
+	}
+	else
+	{
+		// Groupe 4: longs appuis périodiques
+		return fmodf( time + buttonIndex * 0.5f, 5.0f ) < 2.5f;
+	}
+}
+
+void AutoTestManager::update( std::vector<AxisInfo>& axes, ButtonBits& buttons, int buttonCount, std::vector<ForceEffect>& effects )
+{
+	if( !isRunning )
+	{
+		return;
+	}
+
+	float now   = SDL_GetTicks() / 1000.0f;
+	currentTime = now - startTime;
+
+	// Vérifier si le test est terminé
+	if( currentTime >= duration )
+	{
+		isRunning = false;
+		return;
+	}
+
+	// Mettre à jour les axes
+	if( testAxes )
+	{
+		for( size_t i = 0; i < axes.size(); ++i )
+		{
+			if( i < axes.size() )
+			{
+				axes[i].value = getAxisValue( i, currentTime );
+			}
+		}
+	}
+
+	// Mettre à jour les boutons
+	if( testButtons )
+	{
+		for( int i = 0; i < buttonCount; ++i )
+		{
+			buttons.set( i, getButtonState( i, currentTime ) );
+		}
+	}
+
+	// Mettre à jour les effets de force
+	if( testFFB )
+	{
+		// Cycle à travers les différents effets
+		size_t effectIndex = static_cast<size_t>( floorf( currentTime / 2.0f ) ) % effects.size();
+
+		// Désactiver tous les effets
+		for( auto& effect : effects )
+		{
+			effect.enabled = false;
+		}
+
+		// Activer l'effet courant
+		if( effectIndex < effects.size() )
+		{
+			effects[effectIndex].enabled = true;
+			// Moduler la force (0-100%)
+			effects[effectIndex].strength = fabs( sinf( currentTime * 2.0f ) ) * 100.0f;
+		}
+	}
+}
+
+void AutoTestManager::setTestOptions( bool buttons, bool axes, bool ffb, float testDuration )
+{
+	testButtons = buttons;
+	testAxes    = axes;
+	testFFB     = ffb;
+	duration    = testDuration;
+}
+
+bool AutoTestManager::getTestButtons() const
+{
+	return testButtons;
+}
+
+bool AutoTestManager::getTestAxes() const
+{
+	return testAxes;
+}
+
+bool AutoTestManager::getTestFFB() const
+{
+	return testFFB;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE SIMULATEDWHEEL
+// =============================================================================
+
+double performanceCounterToMs( Uint64 ticks )
+{
+	static const double frequency = static_cast<double>( SDL_GetPerformanceFrequency() );
+	return static_cast<double>( ticks ) * 1000.0 / frequency;
+}
+
+SimulatedWheel::SimulatedWheel() : latencyMs( 12.0f ), noise( 0.002f ), position( 0.0f ), velocity( 0.0f ),
+								   force( 0.0f ), lastTime( 0 ), noiseSeed( 12345 )
+{
+}
+
+void SimulatedWheel::reset()
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	pending.clear();
+	position = 0.0f;
+	velocity = 0.0f;
+	force    = 0.0f;
+	lastTime = 0;
+}
+
+void SimulatedWheel::applyForce( float level, Uint64 timestamp )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	// La force ne sera vue par le "moteur" qu'après la latence simulée
+	Uint64 delay = static_cast<Uint64>( latencyMs * SDL_GetPerformanceFrequency() / 1000.0 );
+	pending.push_back( { timestamp + delay, std::max( -1.0f, std::min( 1.0f, level ) ) } );
+}
+
+Sint16 SimulatedWheel::sampleSteering( Uint64 now )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	if( lastTime == 0 || now < lastTime )
+	{
+		lastTime = now;
+	}
+
+	// Intégrer la dynamique masse-ressort-amortisseur par pas de 1 ms au maximum
+	const double frequency = static_cast<double>( SDL_GetPerformanceFrequency() );
+	const Uint64 maxStep   = static_cast<Uint64>( frequency / 1000.0 );
+
+	while( lastTime < now )
+	{
+		Uint64 step = std::min( maxStep, now - lastTime );
+		lastTime += step;
+
+		while( !pending.empty() && pending.front().applyAt <= lastTime )
+		{
+			force = pending.front().level;
+			pending.pop_front();
+		}
+
+		float dt    = static_cast<float>( step / frequency );
+		float accel = 1000.0f * force - 50.0f * position - 20.0f * velocity;
+		velocity += accel * dt;
+		position += velocity * dt;
+
+		// Butées mécaniques du volant
+		if( position > 1.0f || position < -1.0f )
+		{
+			position = std::max( -1.0f, std::min( 1.0f, position ) );
+			velocity = 0.0f;
+		}
+	}
+
+	// Bruit de mesure du capteur (générateur congruentiel, sans état partagé)
+	noiseSeed   = noiseSeed * 1664525u + 1013904223u;
+	float jitter = ( ( noiseSeed >> 8 ) / 16777216.0f - 0.5f ) * 2.0f * noise;
+
+	float value = std::max( -1.0f, std::min( 1.0f, position + jitter ) );
+	return static_cast<Sint16>( value * 32767.0f );
+}
+
+void SimulatedWheel::setLatency( float ms )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	latencyMs = std::max( 0.0f, ms );
+}
+
+float SimulatedWheel::getLatency() const
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	return latencyMs;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE INPUTSAMPLER
+// =============================================================================
+
+InputSampler::InputSampler() : joystick( nullptr ), simulatedWheel( nullptr ), axisCount( 0 ), steeringLane( 0 ), running( false ),
+							   periodUs( 1000 ), writeIndex( 0 )
+{
+	ring.resize( RING_CAPACITY );
+}
+
+InputSampler::~InputSampler()
+{
+	stop();
+}
+
+ResultCode InputSampler::start( SDL_Joystick* device, int numAxes, SimulatedWheel* simulation, int steering )
+{
+	stop();
+
+	if( !device && !simulation )
+	{
+		return ERROR_INVALID_PARAMETER;
+	}
+
+	joystick       = device;
+	simulatedWheel = simulation;
+	axisCount      = std::max( 0, std::min( numAxes, MAX_SAMPLED_AXES ) );
+	steeringLane   = steering >= 0 && steering < axisCount ? steering : 0;
+
+	running = true;
+	worker  = std::thread( &InputSampler::run, this );
+
+	return SUCCESS;
+}
+
+void InputSampler::stop()
+{
+	running = false;
+
+	if( worker.joinable() )
+	{
+		worker.join();
+	}
+
+	joystick       = nullptr;
+	simulatedWheel = nullptr;
+}
+
+bool InputSampler::isRunning() const
+{
+	return running;
+}
+
+int InputSampler::getSteeringLane() const
+{
+	return steeringLane;
+}
+
+void InputSampler::run()
+{
+	auto next = std::chrono::steady_clock::now();
+
+	while( running )
+	{
+		RawInputSample sample;
+		memset( &sample, 0, sizeof( RawInputSample ) );
+
+		if( joystick )
+		{
+			// État publié par le thread principal: pendant l'attente des événements, SDL y relit les
+			// joysticks environ chaque milliseconde. Aucun appel de mise à jour SDL hors du thread principal.
+			SDL_LockJoysticks();
+			sample.timestamp = SDL_GetPerformanceCounter();
+			for( int i = 0; i < axisCount; ++i )
+			{
+				sample.axes[i] = SDL_JoystickGetAxis( joystick, i );
+			}
+			SDL_UnlockJoysticks();
+		}
+		else
+		{
+			sample.timestamp = SDL_GetPerformanceCounter();
+			sample.axes[0]   = simulatedWheel->sampleSteering( sample.timestamp );
+		}
+
+		{
+			std::lock_guard<std::mutex> lock( ringMutex );
+			ring[writeIndex % RING_CAPACITY] = sample;
+			++writeIndex;
+		}
+
+		// Cadence fixe; en cas de retard on repart de l'instant courant
+		next += std::chrono::microseconds( periodUs.load() );
+		auto now = std::chrono::steady_clock::now();
+		if( next < now )
+		{
+			next = now;
+		}
+		std::this_thread::sleep_until( next );
+	}
+}
+
+size_t InputSampler::readSince( Uint64& readIndex, std::vector<RawInputSample>& out ) const
+{
+	std::lock_guard<std::mutex> lock( ringMutex );
+
+	out.clear();
+
+	// Les échantillons écrasés par le tampon circulaire sont perdus
+	if( readIndex > writeIndex || writeIndex - readIndex > RING_CAPACITY )
+	{
+		readIndex = writeIndex > RING_CAPACITY ? writeIndex - RING_CAPACITY : 0;
+	}
+
+	for( ; readIndex < writeIndex; ++readIndex )
+	{
+		out.push_back( ring[readIndex % RING_CAPACITY] );
+	}
+
+	return out.size();
+}
+
+bool InputSampler::getLatest( RawInputSample& outSample ) const
+{
+	std::lock_guard<std::mutex> lock( ringMutex );
+
+	if( writeIndex == 0 )
+	{
+		return false;
+	}
+
+	outSample = ring[( writeIndex - 1 ) % RING_CAPACITY];
+	return true;
+}
+
+Uint64 InputSampler::getWriteIndex() const
+{
+	std::lock_guard<std::mutex> lock( ringMutex );
+	return writeIndex;
+}
+
+void InputSampler::setSamplingPeriod( Uint32 microseconds )
+{
+	periodUs = std::max<Uint32>( 100, microseconds );
+}
+
+Uint32 InputSampler::getSamplingPeriod() const
+{
+	return periodUs;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE FORCEMANAGER
+// =============================================================================
+
+// Table des effets: l'ordre définit l'index de chaque effet dans ForceManager
+static const EffectDescriptor EFFECT_DESCRIPTORS[] = {
+	{ "Constant", 50.0f, 1.0f, SDL_HAPTIC_CONSTANT, SDL_HAPTIC_CONSTANT, EFFECT_KIND_CONSTANT, 0, 0, 0 },
+	{ "Ressort", 70.0f, 0.0f, SDL_HAPTIC_SPRING, SDL_HAPTIC_SPRING, EFFECT_KIND_CONDITION, 0, 0, 0 },
+	{ "Amortissement", 60.0f, 0.0f, SDL_HAPTIC_DAMPER, SDL_HAPTIC_DAMPER, EFFECT_KIND_CONDITION, 0, 0, 0 },
+	{ "Friction", 40.0f, 0.0f, SDL_HAPTIC_FRICTION, SDL_HAPTIC_FRICTION, EFFECT_KIND_CONDITION, 0, 0, 0 },
+	{ "Sinusoïdal", 30.0f, 2.0f, SDL_HAPTIC_SINE, SDL_HAPTIC_SINE, EFFECT_KIND_PERIODIC, 100, 0, 0 },
+	{ "Dent de scie", 50.0f, 1.5f, SDL_HAPTIC_SAWTOOTHUP, SDL_HAPTIC_SAWTOOTHUP, EFFECT_KIND_PERIODIC, 250, 0, 0 },
+	{ "Rumbble", 80.0f, 0.5f, SDL_HAPTIC_LEFTRIGHT, SDL_HAPTIC_LEFTRIGHT, EFFECT_KIND_LEFTRIGHT, 0, 0, 0 },
+	{ "Choc", 100.0f, 0.2f, SDL_HAPTIC_CONSTANT, SDL_HAPTIC_CONSTANT, EFFECT_KIND_CONSTANT, 0, 0, 32768 } // Atténuation sur la moitié de la durée
+};
+
+ForceManager::ForceManager() : ffbEnabled( true ), masterStrength( 100.0f ), haptic( nullptr ), simulatedWheel( nullptr ),
+							   stepEffectId( -1 ), hapticAxes( 0 ), masterScale( 65536 ), softwareMixing( false ),
+							   mixerEffectId( -1 ), inputSource( nullptr ), mixerRunning( false ), mixerStep( 0 ), mixerOutput( 0 )
+{
+	// Initialiser les effets par défaut depuis la table des descripteurs
+	for( const auto& descriptor : EFFECT_DESCRIPTORS )
+	{
+		effects.push_back( { descriptor.name, false, descriptor.defaultStrength, descriptor.defaultDuration, -1 } );
+	}
+
+	// Taille fixe: aucune allocation sur le chemin critique
+	compiled.resize( effects.size() );
+	for( size_t i = 0; i < effects.size(); ++i )
+	{
+		compileEffect( i );
+	}
+
+	// Une entrée par effet plus une entrée réservée aux collisions
+	mixerEffects.resize( effects.size() + 1 );
+	mixerScratch.resize( mixerEffects.size() );
+	for( size_t i = 0; i < mixerEffects.size(); ++i )
+	{
+		memset( &mixerEffects[i], 0, sizeof( MixerEffect ) );
+		if( i < effects.size() )
+		{
+			mixerEffects[i].kind    = EFFECT_DESCRIPTORS[i].kind;
+			mixerEffects[i].sdlType = EFFECT_DESCRIPTORS[i].sdlType;
+			mixerEffects[i].period  = EFFECT_DESCRIPTORS[i].period;
+		}
+	}
+	mixerEffects.back().kind    = EFFECT_KIND_CONSTANT;
+	mixerEffects.back().sdlType = SDL_HAPTIC_CONSTANT;
+	mixerEffects.back().oneShot = true;
+}
+
+ForceManager::~ForceManager()
+{
+	cleanup();
+}
+
+void ForceManager::cleanup()
+{
+	// Le thread de mixage utilise le dispositif haptic: l'arrêter en premier
+	stopMixer();
+
+	if( haptic )
+	{
+		// Désactiver tous les effets
+		for( auto& effect : effects )
+		{
+			if( effect.effectId >= 0 )
+			{
+				SDL_HapticDestroyEffect( haptic, effect.effectId );
+				effect.effectId = -1;
+			}
+		}
+
+		if( stepEffectId >= 0 )
+		{
+			SDL_HapticDestroyEffect( haptic, stepEffectId );
+			stepEffectId = -1;
+		}
+
+		SDL_HapticClose( haptic );
+		haptic = nullptr;
+	}
+}
+
+ResultCode ForceManager::initialize( SDL_Joystick* joystick, unsigned effectMask, Logger& logger )
+{
+	cleanup();
+
+	if( !joystick )
+	{
+		logger.log( Logger::ERROR, "Impossible d'initialiser le retour de force: joystick invalide" );
+		return ERROR_JOYSTICK_NOT_FOUND;
+	}
+
+	// Vérifier si le joystick supporte le haptic
+	if( !SDL_JoystickIsHaptic( joystick ) )
+	{
+		logger.log( Logger::WARNING, "Le joystick ne supporte pas le retour de force" );
+		return ERROR_JOYSTICK_NOT_FOUND;
+	}
+
+	// Ouvrir le dispositif haptic
+	haptic = SDL_HapticOpenFromJoystick( joystick );
+	if( !haptic )
+	{
+		logger.log( Logger::ERROR, "Impossible d'ouvrir le dispositif haptic: " + std::string( SDL_GetError() ) );
+		return ERROR_JOYSTICK_NOT_FOUND;
+	}
+
+	// Vérifier les capacités (limitées aux effets que le profil du périphérique autorise)
+	unsigned int supportedEffects = SDL_HapticQuery( haptic ) & effectMask;
+
+	logger.log( Logger::INFO, "Initialisation du retour de force réussie" );
+	logger.log( Logger::DEBUG, "Effets supportés: " + std::to_string( supportedEffects ) );
+
+	// Nombre d'axes du dispositif (les effets conditionnels en utilisent au plus 3)
+	hapticAxes = std::max( 0, std::min( 3, SDL_HapticNumAxes( haptic ) ) );
+
+	// Initialiser les effets supportés
+	for( size_t i = 0; i < effects.size(); ++i )
+	{
+		if( supportedEffects & EFFECT_DESCRIPTORS[i].supportFlag )
+		{
+			initEffect( i );
+			logger.log( Logger::DEBUG, "Effet " + effects[i].name + " initialisé" );
+		}
+	}
+
+	if( softwareMixing )
+	{
+		if( supportedEffects & SDL_HAPTIC_CONSTANT )
+		{
+			startMixer();
+		}
+		else
+		{
+			logger.log( Logger::WARNING, "Mixage logiciel indisponible: effet constant non supporté" );
+		}
+	}
+
+	return SUCCESS;
+}
+
+// Pente d'une rampe linéaire de 0 à 32767 sur length ms, en Q16 (0 si pas de rampe)
+static Uint32 envelopeRate( Uint16 length )
+{
+	return length > 0 ? ( 32767u << 16 ) / length : 0;
+}
+
+void ForceManager::compileEffect( size_t index )
+{
+	const EffectDescriptor& descriptor = EFFECT_DESCRIPTORS[index];
+	const ForceEffect&      effect     = effects[index];
+	CompiledEffect&         out        = compiled[index];
+
+	// Seule conversion flottante: la force de l'effet (0-100) vers Q16, puis mise à l'échelle entière
+	Uint32 strength  = static_cast<Uint32>( std::max( 0.0f, std::min( 100.0f, effect.strength ) ) * 655.36f );
+	Uint32 scale     = static_cast<Uint32>( ( static_cast<Uint64>( strength ) * masterScale ) >> 16 );
+	Sint16 level     = static_cast<Sint16>( ( scale * 32767u ) >> 16 );
+	Uint16 magnitude = static_cast<Uint16>( ( scale * 65535u ) >> 16 );
+	Uint32 length    = static_cast<Uint32>( std::max( 0.0f, effect.duration ) * 1000.0f );
+	Uint16 attack    = static_cast<Uint16>( std::min<Uint32>( 65535u, ( static_cast<Uint64>( length ) * descriptor.attackFraction ) >> 16 ) );
+	Uint16 fade      = static_cast<Uint16>( std::min<Uint32>( 65535u, ( static_cast<Uint64>( length ) * descriptor.fadeFraction ) >> 16 ) );
+
+	SDL_HapticEffect& sdlEffect = out.sdlEffect;
+	memset( &sdlEffect, 0, sizeof( SDL_HapticEffect ) );
+	sdlEffect.type = descriptor.sdlType;
+
+	out.level  = descriptor.kind == EFFECT_KIND_LEFTRIGHT ? static_cast<Sint16>( magnitude >> 1 ) : level;
+	out.length = descriptor.kind == EFFECT_KIND_CONDITION ? SDL_HAPTIC_INFINITY : length;
+	out.attack     = attack;
+	out.fade       = fade;
+	out.attackRate = envelopeRate( attack );
+	out.fadeRate   = envelopeRate( fade );
+
+	switch( descriptor.kind )
+	{
+		case EFFECT_KIND_CONSTANT:
+			sdlEffect.constant.direction.type = SDL_HAPTIC_POLAR;
+			sdlEffect.constant.length         = length;
+			sdlEffect.constant.level          = level;
+			sdlEffect.constant.attack_length  = attack;
+			sdlEffect.constant.fade_length    = fade;
+			break;
+
+		case EFFECT_KIND_CONDITION:
+			sdlEffect.condition.direction.type = SDL_HAPTIC_POLAR;
+			sdlEffect.condition.length         = SDL_HAPTIC_INFINITY;
+			for( int i = 0; i < hapticAxes; ++i )
+			{
+				sdlEffect.condition.right_sat[i]   = static_cast<Uint16>( level );
+				sdlEffect.condition.left_sat[i]    = static_cast<Uint16>( level );
+				sdlEffect.condition.right_coeff[i] = level;
+				sdlEffect.condition.left_coeff[i]  = level;
+			}
+			break;
+
+		case EFFECT_KIND_PERIODIC:
+			sdlEffect.periodic.direction.type = SDL_HAPTIC_POLAR;
+			sdlEffect.periodic.length         = length;
+			sdlEffect.periodic.period         = descriptor.period;
+			sdlEffect.periodic.magnitude      = level;
+			sdlEffect.periodic.attack_length  = attack;
+			sdlEffect.periodic.fade_length    = fade;
+			break;
+
+		case EFFECT_KIND_LEFTRIGHT:
+			sdlEffect.leftright.length          = length;
+			sdlEffect.leftright.large_magnitude = magnitude;
+			sdlEffect.leftright.small_magnitude = magnitude;
+			break;
+	}
+
+	out.strength    = effect.strength;
+	out.duration    = effect.duration;
+	out.masterScale = masterScale;
+}
+
+bool ForceManager::isCompiledCurrent( size_t index ) const
+{
+	const auto& effect = effects[index];
+	const auto& cached = compiled[index];
+	return cached.strength == effect.strength && cached.duration == effect.duration && cached.masterScale == masterScale;
+}
+
+void ForceManager::initEffect( size_t index )
+{
+	if( !haptic || index >= effects.size() )
+		return;
+
+	compileEffect( index );
+
+	// Créer l'effet
+	if( effects[index].effectId >= 0 )
+	{
+		SDL_HapticDestroyEffect( haptic, effects[index].effectId );
+	}
+
+	effects[index].effectId = SDL_HapticNewEffect( haptic, &compiled[index].sdlEffect );
+}
+
+void ForceManager::simulateCollision( float strength, Logger& logger )
+{
+	if( softwareMixing && mixerRunning && ffbEnabled )
+	{
+		// Impulsion de 200 ms avec atténuation sur 100 ms, jouée une fois par le mixeur
+		Uint32 scale = static_cast<Uint32>( ( static_cast<Uint64>( std::max( 0.0f, std::min( 100.0f, strength ) ) * 655.36f ) * masterScale ) >> 16 );
+
+		std::lock_guard<std::mutex> lock( mixerMutex );
+		MixerEffect& collision = mixerEffects.back();
+		collision.enabled      = true;
+		collision.level        = static_cast<Sint16>( ( scale * 32767u ) >> 16 );
+		collision.length       = 200;
+		collision.attack       = 0;
+		collision.fade         = 100;
+		collision.attackRate   = 0;
+		collision.fadeRate     = envelopeRate( 100 );
+		collision.startTime    = SDL_GetPerformanceCounter();
+
+		logger.log( Logger::DEBUG, "Collision mixée avec force: " + std::to_string( scale * 100.0f / 65536.0f ) );
+		return;
+	}
+
+	if( !haptic || !ffbEnabled )
+	{
+		logger.log( Logger::DEBUG, "Simulation de collision ignorée: haptic non disponible ou désactivé" );
+		return;
+	}
+
+	// Multiplier par la force globale (virgule fixe Q16)
+	Uint32 scale = static_cast<Uint32>( ( static_cast<Uint64>( std::max( 0.0f, std::min( 100.0f, strength ) ) * 655.36f ) * masterScale ) >> 16 );
+	strength     = scale * 100.0f / 65536.0f;
+
+	SDL_HapticEffect effect;
+	memset( &effect, 0, sizeof( SDL_HapticEffect ) );
+
+	effect.type                      = SDL_HAPTIC_CONSTANT;
+	effect.constant.direction.type   = SDL_HAPTIC_POLAR;
+	effect.constant.direction.dir[0] = 0;
+	effect.constant.length           = 200; // 200ms
+	effect.constant.level            = static_cast<Sint16>( ( scale * 32767u ) >> 16 );
+	effect.constant.attack_length    = 0;
+	effect.constant.fade_length      = 100;
+
+	std::lock_guard<std::mutex> lock( hapticMutex );
+
+	int effectId = SDL_HapticNewEffect( haptic, &effect );
+	if( effectId < 0 )
+	{
+		logger.log( Logger::ERROR, "Impossible de créer l'effet de collision: " + std::string( SDL_GetError() ) );
+		return;
+	}
+
+	SDL_HapticRunEffect( haptic, effectId, 1 );
+	SDL_Delay( 10 ); // Petit délai pour s'assurer que l'effet démarre
+
+	// L'effet sera détruit après sa durée
+	logger.log( Logger::DEBUG, "Collision simulée avec force: " + std::to_string( strength ) );
+
+	// Destruction différée de l'effet (après sa durée + marge)
+	SDL_TimerID timer = SDL_AddTimer( 300, []( Uint32 interval, void* param ) -> Uint32
+	{
+		int* pEffectId = static_cast<int*>( param );
+		SDL_HapticDestroyEffect( SDL_HapticOpen( 0 ), *pEffectId );
+		delete pEffectId;
+		return 0; // Ne pas répéter le timer
+	}, new int( effectId ) );
+}
+
+void ForceManager::playEffect( int index, Logger& logger )
+{
+	if( softwareMixing && ffbEnabled && index >= 0 && index < static_cast<int>( effects.size() ) )
+	{
+		// Relancer l'effet depuis le début de son enveloppe
+		std::lock_guard<std::mutex> lock( mixerMutex );
+		mixerEffects[index].startTime = SDL_GetPerformanceCounter();
+		logger.log( Logger::DEBUG, "Effet " + effects[index].name + " relancé dans le mixeur" );
+		return;
+	}
+
+	if( !haptic || !ffbEnabled || index >= effects.size() )
+	{
+		logger.log( Logger::DEBUG, "Lecture d'effet ignorée: haptic non disponible ou désactivé" );
+		return;
+	}
+
+	auto& effect = effects[index];
+
+	if( effect.effectId < 0 )
+	{
+		logger.log( Logger::WARNING, "Effet " + effect.name + " non initialisé" );
+		return;
+	}
+
+	// Mettre à jour l'effet avec les paramètres actuels
+	updateEffect( index );
+
+	// Jouer l'effet
+	{
+		std::lock_guard<std::mutex> lock( hapticMutex );
+		SDL_HapticRunEffect( haptic, effect.effectId, 1 );
+	}
+	logger.log( Logger::DEBUG, "Effet " + effect.name + " joué avec force: " + std::to_string( effect.strength * masterStrength / 100.0f ) );
+}
+
+void ForceManager::updateEffect( int index )
+{
+	// En mixage logiciel, les effets matériels individuels ne sont pas utilisés
+	if( !haptic || softwareMixing || index < 0 || index >= static_cast<int>( effects.size() ) || effects[index].effectId < 0 )
+	{
+		return;
+	}
+
+	// Recompiler et renvoyer au périphérique uniquement si un paramètre source a changé
+	if( isCompiledCurrent( index ) )
+	{
+		return;
+	}
+
+	compileEffect( index );
+
+	std::lock_guard<std::mutex> lock( hapticMutex );
+	SDL_HapticUpdateEffect( haptic, effects[index].effectId, &compiled[index].sdlEffect );
+}
+
+void ForceManager::stopAllEffects()
+{
+	// Désactiver tous les effets dans le modèle, y compris sans périphérique: le mixeur du mode démo
+	// republie l'état du modèle à chaque mise à jour et relancerait les effets
+	for( auto& effect : effects )
+	{
+		effect.enabled = false;
+	}
+
+	if( softwareMixing )
+	{
+		std::lock_guard<std::mutex> lock( mixerMutex );
+		for( auto& mixed : mixerEffects )
+		{
+			mixed.enabled = false;
+		}
+		mixerStep = 0;
+	}
+
+	if( !haptic )
+	{
+		return;
+	}
+
+	// En mixage, seul l'effet de sortie reste actif (à force nulle)
+	if( !softwareMixing )
+	{
+		std::lock_guard<std::mutex> lock( hapticMutex );
+		SDL_HapticStopAll( haptic );
+	}
+}
+
+void ForceManager::update( Logger& logger )
+{
+	if( !ffbEnabled )
+	{
+		return;
+	}
+
+	if( softwareMixing )
+	{
+		publishMixerEffects();
+		return;
+	}
+
+	if( !haptic )
+	{
+		return;
+	}
+
+	// Jouer tous les effets actifs
+	for( size_t i = 0; i < effects.size(); ++i )
+	{
+		auto& effect = effects[i];
+
+		if( effect.enabled && effect.effectId >= 0 )
+		{
+			// Vérifier si l'effet est déjà en cours
+			if( SDL_HapticGetEffectStatus( haptic, effect.effectId ) == 0 )
+			{
+				// Mettre à jour et jouer l'effet
+				updateEffect( i );
+				SDL_HapticRunEffect( haptic, effect.effectId, 1 );
+				logger.log( Logger::DEBUG, "Effet " + effect.name + " activé" );
+			}
+		}
+		else if( !effect.enabled && effect.effectId >= 0 )
+		{
+			// Arrêter l'effet s'il est actif
+			if( SDL_HapticGetEffectStatus( haptic, effect.effectId ) > 0 )
+			{
+				SDL_HapticStopEffect( haptic, effect.effectId );
+				logger.log( Logger::DEBUG, "Effet " + effect.name + " désactivé" );
+			}
+		}
+	}
+}
+
+ResultCode ForceManager::startConstantStep( float level, Uint64& outTimestamp, Logger& logger )
+{
+	if( !ffbEnabled )
+	{
+		logger.log( Logger::WARNING, "Échelon de force ignoré: retour de force désactivé" );
+		return ERROR_INVALID_PARAMETER;
+	}
+
+	// La force globale n'est pas appliquée pour garder des mesures reproductibles
+	level = std::max( -1.0f, std::min( 1.0f, level ) );
+
+	if( softwareMixing && mixerRunning )
+	{
+		// L'échelon passe par le mixeur: la mesure inclut son cycle de traitement
+		outTimestamp = SDL_GetPerformanceCounter();
+		mixerStep    = static_cast<int>( 32767.0f * level );
+		return SUCCESS;
+	}
+
+	if( haptic )
+	{
+		std::lock_guard<std::mutex> lock( hapticMutex );
+
+		SDL_HapticEffect effect;
+		memset( &effect, 0, sizeof( SDL_HapticEffect ) );
+
+		effect.type                      = SDL_HAPTIC_CONSTANT;
+		effect.constant.direction.type   = SDL_HAPTIC_POLAR;
+		effect.constant.direction.dir[0] = 0;
+		effect.constant.length           = SDL_HAPTIC_INFINITY;
+		effect.constant.level            = static_cast<Sint16>( 32767.0f * level );
+
+		if( stepEffectId < 0 )
+		{
+			stepEffectId = SDL_HapticNewEffect( haptic, &effect );
+		}
+		else
+		{
+			SDL_HapticUpdateEffect( haptic, stepEffectId, &effect );
+		}
+
+		if( stepEffectId < 0 )
+		{
+			logger.log( Logger::ERROR, "Impossible de créer l'échelon de force: " + std::string( SDL_GetError() ) );
+			return ERROR_INVALID_PARAMETER;
+		}
+
+		outTimestamp = SDL_GetPerformanceCounter();
+		if( SDL_HapticRunEffect( haptic, stepEffectId, 1 ) < 0 )
+		{
+			logger.log( Logger::ERROR, "Impossible de jouer l'échelon de force: " + std::string( SDL_GetError() ) );
+			return ERROR_INVALID_PARAMETER;
+		}
+
+		return SUCCESS;
+	}
+
+	if( simulatedWheel )
+	{
+		outTimestamp = SDL_GetPerformanceCounter();
+		simulatedWheel->applyForce( level, outTimestamp );
+		return SUCCESS;
+	}
+
+	logger.log( Logger::WARNING, "Échelon de force ignoré: aucun dispositif haptic" );
+	return ERROR_JOYSTICK_NOT_FOUND;
+}
+
+void ForceManager::stopConstantStep()
+{
+	if( softwareMixing && mixerRunning )
+	{
+		mixerStep = 0;
+	}
+	else if( haptic && stepEffectId >= 0 )
+	{
+		std::lock_guard<std::mutex> lock( hapticMutex );
+		SDL_HapticStopEffect( haptic, stepEffectId );
+	}
+	else if( simulatedWheel )
+	{
+		simulatedWheel->applyForce( 0.0f, SDL_GetPerformanceCounter() );
+	}
+}
+
+void ForceManager::setSimulatedWheel( SimulatedWheel* simulation )
+{
+	stopMixer();
+	simulatedWheel = simulation;
+
+	if( softwareMixing && ( haptic || simulatedWheel ) )
+	{
+		startMixer();
+	}
+}
+
+void ForceManager::setInputSource( InputSampler* source )
+{
+	inputSource = source;
+}
+
+void ForceManager::setSoftwareMixing( bool enabled, Logger& logger )
+{
+	if( enabled == softwareMixing )
+	{
+		return;
+	}
+
+	stopMixer();
+	softwareMixing = enabled;
+
+	if( haptic )
+	{
+		std::lock_guard<std::mutex> lock( hapticMutex );
+		SDL_HapticStopAll( haptic );
+	}
+
+	if( enabled )
+	{
+		if( haptic && !( SDL_HapticQuery( haptic ) & SDL_HAPTIC_CONSTANT ) )
+		{
+			logger.log( Logger::WARNING, "Mixage logiciel indisponible: effet constant non supporté" );
+			softwareMixing = false;
+			return;
+		}
+
+		if( haptic || simulatedWheel )
+		{
+			startMixer();
+		}
+		logger.log( Logger::INFO, "Mixage logiciel des effets activé" );
+	}
+	else
+	{
+		logger.log( Logger::INFO, "Mixage logiciel des effets désactivé" );
+	}
+}
+
+bool ForceManager::isSoftwareMixing() const
+{
+	return softwareMixing;
+}
+
+int ForceManager::getMixerOutput() const
+{
+	return mixerOutput;
+}
+
+void ForceManager::startMixer()
+{
+	if( mixerRunning )
+	{
+		return;
+	}
+
+	if( haptic )
+	{
+		// Unique effet matériel: une force constante infinie dont on module le niveau
+		SDL_HapticEffect effect;
+		memset( &effect, 0, sizeof( SDL_HapticEffect ) );
+		effect.type                    = SDL_HAPTIC_CONSTANT;
+		effect.constant.direction.type = SDL_HAPTIC_POLAR;
+		effect.constant.length         = SDL_HAPTIC_INFINITY;
+
+		std::lock_guard<std::mutex> lock( hapticMutex );
+		mixerEffectId = SDL_HapticNewEffect( haptic, &effect );
+		if( mixerEffectId < 0 )
+		{
+			return;
+		}
+		SDL_HapticRunEffect( haptic, mixerEffectId, 1 );
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( mixerMutex );
+		for( auto& mixed : mixerEffects )
+		{
+			mixed.enabled = false;
+		}
+	}
+
+	mixerStep    = 0;
+	mixerOutput  = 0;
+	mixerRunning = true;
+	mixerThread  = std::thread( &ForceManager::mixerLoop, this );
+}
+
+void ForceManager::stopMixer()
+{
+	mixerRunning = false;
+
+	if( mixerThread.joinable() )
+	{
+		mixerThread.join();
+	}
+
+	if( haptic && mixerEffectId >= 0 )
+	{
+		std::lock_guard<std::mutex> lock( hapticMutex );
+		SDL_HapticStopEffect( haptic, mixerEffectId );
+		SDL_HapticDestroyEffect( haptic, mixerEffectId );
+	}
+	mixerEffectId = -1;
+
+	if( simulatedWheel )
+	{
+		simulatedWheel->applyForce( 0.0f, SDL_GetPerformanceCounter() );
+	}
+}
+
+void ForceManager::publishMixerEffects()
+{
+	Uint64 now = SDL_GetPerformanceCounter();
+
+	// Ne recompiler que les effets dont les paramètres ont changé
+	for( size_t i = 0; i < effects.size(); ++i )
+	{
+		if( !isCompiledCurrent( i ) )
+		{
+			compileEffect( i );
+		}
+	}
+
+	std::lock_guard<std::mutex> lock( mixerMutex );
+	for( size_t i = 0; i < effects.size(); ++i )
+	{
+		MixerEffect&          mixed  = mixerEffects[i];
+		const CompiledEffect& source = compiled[i];
+
+		// L'enveloppe repart de zéro à l'activation de l'effet
+		if( effects[i].enabled && !mixed.enabled )
+		{
+			mixed.startTime = now;
+		}
+
+		mixed.enabled = effects[i].enabled;
+		mixed.level   = source.level;
+		mixed.length  = source.length;
+		mixed.attack     = source.attack;
+		mixed.fade       = source.fade;
+		mixed.attackRate = source.attackRate;
+		mixed.fadeRate   = source.fadeRate;
+	}
+}
+
+void ForceManager::mixerLoop()
+{
+	// Cadence du mixeur: 500 Hz, indépendante de l'affichage
+	const auto period = std::chrono::microseconds( 2000 );
+
+	float  lastPosition = 0.0f;
+	float  velocity     = 0.0f;
+	Uint64 lastSample   = 0;
+	Sint32 lastSent     = 32768 + 1; // Valeur impossible: force le premier envoi
+	auto   next         = std::chrono::steady_clock::now();
+
+	SDL_HapticEffect output;
+	memset( &output, 0, sizeof( SDL_HapticEffect ) );
+	output.type                    = SDL_HAPTIC_CONSTANT;
+	output.constant.direction.type = SDL_HAPTIC_POLAR;
+	output.constant.length         = SDL_HAPTIC_INFINITY;
+
+	while( mixerRunning )
+	{
+		Uint64 now = SDL_GetPerformanceCounter();
+
+		// Position et vitesse du volant depuis le flux haute fréquence
+		RawInputSample sample;
+		if( inputSource && inputSource->getLatest( sample ) && sample.timestamp != lastSample )
+		{
+			float position = sample.axes[inputSource->getSteeringLane()] / 32767.0f;
+			if( lastSample != 0 && sample.timestamp > lastSample )
+			{
+				float dt = static_cast<float>( performanceCounterToMs( sample.timestamp - lastSample ) / 1000.0 );
+				velocity += 0.2f * ( ( position - lastPosition ) / dt - velocity ); // Filtre passe-bas
+			}
+			lastPosition = position;
+			lastSample   = sample.timestamp;
+		}
+
+		{
+			// Même taille à chaque copie: pas d'allocation
+			std::lock_guard<std::mutex> lock( mixerMutex );
+			mixerScratch = mixerEffects;
+		}
+
+		Sint32 sum   = mixForces( mixerScratch, lastPosition, velocity, now ) + mixerStep;
+		Sint32 force = std::max( -32767, std::min( 32767, sum ) );
+		mixerOutput  = force;
+
+		// N'envoyer au périphérique que les changements de niveau
+		if( force != lastSent )
+		{
+			if( haptic && mixerEffectId >= 0 )
+			{
+				output.constant.level = static_cast<Sint16>( force );
+
+				std::lock_guard<std::mutex> lock( hapticMutex );
+				SDL_HapticUpdateEffect( haptic, mixerEffectId, &output );
+			}
+			else if( simulatedWheel )
+			{
+				simulatedWheel->applyForce( force / 32767.0f, now );
+			}
+			lastSent = force;
+		}
+
+		next += period;
+		auto current = std::chrono::steady_clock::now();
+		if( next < current )
+		{
+			next = current;
+		}
+		std::this_thread::sleep_until( next );
+	}
+}
+
+Sint32 ForceManager::mixForces( const std::vector<MixerEffect>& mix, float position, float velocity, Uint64 now ) const
+{
+	// Table de sinus Q15 précalculée (256 pas par période)
+	static const struct SineTable
+	{
+		Sint16 values[256];
+		SineTable()
+		{
+			for( int i = 0; i < 256; ++i )
+			{
+				values[i] = static_cast<Sint16>( 32767.0 * sin( i * 2.0 * M_PI / 256.0 ) );
+			}
+		}
+	} sine;
+
+	// Vitesse de référence: deux tours de butée à butée par seconde = pleine échelle
+	const Sint32 positionQ15 = static_cast<Sint32>( std::max( -1.0f, std::min( 1.0f, position ) ) * 32767.0f );
+	const Sint32 velocityQ15 = static_cast<Sint32>( std::max( -1.0f, std::min( 1.0f, velocity / 4.0f ) ) * 32767.0f );
+	const Sint32 frictionQ15 = static_cast<Sint32>( std::max( -1.0f, std::min( 1.0f, velocity / 0.05f ) ) * 32767.0f );
+
+	Sint32 sum = 0;
+	for( const auto& effect : mix )
+	{
+		if( !effect.enabled )
+		{
+			continue;
+		}
+
+		Uint32 elapsed = static_cast<Uint32>( performanceCounterToMs( now - effect.startTime ) );
+
+		// Les effets à durée finie sont bouclés tant qu'ils sont actifs (comme en mode matériel)
+		if( effect.length != SDL_HAPTIC_INFINITY && effect.length > 0 )
+		{
+			if( effect.oneShot && elapsed >= effect.length )
+			{
+				continue;
+			}
+			elapsed %= effect.length;
+		}
+
+		// Enveloppe linéaire d'attaque et d'atténuation (Q15), pentes précalculées à la compilation
+		Sint32 gain = 32767;
+		if( elapsed < effect.attack )
+		{
+			gain = static_cast<Sint32>( ( static_cast<Uint64>( elapsed ) * effect.attackRate ) >> 16 );
+		}
+		else if( effect.fade > 0 && effect.length != SDL_HAPTIC_INFINITY && elapsed + effect.fade > effect.length )
+		{
+			gain = static_cast<Sint32>( ( static_cast<Uint64>( effect.length - elapsed ) * effect.fadeRate ) >> 16 );
+		}
+
+		Sint32 value = 0;
+		switch( effect.kind )
+		{
+			case EFFECT_KIND_CONSTANT:
+				value = effect.level;
+				break;
+
+			case EFFECT_KIND_PERIODIC:
+			{
+				Uint32 phase = effect.period ? ( elapsed % effect.period ) * 256u / effect.period : 0;
+				Sint32 wave  = effect.sdlType == SDL_HAPTIC_SINE ? sine.values[phase] : static_cast<Sint32>( phase ) * 256 - 32768;
+				value        = ( effect.level * wave ) >> 15;
+				break;
+			}
+
+			case EFFECT_KIND_CONDITION:
+				if( effect.sdlType == SDL_HAPTIC_SPRING )
+				{
+					value = -( ( effect.level * positionQ15 ) >> 15 );
+				}
+				else if( effect.sdlType == SDL_HAPTIC_DAMPER )
+				{
+					value = -( ( effect.level * velocityQ15 ) >> 15 );
+				}
+				else
+				{
+					value = -( ( effect.level * frictionQ15 ) >> 15 );
+				}
+				break;
+
+			case EFFECT_KIND_LEFTRIGHT:
+				// Un volant n'a qu'un moteur: vibration à 25 Hz
+				value = ( effect.level * sine.values[( elapsed % 40u ) * 256u / 40u] ) >> 15;
+				break;
+		}
+
+		sum += ( value * gain ) >> 15;
+	}
+
+	return sum;
+}
+
+bool ForceManager::isFFBEnabled() const
+{
+	return ffbEnabled;
+}
+
+void ForceManager::setFFBEnabled( bool enabled )
+{
+	ffbEnabled = enabled;
+
+	if( !enabled && softwareMixing )
+	{
+		// Le mixeur continue de tourner mais ne produit plus de force
+		std::lock_guard<std::mutex> lock( mixerMutex );
+		for( auto& mixed : mixerEffects )
+		{
+			mixed.enabled = false;
+		}
+		mixerStep = 0;
+	}
+	else if( !enabled && haptic )
+	{
+		std::lock_guard<std::mutex> lock( hapticMutex );
+		SDL_HapticStopAll( haptic );
+	}
+}
+
+float ForceManager::getMasterStrength() const
+{
+	return masterStrength;
+}
+
+void ForceManager::setMasterStrength( float strength )
+{
+	masterStrength = strength;
+	masterScale    = static_cast<Uint32>( std::max( 0.0f, std::min( 100.0f, strength ) ) * 655.36f + 0.5f );
+
+	// Mettre à jour tous les effets
+	for( size_t i = 0; i < effects.size(); ++i )
+	{
+		updateEffect( i );
+	}
+}
+
+std::vector<ForceEffect>& ForceManager::getEffects()
+{
+	return effects;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE DEVICEDATABASE
+// =============================================================================
+
+static std::string trimString( const std::string& text )
+{
+	size_t first = text.find_first_not_of( " \t\r\n" );
+	if( first == std::string::npos )
+	{
+		return "";
+	}
+
+	size_t last = text.find_last_not_of( " \t\r\n" );
+	return text.substr( first, last - first + 1 );
+}
+
+static bool parseHex16( const std::string& text, Uint16& outValue )
+{
+	char*         end   = nullptr;
+	unsigned long value = strtoul( text.c_str(), &end, 16 );
+	if( end == text.c_str() || *end != '\0' || value > 0xFFFF )
+	{
+		return false;
+	}
+
+	outValue = static_cast<Uint16>( value );
+	return true;
+}
+
+static bool parseAxisRole( const std::string& text, AxisRole& outRole )
+{
+	static const std::unordered_map<std::string, AxisRole> roles = {
+		{ "none", AXIS_ROLE_NONE },
+		{ "steering", AXIS_ROLE_STEERING },
+		{ "throttle", AXIS_ROLE_THROTTLE },
+		{ "brake", AXIS_ROLE_BRAKE },
+		{ "clutch", AXIS_ROLE_CLUTCH },
+		{ "shifter_x", AXIS_ROLE_SHIFTER_X },
+		{ "shifter_y", AXIS_ROLE_SHIFTER_Y },
+		{ "handbrake", AXIS_ROLE_HANDBRAKE }
+	};
+
+	auto it = roles.find( text );
+	if( it == roles.end() )
+	{
+		return false;
+	}
+
+	outRole = it->second;
+	return true;
+}
+
+static bool parseDeviceKind( const std::string& text, DeviceKind& outKind )
+{
+	static const std::unordered_map<std::string, DeviceKind> kinds = {
+		{ "wheel", DEVICE_KIND_WHEEL },
+		{ "pedals", DEVICE_KIND_PEDALS },
+		{ "shifter", DEVICE_KIND_SHIFTER },
+		{ "handbrake", DEVICE_KIND_HANDBRAKE }
+	};
+
+	auto it = kinds.find( text );
+	if( it == kinds.end() )
+	{
+		return false;
+	}
+
+	outKind = it->second;
+	return true;
+}
+
+// Liste d'effets séparés par des virgules, "all" ou "none"
+static bool parseEffectMask( const std::string& text, unsigned& outMask )
+{
+	static const std::unordered_map<std::string, unsigned> effectFlags = {
+		{ "constant", SDL_HAPTIC_CONSTANT },
+		{ "sine", SDL_HAPTIC_SINE },
+		{ "leftright", SDL_HAPTIC_LEFTRIGHT },
+		{ "triangle", SDL_HAPTIC_TRIANGLE },
+		{ "sawtooth", SDL_HAPTIC_SAWTOOTHUP | SDL_HAPTIC_SAWTOOTHDOWN },
+		{ "ramp", SDL_HAPTIC_RAMP },
+		{ "spring", SDL_HAPTIC_SPRING },
+		{ "damper", SDL_HAPTIC_DAMPER },
+		{ "inertia", SDL_HAPTIC_INERTIA },
+		{ "friction", SDL_HAPTIC_FRICTION }
+	};
+
+	if( text == "all" )
+	{
+		outMask = ~0u;
+		return true;
+	}
+
+	outMask = 0;
+	if( text == "none" )
+	{
+		return true;
+	}
+
+	std::stringstream stream( text );
+	std::string       name;
+	while( std::getline( stream, name, ',' ) )
+	{
+		auto it = effectFlags.find( trimString( name ) );
+		if( it == effectFlags.end() )
+		{
+			return false;
+		}
+		outMask |= it->second;
+	}
+
+	return true;
+}
+
+// rôle,min,max,zone morte[,inverted]
+static bool parseAxisProfile( const std::string& text, AxisProfile& outAxis )
+{
+	std::vector<std::string> fields;
+	std::stringstream        stream( text );
+	std::string              field;
+	while( std::getline( stream, field, ',' ) )
+	{
+		fields.push_back( trimString( field ) );
+	}
+
+	if( fields.size() < 4 || fields.size() > 5 || !parseAxisRole( fields[0], outAxis.role ) )
+	{
+		return false;
+	}
+
+	char* end        = nullptr;
+	outAxis.min      = strtof( fields[1].c_str(), &end );
+	bool valid       = *end == '\0';
+	outAxis.max      = strtof( fields[2].c_str(), &end );
+	valid            = valid && *end == '\0';
+	outAxis.deadzone = strtof( fields[3].c_str(), &end );
+	valid            = valid && *end == '\0' && outAxis.min < outAxis.max && outAxis.deadzone >= 0.0f && outAxis.deadzone < 1.0f;
+
+	outAxis.inverted = fields.size() == 5 && fields[4] == "inverted";
+	return valid && ( fields.size() == 4 || outAxis.inverted );
+}
+
+DeviceDatabase::DeviceDatabase()
+{
+	// Seul profil intégré: les axes sont nommés par position et tous les effets sont autorisés,
+	// le retour de force n'est activé que si SDL annonce le périphérique comme haptique
+	genericWheel.name             = "Volant générique";
+	genericWheel.vendorId         = 0;
+	genericWheel.productId        = 0;
+	genericWheel.kind             = DEVICE_KIND_WHEEL;
+	genericWheel.hasForceFeedback = true;
+	genericWheel.ffbEffects       = ~0u;
+}
+
+void DeviceDatabase::addProfile( const DeviceProfile& profile )
+{
+	size_t index = profiles.size();
+
+	// Un profil de même clé remplace le précédent
+	if( !profile.guid.empty() )
+	{
+		auto it = byGuid.find( profile.guid );
+		if( it != byGuid.end() )
+		{
+			profiles[it->second] = profile;
+			return;
+		}
+		byGuid[profile.guid] = index;
+	}
+	else
+	{
+		Uint32 key = ( static_cast<Uint32>( profile.vendorId ) << 16 ) | profile.productId;
+		auto   it  = byVendorProduct.find( key );
+		if( it != byVendorProduct.end() )
+		{
+			profiles[it->second] = profile;
+			return;
+		}
+		byVendorProduct[key] = index;
+	}
+
+	profiles.push_back( profile );
+}
+
+size_t DeviceDatabase::loadFromStream( std::istream& stream )
+{
+	size_t        loaded    = 0;
+	bool          inProfile = false;
+	bool          valid     = false;
+	bool          hasVendor = false;
+	DeviceProfile current;
+
+	// Valider et enregistrer le profil en cours
+	auto finishProfile = [&]() {
+		if( inProfile && valid && ( hasVendor || !current.guid.empty() ) )
+		{
+			addProfile( current );
+			++loaded;
+		}
+	};
+
+	std::string line;
+	while( std::getline( stream, line ) )
+	{
+		line = trimString( line );
+		if( line.empty() || line[0] == '#' || line[0] == ';' )
+		{
+			continue;
+		}
+
+		if( line.front() == '[' && line.back() == ']' )
+		{
+			finishProfile();
+
+			current                  = DeviceProfile();
+			current.name             = line.substr( 1, line.size() - 2 );
+			current.vendorId         = 0;
+			current.productId        = 0;
+			current.kind             = DEVICE_KIND_WHEEL;
+			current.hasForceFeedback = false;
+			current.ffbEffects       = 0;
+			inProfile                = true;
+			valid                    = true;
+			hasVendor                = false;
+			continue;
+		}
+
+		size_t pos = line.find( '=' );
+		if( !inProfile || pos == std::string::npos )
+		{
+			continue;
+		}
+
+		std::string key   = trimString( line.substr( 0, pos ) );
+		std::string value = trimString( line.substr( pos + 1 ) );
+
+		if( key == "vendor" )
+		{
+			hasVendor = parseHex16( value, current.vendorId );
+			valid     = valid && hasVendor;
+		}
+		else if( key == "product" )
+		{
+			valid = valid && parseHex16( value, current.productId );
+		}
+		else if( key == "guid" )
+		{
+			current.guid = value;
+		}
+		else if( key == "kind" )
+		{
+			valid = valid && parseDeviceKind( value, current.kind );
+		}
+		else if( key == "ffb" )
+		{
+			valid                    = valid && parseEffectMask( value, current.ffbEffects );
+			current.hasForceFeedback = current.ffbEffects != 0;
+		}
+		else if( key.compare( 0, 4, "axis" ) == 0 )
+		{
+			// axisN: les axes sont indexés comme dans SDL
+			char*         end   = nullptr;
+			unsigned long index = strtoul( key.c_str() + 4, &end, 10 );
+			AxisProfile   axis;
+			if( *end != '\0' || index >= 64 || !parseAxisProfile( value, axis ) )
+			{
+				valid = false;
+				continue;
+			}
+
+			if( current.axes.size() <= index )
+			{
+				current.axes.resize( index + 1, { AXIS_ROLE_NONE, -1.0f, 1.0f, 0.05f, false } );
+			}
+			current.axes[index] = axis;
+		}
+	}
+
+	finishProfile();
+	return loaded;
+}
+
+ResultCode DeviceDatabase::loadFromFile( const std::string& filename, Logger& logger )
+{
+	std::ifstream file( filename );
+	if( !file.is_open() )
+	{
+		logger.log( Logger::INFO, "Fichier de profils non trouvé: " + filename + ", volants reconnus par leur type ou leur nom uniquement" );
+		return ERROR_FILE_OPEN_FAILED;
+	}
+
+	size_t loaded = loadFromStream( file );
+	logger.log( Logger::INFO, std::to_string( loaded ) + " profils de périphériques chargés depuis " + filename );
+
+	return SUCCESS;
+}
+
+const DeviceProfile* DeviceDatabase::find( Uint16 vendorId, Uint16 productId, const std::string& guid ) const
+{
+	if( !guid.empty() )
+	{
+		auto it = byGuid.find( guid );
+		if( it != byGuid.end() )
+		{
+			return &profiles[it->second];
+		}
+	}
+
+	if( vendorId == 0 )
+	{
+		return nullptr;
+	}
+
+	// Produit exact, puis profil générique du fabricant
+	Uint32 key = ( static_cast<Uint32>( vendorId ) << 16 ) | productId;
+	auto   it  = byVendorProduct.find( key );
+	if( it == byVendorProduct.end() )
+	{
+		it = byVendorProduct.find( static_cast<Uint32>( vendorId ) << 16 );
+	}
+
+	return it != byVendorProduct.end() ? &profiles[it->second] : nullptr;
+}
+
+const DeviceProfile& DeviceDatabase::getGenericWheel() const
+{
+	return genericWheel;
+}
+
+size_t DeviceDatabase::getProfileCount() const
+{
+	return profiles.size();
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE THEMELIBRARY
+// =============================================================================
+
+// Thème par défaut, toujours disponible (même format que themes.ini)
+static const char* BUILTIN_THEMES = R"(
+[Bleu nuit]
+primary=0.07,0.13,0.17
+secondary=0.11,0.22,0.33
+accent=0.0,0.47,0.84
+accent_light=0.2,0.6,1.0
+text=0.9,0.9,0.9
+muted_text=0.7,0.7,0.7
+active=0.1,0.75,0.4
+active_hover=0.2,0.85,0.5
+warning=1.0,0.6,0.0
+error=0.9,0.2,0.2
+rounding=5
+)";
+
+// r,g,b[,a] entre 0 et 1
+static bool parseThemeColor( const std::string& text, ImVec4& outColor )
+{
+	std::istringstream stream( text );
+	std::string        field;
+	float              channels[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	int                count       = 0;
+	while( std::getline( stream, field, ',' ) )
+	{
+		if( count == 4 )
+		{
+			return false;
+		}
+
+		field       = trimString( field );
+		char* end   = nullptr;
+		float value = strtof( field.c_str(), &end );
+		if( field.empty() || *end != '\0' || value < 0.0f || value > 1.0f )
+		{
+			return false;
+		}
+		channels[count++] = value;
+	}
+
+	if( count < 3 )
+	{
+		return false;
+	}
+
+	outColor = ImVec4( channels[0], channels[1], channels[2], channels[3] );
+	return true;
+}
+
+// Éclaircir (delta > 0) ou assombrir une couleur opaque
+static ImVec4 shadeColor( const ImVec4& color, float delta )
+{
+	return ImVec4( color.x + delta, color.y + delta, color.z + delta, 1.0f );
+}
+
+static ImVec4 withAlpha( const ImVec4& color, float alpha )
+{
+	return ImVec4( color.x, color.y, color.z, alpha );
+}
+
+ThemeLibrary::ThemeLibrary() : current( 0 ), version( 1 )
+{
+	std::istringstream builtin( BUILTIN_THEMES );
+	loadFromStream( builtin );
+}
+
+void ThemeLibrary::addTheme( UITheme theme )
+{
+	theme.sectionHeader        = theme.secondary;
+	theme.sectionHeaderHovered = shadeColor( theme.secondary, 0.1f );
+	theme.sectionHeaderActive  = shadeColor( theme.secondary, 0.15f );
+
+	// Un thème de même nom remplace le précédent
+	for( size_t i = 0; i < themes.size(); ++i )
+	{
+		if( themes[i].name == theme.name )
+		{
+			themes[i] = theme;
+			if( i == current )
+			{
+				version++;
+			}
+			return;
+		}
+	}
+
+	themes.push_back( theme );
+}
+
+size_t ThemeLibrary::loadFromStream( std::istream& stream )
+{
+	size_t  loaded  = 0;
+	bool    inTheme = false;
+	bool    valid   = false;
+	UITheme theme;
+
+	// Valider et enregistrer le thème en cours
+	auto finishTheme = [&]() {
+		if( inTheme && valid && !theme.name.empty() )
+		{
+			addTheme( theme );
+			++loaded;
+		}
+	};
+
+	std::string line;
+	while( std::getline( stream, line ) )
+	{
+		line = trimString( line );
+		if( line.empty() || line[0] == '#' || line[0] == ';' )
+		{
+			continue;
+		}
+
+		if( line.front() == '[' && line.back() == ']' )
+		{
+			finishTheme();
+
+			// Les clés absentes reprennent le thème par défaut
+			theme = themes.empty() ? UITheme() : themes.front();
+			if( themes.empty() )
+			{
+				theme.rounding = 5.0f;
+			}
+			theme.name = line.substr( 1, line.size() - 2 );
+			inTheme    = true;
+			valid      = true;
+			continue;
+		}
+
+		size_t pos = line.find( '=' );
+		if( !inTheme || pos == std::string::npos )
+		{
+			continue;
+		}
+
+		std::string key   = trimString( line.substr( 0, pos ) );
+		std::string value = trimString( line.substr( pos + 1 ) );
+
+		if( key == "primary" )
+		{
+			valid = parseThemeColor( value, theme.primary ) && valid;
+		}
+		else if( key == "secondary" )
+		{
+			valid = parseThemeColor( value, theme.secondary ) && valid;
+		}
+		else if( key == "accent" )
+		{
+			valid = parseThemeColor( value, theme.accent ) && valid;
+		}
+		else if( key == "accent_light" )
+		{
+			valid = parseThemeColor( value, theme.accentLight ) && valid;
+		}
+		else if( key == "text" )
+		{
+			valid = parseThemeColor( value, theme.text ) && valid;
+		}
+		else if( key == "muted_text" )
+		{
+			valid = parseThemeColor( value, theme.mutedText ) && valid;
+		}
+		else if( key == "active" )
+		{
+			valid = parseThemeColor( value, theme.active ) && valid;
+		}
+		else if( key == "active_hover" )
+		{
+			valid = parseThemeColor( value, theme.activeHover ) && valid;
+		}
+		else if( key == "warning" )
+		{
+			valid = parseThemeColor( value, theme.warning ) && valid;
+		}
+		else if( key == "error" )
+		{
+			valid = parseThemeColor( value, theme.error ) && valid;
+		}
+		else if( key == "rounding" )
+		{
+			char* end      = nullptr;
+			theme.rounding = strtof( value.c_str(), &end );
+			valid          = valid && *end == '\0' && theme.rounding >= 0.0f && theme.rounding <= 12.0f;
+		}
+	}
+
+	finishTheme();
+	return loaded;
+}
+
+ResultCode ThemeLibrary::loadFromFile( const std::string& filename, Logger& logger )
+{
+	std::ifstream file( filename );
+	if( !file.is_open() )
+	{
+		logger.log( Logger::INFO, "Fichier de thèmes non trouvé: " + filename + ", thème intégré uniquement" );
+		return ERROR_FILE_OPEN_FAILED;
+	}
+
+	size_t loaded = loadFromStream( file );
+	logger.log( Logger::INFO, std::to_string( loaded ) + " thèmes chargés depuis " + filename );
+
+	return SUCCESS;
+}
+
+bool ThemeLibrary::select( const std::string& name )
+{
+	for( size_t i = 0; i < themes.size(); ++i )
+	{
+		if( themes[i].name == name )
+		{
+			select( i );
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThemeLibrary::select( size_t index )
+{
+	if( index < themes.size() && index != current )
+	{
+		current = index;
+		version++;
+	}
+}
+
+const std::vector<UITheme>& ThemeLibrary::getThemes() const
+{
+	return themes;
+}
+
+const UITheme& ThemeLibrary::getCurrent() const
+{
+	return themes[current];
+}
+
+size_t ThemeLibrary::getCurrentIndex() const
+{
+	return current;
+}
+
+Uint32 ThemeLibrary::getVersion() const
+{
+	return version;
+}
+
+void ThemeLibrary::apply( ImGuiStyle& style ) const
+{
+	const UITheme& theme = getCurrent();
+
+	// Arrondir les éléments
+	style.WindowRounding    = theme.rounding + 3.0f;
+	style.ChildRounding     = theme.rounding + 1.0f;
+	style.FrameRounding     = theme.rounding;
+	style.PopupRounding     = theme.rounding;
+	style.ScrollbarRounding = theme.rounding;
+	style.GrabRounding      = theme.rounding;
+	style.TabRounding       = theme.rounding;
+
+	// Espacement et taille
+	style.WindowPadding    = ImVec2( 12, 12 );
+	style.FramePadding     = ImVec2( 8, 4 );
+	style.ItemSpacing      = ImVec2( 10, 8 );
+	style.ItemInnerSpacing = ImVec2( 8, 6 );
+	style.IndentSpacing    = 22.0f;
+	style.ScrollbarSize    = 14.0f;
+	style.GrabMinSize      = 10.0f;
+
+	// Bordures et couleurs
+	style.WindowBorderSize = 1.0f;
+	style.ChildBorderSize  = 1.0f;
+	style.PopupBorderSize  = 1.0f;
+	style.FrameBorderSize  = 1.0f;
+	style.TabBorderSize    = 1.0f;
+
+	// Couleurs du style
+	style.Colors[ImGuiCol_Text]                 = theme.text;
+	style.Colors[ImGuiCol_TextDisabled]         = theme.mutedText;
+	style.Colors[ImGuiCol_WindowBg]             = theme.primary;
+	style.Colors[ImGuiCol_ChildBg]              = shadeColor( theme.primary, 0.03f );
+	style.Colors[ImGuiCol_PopupBg]              = theme.secondary;
+	style.Colors[ImGuiCol_Border]               = withAlpha( theme.accent, 0.4f );
+	style.Colors[ImGuiCol_BorderShadow]         = ImVec4( 0.0f, 0.0f, 0.0f, 0.0f );
+	style.Colors[ImGuiCol_FrameBg]              = theme.secondary;
+	style.Colors[ImGuiCol_FrameBgHovered]       = shadeColor( theme.secondary, 0.1f );
+	style.Colors[ImGuiCol_FrameBgActive]        = shadeColor( theme.secondary, 0.15f );
+	style.Colors[ImGuiCol_TitleBg]              = theme.secondary;
+	style.Colors[ImGuiCol_TitleBgActive]        = theme.accent;
+	style.Colors[ImGuiCol_TitleBgCollapsed]     = withAlpha( theme.accent, 0.5f );
+	style.Colors[ImGuiCol_MenuBarBg]            = shadeColor( theme.secondary, -0.02f );
+	style.Colors[ImGuiCol_ScrollbarBg]          = shadeColor( theme.secondary, -0.05f );
+	style.Colors[ImGuiCol_ScrollbarGrab]        = theme.accent;
+	style.Colors[ImGuiCol_ScrollbarGrabHovered] = theme.accentLight;
+	style.Colors[ImGuiCol_ScrollbarGrabActive]  = shadeColor( theme.accentLight, 0.1f );
+	style.Colors[ImGuiCol_CheckMark]            = theme.accentLight;
+	style.Colors[ImGuiCol_SliderGrab]           = theme.accent;
+	style.Colors[ImGuiCol_SliderGrabActive]     = theme.accentLight;
+	style.Colors[ImGuiCol_Button]               = theme.accent;
+	style.Colors[ImGuiCol_ButtonHovered]        = theme.accentLight;
+	style.Colors[ImGuiCol_ButtonActive]         = shadeColor( theme.accentLight, -0.1f );
+	style.Colors[ImGuiCol_Header]               = theme.accent;
+	style.Colors[ImGuiCol_HeaderHovered]        = theme.accentLight;
+	style.Colors[ImGuiCol_HeaderActive]         = shadeColor( theme.accentLight, -0.1f );
+	style.Colors[ImGuiCol_Separator]            = withAlpha( theme.accent, 0.5f );
+	style.Colors[ImGuiCol_SeparatorHovered]     = withAlpha( theme.accentLight, 0.5f );
+	style.Colors[ImGuiCol_SeparatorActive]      = withAlpha( theme.accentLight, 0.7f );
+	style.Colors[ImGuiCol_ResizeGrip]           = withAlpha( theme.accent, 0.25f );
+	style.Colors[ImGuiCol_ResizeGripHovered]    = withAlpha( theme.accent, 0.67f );
+	style.Colors[ImGuiCol_ResizeGripActive]     = theme.accent;
+	style.Colors[ImGuiCol_Tab]                  = theme.secondary;
+	style.Colors[ImGuiCol_TabHovered]           = theme.accent;
+	style.Colors[ImGuiCol_TabActive]            = shadeColor( theme.accent, 0.1f );
+	style.Colors[ImGuiCol_TabUnfocused]         = shadeColor( theme.secondary, -0.1f );
+	style.Colors[ImGuiCol_TabUnfocusedActive]   = theme.secondary;
+	style.Colors[ImGuiCol_PlotLines]            = theme.accent;
+	style.Colors[ImGuiCol_PlotLinesHovered]     = theme.accentLight;
+	style.Colors[ImGuiCol_PlotHistogram]        = theme.accent;
+	style.Colors[ImGuiCol_PlotHistogramHovered] = theme.accentLight;
+	style.Colors[ImGuiCol_TableHeaderBg]        = shadeColor( theme.secondary, 0.05f );
+	style.Colors[ImGuiCol_TableBorderStrong]    = withAlpha( theme.accent, 0.7f );
+	style.Colors[ImGuiCol_TableBorderLight]     = withAlpha( theme.accent, 0.3f );
+	style.Colors[ImGuiCol_TableRowBg]           = ImVec4( 0.0f, 0.0f, 0.0f, 0.0f );
+	style.Colors[ImGuiCol_TableRowBgAlt]        = ImVec4( 1.0f, 1.0f, 1.0f, 0.06f );
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE AXISCALIBRATOR
+// =============================================================================
+
+AxisCalibrator::AxisCalibrator() : state( IDLE ), stateStart( 0 ), settleMs( 500.0f ), restCount( 0 ), restMean( 0.0 ),
+								   restM2( 0.0 ), sweepCount( 0 ), rawMin( 0 ), rawMax( 0 )
+{
+}
+
+void AxisCalibrator::start( Uint64 now )
+{
+	state      = SETTLING;
+	stateStart = now;
+	restCount  = 0;
+	restMean   = 0.0;
+	restM2     = 0.0;
+	sweepCount = 0;
+	rawMin     = SDL_MAX_SINT16;
+	rawMax     = SDL_MIN_SINT16;
+}
+
+void AxisCalibrator::addSample( Sint16 raw, Uint64 timestamp )
+{
+	// Ignorer les échantillons antérieurs au démarrage
+	if( ( state != SETTLING && state != SWEEPING ) || timestamp < stateStart )
+	{
+		return;
+	}
+
+	if( state == SETTLING )
+	{
+		if( performanceCounterToMs( timestamp - stateStart ) < settleMs )
+		{
+			++restCount;
+			double delta = raw - restMean;
+			restMean += delta / restCount;
+			restM2 += delta * ( raw - restMean );
+		}
+		else
+		{
+			state = SWEEPING;
+		}
+	}
+
+	// Le repos fait aussi partie de la course
+	++sweepCount;
+	rawMin = std::min( rawMin, raw );
+	rawMax = std::max( rawMax, raw );
+}
+
+void AxisCalibrator::finish()
+{
+	if( isActive() )
+	{
+		state = DONE;
+	}
+}
+
+void AxisCalibrator::cancel()
+{
+	state = IDLE;
+}
+
+AxisCalibrator::State AxisCalibrator::getState() const
+{
+	return state;
+}
+
+bool AxisCalibrator::isActive() const
+{
+	return state == SETTLING || state == SWEEPING;
+}
+
+Uint64 AxisCalibrator::getSampleCount() const
+{
+	return sweepCount;
+}
+
+Sint16 AxisCalibrator::getRawMin() const
+{
+	return rawMin;
+}
+
+Sint16 AxisCalibrator::getRawMax() const
+{
+	return rawMax;
+}
+
+float AxisCalibrator::getCenter() const
+{
+	return static_cast<float>( restMean );
+}
+
+float AxisCalibrator::getNoise() const
+{
+	return restCount > 1 ? static_cast<float>( sqrt( restM2 / ( restCount - 1 ) ) ) : 0.0f;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE AXISSIGNALANALYZER
+// =============================================================================
+
+AxisSignalAnalyzer::AxisSignalAnalyzer() : spikeThreshold( 2048 )
+{
+	reset();
+}
+
+void AxisSignalAnalyzer::reset()
+{
+	memset( distinctBits, 0, sizeof( distinctBits ) );
+	distinctCount    = 0;
+	count            = 0;
+	mean             = 0.0;
+	m2               = 0.0;
+	rawMin           = 0;
+	rawMax           = 0;
+	quantizationStep = 0;
+	maxStep          = 0;
+	spikeCount       = 0;
+	previous[0]      = 0;
+	previous[1]      = 0;
+	jitterCount      = 0;
+	jitterSumSquares = 0.0;
+}
+
+void AxisSignalAnalyzer::setSpikeThreshold( int threshold )
+{
+	spikeThreshold = std::max( 1, threshold );
+}
+
+int AxisSignalAnalyzer::getSpikeThreshold() const
+{
+	return spikeThreshold;
+}
+
+void AxisSignalAnalyzer::addSample( Sint16 raw )
+{
+	// Valeurs distinctes: un bit par valeur brute
+	int    slot = raw - SDL_MIN_SINT16;
+	Uint64 mask = Uint64( 1 ) << ( slot & 63 );
+	if( !( distinctBits[slot >> 6] & mask ) )
+	{
+		distinctBits[slot >> 6] |= mask;
+		distinctCount++;
+	}
+
+	// Welford
+	count++;
+	double delta = raw - mean;
+	mean += delta / count;
+	m2 += delta * ( raw - mean );
+
+	if( count == 1 )
+	{
+		rawMin      = raw;
+		rawMax      = raw;
+		previous[1] = raw;
+		return;
+	}
+
+	rawMin = std::min( rawMin, raw );
+	rawMax = std::max( rawMax, raw );
+
+	int step = std::abs( raw - previous[1] );
+	maxStep  = std::max( maxStep, step );
+	if( step != 0 )
+	{
+		// Le pas de quantification divise tous les écarts observés
+		quantizationStep = std::gcd( quantizationStep, step );
+	}
+
+	if( step <= STILL_STEP )
+	{
+		jitterSumSquares += static_cast<double>( step ) * step;
+		jitterCount++;
+	}
+
+	// Pic: saut au-delà du seuil, puis retour près de la valeur d'avant le saut
+	if( count >= 3 && std::abs( previous[1] - previous[0] ) > spikeThreshold && std::abs( raw - previous[0] ) <= spikeThreshold / 4 )
+	{
+		spikeCount++;
+	}
+
+	previous[0] = previous[1];
+	previous[1] = raw;
+}
+
+AxisSignalStats AxisSignalAnalyzer::getStats() const
+{
+	AxisSignalStats stats;
+	stats.sampleCount      = count;
+	stats.mean             = mean;
+	stats.stdDev           = count > 1 ? std::sqrt( m2 / ( count - 1 ) ) : 0.0;
+	stats.rawMin           = rawMin;
+	stats.rawMax           = rawMax;
+	stats.distinctValues   = distinctCount;
+	stats.quantizationStep = quantizationStep;
+	stats.maxStep          = maxStep;
+	stats.spikeCount       = spikeCount;
+
+	// Écart successif de deux échantillons indépendants: variance doublée
+	stats.jitter         = jitterCount > 0 ? std::sqrt( jitterSumSquares / jitterCount / 2.0 ) : 0.0;
+	stats.effectiveBits  = distinctCount > 1 ? std::log2( static_cast<float>( distinctCount ) ) : 0.0f;
+	stats.resolutionBits = quantizationStep > 0 ? std::log2( 65536.0f / quantizationStep ) : 0.0f;
+
+	return stats;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE AXISHISTORY
+// =============================================================================
+
+AxisHistory::AxisHistory()
+{
+	setDuration( 10.0 );
+}
+
+void AxisHistory::setDuration( double seconds )
+{
+	duration    = seconds;
+	bucketTicks = std::max<Uint64>( 1, static_cast<Uint64>( seconds * SDL_GetPerformanceFrequency() / BUCKET_COUNT ) );
+	reset();
+}
+
+double AxisHistory::getDuration() const
+{
+	return duration;
+}
+
+void AxisHistory::reset()
+{
+	firstBucket  = 0;
+	headBucket   = 0;
+	changeBucket = 0;
+	lastValue    = 0.0f;
+	hasData      = false;
+}
+
+void AxisHistory::addSample( Uint64 timestamp, float value )
+{
+	Uint64 bucket = timestamp / bucketTicks;
+
+	if( !hasData )
+	{
+		firstBucket  = bucket;
+		headBucket   = bucket;
+		changeBucket = bucket;
+		hasData      = true;
+
+		bucketMin[bucket % BUCKET_COUNT] = value;
+		bucketMax[bucket % BUCKET_COUNT] = value;
+		lastValue                        = value;
+		return;
+	}
+
+	if( bucket > headBucket )
+	{
+		// Seaux sans échantillon: la dernière valeur est tenue (au plus un tour d'anneau)
+		Uint64 from = std::max( headBucket + 1, bucket >= BUCKET_COUNT ? bucket - BUCKET_COUNT + 1 : 0 );
+		for( Uint64 gap = from; gap < bucket; ++gap )
+		{
+			bucketMin[gap % BUCKET_COUNT] = lastValue;
+			bucketMax[gap % BUCKET_COUNT] = lastValue;
+		}
+
+		if( value != lastValue )
+		{
+			changeBucket = bucket;
+		}
+
+		bucketMin[bucket % BUCKET_COUNT] = value;
+		bucketMax[bucket % BUCKET_COUNT] = value;
+		headBucket                       = bucket;
+		lastValue                        = value;
+		return;
+	}
+
+	// Échantillon dans un seau encore présent dans l'anneau (les échantillons en retard ne sont pas perdus)
+	if( bucket < firstBucket || bucket + BUCKET_COUNT <= headBucket )
+	{
+		return;
+	}
+
+	size_t slot = bucket % BUCKET_COUNT;
+	if( value < bucketMin[slot] || value > bucketMax[slot] )
+	{
+		bucketMin[slot] = std::min( bucketMin[slot], value );
+		bucketMax[slot] = std::max( bucketMax[slot], value );
+		changeBucket    = std::max( changeBucket, bucket );
+	}
+	if( bucket == headBucket )
+	{
+		lastValue = value;
+	}
+}
+
+bool AxisHistory::getColumns( Uint64 now, int columnCount, float* outMin, float* outMax ) const
+{
+	if( !hasData || columnCount <= 0 )
+	{
+		return false;
+	}
+
+	// Fenêtre de BUCKET_COUNT seaux terminée par le seau courant
+	Sint64 nowBucket = static_cast<Sint64>( std::max( now / bucketTicks, headBucket ) );
+	Sint64 start     = nowBucket - BUCKET_COUNT + 1;
+	Sint64 oldest    = std::max( static_cast<Sint64>( firstBucket ), static_cast<Sint64>( headBucket ) - BUCKET_COUNT + 1 );
+	Sint64 head      = static_cast<Sint64>( headBucket );
+
+	// Chaque seau est lu une fois (ou répété si les colonnes sont plus nombreuses que les seaux)
+	for( int column = 0; column < columnCount; ++column )
+	{
+		Sint64 from = start + static_cast<Sint64>( column ) * BUCKET_COUNT / columnCount;
+		Sint64 to   = std::max( from + 1, start + static_cast<Sint64>( column + 1 ) * BUCKET_COUNT / columnCount );
+		float  low  = FLT_MAX;
+		float  high = -FLT_MAX;
+
+		for( Sint64 bucket = std::max( from, oldest ); bucket < to; ++bucket )
+		{
+			if( bucket > head )
+			{
+				// Aucun échantillon depuis: valeur tenue jusqu'à maintenant
+				low  = std::min( low, lastValue );
+				high = std::max( high, lastValue );
+				break;
+			}
+
+			size_t slot = static_cast<size_t>( bucket % BUCKET_COUNT );
+			low         = std::min( low, bucketMin[slot] );
+			high        = std::max( high, bucketMax[slot] );
+		}
+
+		outMin[column] = low;
+		outMax[column] = high;
+	}
+
+	return true;
+}
+
+bool AxisHistory::isScrolling( Uint64 now ) const
+{
+	// Au-delà, toute la fenêtre montre la valeur tenue et le tracé ne bouge plus
+	return hasData && now / bucketTicks < changeBucket + BUCKET_COUNT;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE DEVICEMANAGER
+// =============================================================================
+
+DeviceManager::DeviceManager() : haptic( nullptr ), usingDemo( true ), demoAnalysisReadIndex( 0 ), layoutVersion( 1 )
+{
+	// Initialiser les informations de démo
+	wheelInfo = {
+		"Logitech G29 Racing Wheel", 0, 24, 6, true, 0x046d, 0xc24f
+	};
+
+	// Axes de démo
+	axes = {
+		{ "Volant", 0.0f, -1.0f, 1.0f, 0.05f, 0.0f, false, 1.0f, 1.0f, false },
+		{ "Accélérateur", 0.0f, 0.0f, 1.0f, 0.1f, 0.0f, false, 1.0f, 1.0f, true },
+		{ "Frein", 0.0f, 0.0f, 1.0f, 0.1f, 0.0f, false, 1.0f, 1.0f, true },
+		{ "Embrayage", 0.0f, 0.0f, 1.0f, 0.1f, 0.0f, false, 1.0f, 1.0f, true },
+		{ "Levier de vitesse X", 0.0f, -1.0f, 1.0f, 0.1f, 0.0f, false, 1.0f, 1.0f, false },
+		{ "Levier de vitesse Y", 0.0f, -1.0f, 1.0f, 0.1f, 0.0f, false, 1.0f, 1.0f, false }
+	};
+
+	// Boutons de démo
+	buttons.clear();
+	buttonTaps.clear();
+	previousButtons.clear();
+	buttonCount = 24;
+	calibrators.resize( axes.size() );
+	signalAnalyzers.resize( axes.size() );
+	axisHistories.resize( axes.size() );
+
+	// Le mixeur logiciel lit la position du volant dans le flux haute fréquence
+	forceManager.setInputSource( &demoSampler );
+}
+
+DeviceManager::~DeviceManager()
+{
+	cleanup();
+}
+
+void DeviceManager::cleanup()
+{
+	// Arrêter le retour de force et l'échantillonnage avant de fermer les périphériques
+	forceManager.cleanup();
+	forceManager.setInputSource( &demoSampler );
+	demoSampler.stop();
+
+	if( haptic )
+	{
+		SDL_HapticClose( haptic );
+		haptic = nullptr;
+	}
+
+	for( auto& device : devices )
+	{
+		device->sampler.stop();
+		saveCalibration( *device );
+		if( device->joystick )
+		{
+			SDL_JoystickClose( device->joystick );
+		}
+	}
+	devices.clear();
+
+	hotplugEvents.clear();
+	pendingEvents.clear();
+	frameEvents.clear();
+}
+
+// Nom usuel des axes d'un volant selon leur position
+static std::string wheelAxisName( int axisIndex )
+{
+	switch( axisIndex )
+	{
+		case 0:
+			return "Volant";
+		case 1:
+			return "Accélérateur";
+		case 2:
+			return "Frein";
+		case 3:
+			return "Embrayage";
+		case 4:
+			return "Levier de vitesse X";
+		case 5:
+			return "Levier de vitesse Y";
+		default:
+			return "Axe " + std::to_string( axisIndex );
+	}
+}
+
+// Nom affiché d'un axe selon son rôle
+static const char* axisRoleName( AxisRole role )
+{
+	switch( role )
+	{
+		case AXIS_ROLE_STEERING:
+			return "Volant";
+		case AXIS_ROLE_THROTTLE:
+			return "Accélérateur";
+		case AXIS_ROLE_BRAKE:
+			return "Frein";
+		case AXIS_ROLE_CLUTCH:
+			return "Embrayage";
+		case AXIS_ROLE_SHIFTER_X:
+			return "Levier de vitesse X";
+		case AXIS_ROLE_SHIFTER_Y:
+			return "Levier de vitesse Y";
+		case AXIS_ROLE_HANDBRAKE:
+			return "Frein à main";
+		default:
+			return nullptr;
+	}
+}
+
+static std::string guidToString( SDL_JoystickGUID guid )
+{
+	char buffer[33];
+	SDL_JoystickGetGUIDString( guid, buffer, sizeof( buffer ) );
+	return buffer;
+}
+
+// Axe de direction du profil, lu par le mixeur logiciel et la mesure de latence (premier axe par défaut)
+static int steeringAxis( const DeviceProfile& profile )
+{
+	for( size_t j = 0; j < profile.axes.size(); ++j )
+	{
+		if( profile.axes[j].role == AXIS_ROLE_STEERING )
+		{
+			return static_cast<int>( j );
+		}
+	}
+
+	return 0;
+}
+
+// Un périphérique principal doit pouvoir porter la direction ou le retour de force
+static bool isWheelProfile( const DeviceProfile& profile )
+{
+	if( profile.kind == DEVICE_KIND_WHEEL || profile.hasForceFeedback )
+	{
+		return true;
+	}
+
+	for( const auto& axis : profile.axes )
+	{
+		if( axis.role == AXIS_ROLE_STEERING )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+ResultCode DeviceManager::initialize( Logger& logger )
+{
+	cleanup();
+
+	// Rechercher des joysticks
+	int numJoysticks = SDL_NumJoysticks();
+	if( numJoysticks <= 0 )
+	{
+		logger.log( Logger::WARNING, "Aucun joystick détecté, utilisation du mode démo" );
+		return startDemoMode( logger );
+	}
+
+	// Classer les joysticks d'après leur profil: le premier volant (direction ou retour de force) devient
+	// le périphérique principal, les pédaliers, leviers et freins à main d'un même poste sont ajoutés à la suite
+	std::vector<std::pair<int, const DeviceProfile*>> wheels;
+	std::vector<std::pair<int, const DeviceProfile*>> rigDevices;
+	for( int i = 0; i < numJoysticks; ++i )
+	{
+		const DeviceProfile* profile = findProfile( i );
+		if( !profile )
+		{
+			continue; // Ni profil ni volant reconnaissable
+		}
+
+		if( isWheelProfile( *profile ) )
+		{
+			wheels.push_back( { i, profile } );
+		}
+		else
+		{
+			rigDevices.push_back( { i, profile } );
+		}
+	}
+
+	for( const auto& entry : wheels )
+	{
+		openDevice( entry.first, *entry.second, devices.empty(), logger );
+	}
+
+	// Un pédalier ou un levier seul ne porte ni l'échantillonnage principal ni le retour de force
+	if( devices.empty() )
+	{
+		if( rigDevices.empty() )
+		{
+			logger.log( Logger::WARNING, "Aucun volant détecté, utilisation du mode démo" );
+		}
+		else
+		{
+			logger.log( Logger::WARNING, "Aucun volant détecté (" + std::to_string( rigDevices.size() ) + " périphérique(s) sans direction ni retour de force ignoré(s)), utilisation du mode démo" );
+		}
+		return startDemoMode( logger );
+	}
+
+	for( const auto& entry : rigDevices )
+	{
+		openDevice( entry.first, *entry.second, false, logger );
+	}
+
+	// État initial complet, puis uniquement les transitions reçues par événements
+	syncInputs();
+
+	// Le mixeur logiciel suit l'échantillonnage du périphérique principal
+	forceManager.setSimulatedWheel( nullptr );
+	forceManager.setInputSource( &devices.front()->sampler );
+
+	usingDemo = false;
+	return SUCCESS;
+}
+
+ResultCode DeviceManager::loadDeviceDatabase( const std::string& filename, Logger& logger )
+{
+	return database.loadFromFile( filename, logger );
+}
+
+// Volant absent de la base: type annoncé par SDL, sinon mots-clés du nom (hors manettes standard)
+static bool looksLikeWheel( int deviceIndex )
+{
+	if( SDL_JoystickGetDeviceType( deviceIndex ) == SDL_JOYSTICK_TYPE_WHEEL )
+	{
+		return true;
+	}
+
+	const char* name = SDL_JoystickNameForIndex( deviceIndex );
+	if( !name || SDL_IsGameController( deviceIndex ) )
+	{
+		return false;
+	}
+
+	std::string lowerName = name;
+	std::transform( lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower );
+
+	static const char* keywords[] = { "wheel", "volant", "racing", "driving", "g29", "g920", "t300", "t500" };
+	for( const char* keyword : keywords )
+	{
+		if( lowerName.find( keyword ) != std::string::npos )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+const DeviceProfile* DeviceManager::findProfile( int deviceIndex ) const
+{
+	const DeviceProfile* profile = database.find( SDL_JoystickGetDeviceVendor( deviceIndex ), SDL_JoystickGetDeviceProduct( deviceIndex ),
+												  guidToString( SDL_JoystickGetDeviceGUID( deviceIndex ) ) );
+	if( profile )
+	{
+		return profile;
+	}
+
+	return looksLikeWheel( deviceIndex ) ? &database.getGenericWheel() : nullptr;
+}
+
+bool DeviceManager::openDevice( int deviceIndex, const DeviceProfile& profile, bool primary, Logger& logger )
+{
+	SDL_Joystick* joystick = SDL_JoystickOpen( deviceIndex );
+	if( !joystick )
+	{
+		logger.log( Logger::WARNING, "Impossible d'ouvrir le joystick " + std::to_string( deviceIndex ) + ": " + SDL_GetError() );
+		return false;
+	}
+
+	const char* name = SDL_JoystickName( joystick );
+
+	auto device                  = std::make_unique<InputDevice>();
+	device->joystick             = joystick;
+	device->instanceId           = SDL_JoystickInstanceID( joystick );
+	device->guid                 = guidToString( SDL_JoystickGetGUID( joystick ) );
+	device->profile              = profile;
+	device->info.name            = name ? name : profile.name;
+	device->info.id              = deviceIndex;
+	device->info.buttonCount     = SDL_JoystickNumButtons( joystick );
+	device->info.axisCount       = SDL_JoystickNumAxes( joystick );
+	device->info.hasForceFeeback = profile.hasForceFeedback && SDL_JoystickIsHaptic( joystick );
+	device->info.vendorId        = SDL_JoystickGetVendor( joystick );
+	device->info.productId       = SDL_JoystickGetProduct( joystick );
+
+	// Le premier périphérique remplace les entrées de démo
+	if( primary )
+	{
+		axes.clear();
+		buttons.clear();
+		buttonTaps.clear();
+		previousButtons.clear();
+		buttonCount = 0;
+		calibrators.clear();
+		signalAnalyzers.clear();
+		axisHistories.clear();
+	}
+
+	device->axisOffset           = static_cast<int>( axes.size() );
+	device->buttonOffset         = buttonCount;
+	device->calibrationReadIndex = 0;
+	device->analysisReadIndex    = 0;
+
+	// Ajouter les axes et boutons du périphérique à la vue fusionnée
+	for( int j = 0; j < device->info.axisCount; ++j )
+	{
+		// Rôle, plage, zone morte et sens donnés par le profil
+		AxisProfile axisProfile = { AXIS_ROLE_NONE, -1.0f, 1.0f, 0.05f, false };
+		if( j < profile.axes.size() )
+		{
+			axisProfile = profile.axes[j];
+		}
+
+		const char* roleName = axisRoleName( axisProfile.role );
+		std::string axisName;
+		if( roleName )
+		{
+			axisName = primary ? roleName : device->info.name + ": " + roleName;
+		}
+		else
+		{
+			axisName = primary && profile.kind == DEVICE_KIND_WHEEL ? wheelAxisName( j ) : device->info.name + ": Axe " + std::to_string( j );
+		}
+
+		// Les pédales et le frein à main vont de 0 (repos) à 1
+		bool unipolar = axisProfile.role == AXIS_ROLE_THROTTLE || axisProfile.role == AXIS_ROLE_BRAKE ||
+						axisProfile.role == AXIS_ROLE_CLUTCH || axisProfile.role == AXIS_ROLE_HANDBRAKE;
+
+		axes.push_back( { axisName, 0.0f, axisProfile.min, axisProfile.max, axisProfile.deadzone, 0.0f, axisProfile.inverted, 1.0f, 1.0f, unipolar } );
+	}
+
+	// Réappliquer la calibration connue pour ce périphérique
+	auto saved = savedCalibrations.find( device->guid );
+	if( saved != savedCalibrations.end() && saved->second.size() == static_cast<size_t>( device->info.axisCount ) )
+	{
+		for( int j = 0; j < device->info.axisCount; ++j )
+		{
+			AxisInfo& axis  = axes[device->axisOffset + j];
+			axis.min        = saved->second[j].min;
+			axis.max        = saved->second[j].max;
+			axis.deadzone   = saved->second[j].deadzone;
+			axis.inverted   = saved->second[j].inverted;
+			axis.curve      = saved->second[j].curve;
+			axis.saturation = saved->second[j].saturation;
+		}
+		logger.log( Logger::INFO, "Calibration restaurée pour " + device->info.name );
+	}
+
+	// La vue fusionnée est limitée à MAX_BUTTONS boutons
+	if( buttonCount + device->info.buttonCount > MAX_BUTTONS )
+	{
+		logger.log( Logger::WARNING, "Trop de boutons: seuls les " + std::to_string( MAX_BUTTONS - buttonCount ) + " premiers de " + device->info.name + " sont suivis" );
+		device->info.buttonCount = MAX_BUTTONS - buttonCount;
+	}
+	buttonCount += device->info.buttonCount;
+	calibrators.resize( axes.size() );
+	signalAnalyzers.resize( axes.size() );
+	axisHistories.resize( axes.size() );
+	layoutVersion++;
+
+	if( primary )
+	{
+		logger.log( Logger::INFO, "Périphérique principal: " + device->info.name + " (profil " + profile.name + ")" );
+		wheelInfo = device->info;
+
+		// Initialiser le retour de force avec les effets autorisés par le profil
+		if( wheelInfo.hasForceFeeback )
+		{
+			forceManager.initialize( joystick, profile.ffbEffects, logger );
+		}
+	}
+	else
+	{
+		logger.log( Logger::INFO, "Périphérique ajouté: " + device->info.name + " (profil " + profile.name + ")" );
+	}
+
+	// Chaque périphérique a son propre thread d'échantillonnage haute fréquence
+	if( device->sampler.start( joystick, device->info.axisCount, nullptr, steeringAxis( profile ) ) != SUCCESS )
+	{
+		logger.log( Logger::WARNING, "Impossible de démarrer l'échantillonnage haute fréquence de " + device->info.name );
+	}
+
+	devices.push_back( std::move( device ) );
+	return true;
+}
+
+InputDevice* DeviceManager::findDevice( SDL_JoystickID instanceId )
+{
+	for( auto& device : devices )
+	{
+		if( device->joystick && device->instanceId == instanceId )
+		{
+			return device.get();
+		}
+	}
+
+	return nullptr;
+}
+
+void DeviceManager::saveCalibration( const InputDevice& device )
+{
+	if( device.info.axisCount <= 0 || device.axisOffset + device.info.axisCount > axes.size() )
+	{
+		return;
+	}
+
+	auto first                     = axes.begin() + device.axisOffset;
+	savedCalibrations[device.guid] = std::vector<AxisInfo>( first, first + device.info.axisCount );
+}
+
+void DeviceManager::handleHotplug( RecordingManager& recorder, Logger& logger )
+{
+	std::vector<SDL_JoyDeviceEvent> events;
+	events.swap( hotplugEvents );
+
+	for( const auto& event : events )
+	{
+		if( event.type == SDL_JOYDEVICEREMOVED )
+		{
+			// which = identifiant d'instance
+			for( size_t i = 0; i < devices.size(); ++i )
+			{
+				if( devices[i]->joystick && devices[i]->instanceId == event.which )
+				{
+					disconnectDevice( i, recorder, logger );
+				}
+			}
+			continue;
+		}
+
+		// which = indice du périphérique; SDL annonce aussi les périphériques présents au démarrage
+		int                  index   = event.which;
+		const DeviceProfile* profile = findProfile( index );
+		if( !profile || findDevice( SDL_JoystickGetDeviceInstanceID( index ) ) )
+		{
+			continue;
+		}
+
+		// Un périphérique débranché de même GUID reprend sa place dans la vue fusionnée
+		std::string guid    = guidToString( SDL_JoystickGetDeviceGUID( index ) );
+		size_t      missing = devices.size();
+		for( size_t i = 0; i < devices.size() && missing == devices.size(); ++i )
+		{
+			if( !devices[i]->joystick && devices[i]->guid == guid )
+			{
+				missing = i;
+			}
+		}
+
+		if( missing < devices.size() )
+		{
+			// SDL_JoystickOpen doit être appelé depuis le thread principal, comme la boucle d'événements
+			SDL_Joystick* joystick = SDL_JoystickOpen( index );
+			if( joystick )
+			{
+				reattachDevice( missing, joystick, recorder, logger );
+			}
+			else
+			{
+				logger.log( Logger::WARNING, "Impossible de rouvrir " + devices[missing]->info.name + ": " + SDL_GetError() );
+			}
+		}
+		else if( usingDemo )
+		{
+			// Sans volant, un pédalier branché seul ne fait pas quitter le mode démo
+			if( !isWheelProfile( *profile ) )
+			{
+				continue;
+			}
+
+			logger.log( Logger::INFO, "Nouveau volant branché, sortie du mode démo" );
+			initialize( logger );
+			return;
+		}
+		else if( !recorder.getIsRecording() )
+		{
+			openDevice( index, *profile, false, logger );
+			syncInputs();
+		}
+		else
+		{
+			// Ajouter des canaux changerait la structure de l'enregistrement en cours
+			logger.log( Logger::WARNING, "Nouveau périphérique ignoré pendant l'enregistrement" );
+		}
+	}
+}
+
+void DeviceManager::disconnectDevice( size_t deviceIndex, RecordingManager& recorder, Logger& logger )
+{
+	InputDevice& device = *devices[deviceIndex];
+
+	saveCalibration( device );
+	device.sampler.stop();
+
+	// Le retour de force appartient au périphérique principal
+	if( deviceIndex == 0 )
+	{
+		forceManager.cleanup();
+	}
+
+	SDL_JoystickClose( device.joystick );
+	device.joystick   = nullptr;
+	device.instanceId = -1;
+
+	// Relâcher les boutons: aucun événement de relâchement n'arrivera
+	for( int i = 0; i < device.info.buttonCount; ++i )
+	{
+		buttons.set( device.buttonOffset + i, false );
+	}
+
+	// Les calibrations en cours sur ce périphérique sont interrompues
+	for( int i = 0; i < device.info.axisCount; ++i )
+	{
+		calibrators[device.axisOffset + i].cancel();
+	}
+
+	// La capture continue; le trou est marqué dans l'enregistrement, le périphérique sera rouvert à son rebranchement
+	recorder.addMarker( INPUT_EVENT_DISCONNECTED, static_cast<Uint8>( deviceIndex ) );
+	logger.log( Logger::WARNING, "Périphérique débranché: " + device.info.name + ", reconnexion en attente" );
+}
+
+void DeviceManager::reattachDevice( size_t deviceIndex, SDL_Joystick* joystick, RecordingManager& recorder, Logger& logger )
+{
+	InputDevice& device = *devices[deviceIndex];
+
+	// Même GUID: mêmes axes et boutons, la calibration de la vue fusionnée est toujours en place
+	device.joystick   = joystick;
+	device.instanceId = SDL_JoystickInstanceID( joystick );
+	syncInputs();
+
+	// Recréer les effets avec leurs réglages courants; update() relance ceux qui sont actifs
+	if( deviceIndex == 0 && device.info.hasForceFeeback )
+	{
+		forceManager.initialize( joystick, device.profile.ffbEffects, logger );
+	}
+
+	if( device.sampler.start( joystick, device.info.axisCount, nullptr, steeringAxis( device.profile ) ) != SUCCESS )
+	{
+		logger.log( Logger::WARNING, "Impossible de redémarrer l'échantillonnage haute fréquence de " + device.info.name );
+	}
+
+	recorder.addMarker( INPUT_EVENT_RECONNECTED, static_cast<Uint8>( deviceIndex ) );
+	logger.log( Logger::INFO, "Périphérique reconnecté: " + device.info.name );
+}
+
+ResultCode DeviceManager::startDemoMode( Logger& logger )
+{
+	usingDemo = true;
+
+	// Le volant simulé reçoit les commandes de force et alimente l'axe de direction échantillonné
+	simulatedWheel.reset();
+	forceManager.setSimulatedWheel( &simulatedWheel );
+	forceManager.setInputSource( &demoSampler );
+	if( demoSampler.start( nullptr, 1, &simulatedWheel ) != SUCCESS )
+	{
+		logger.log( Logger::WARNING, "Impossible de démarrer le volant simulé" );
+	}
+
+	return SUCCESS;
+}
+
+void DeviceManager::processEvent( const SDL_Event& event )
+{
+	// Branchements traités pendant la frame, y compris en mode démo
+	if( event.type == SDL_JOYDEVICEADDED || event.type == SDL_JOYDEVICEREMOVED )
+	{
+		hotplugEvents.push_back( event.jdevice );
+		return;
+	}
+
+	if( usingDemo || devices.empty() )
+	{
+		return;
+	}
+
+	// Indice dans la vue fusionnée; les événements sont horodatés par SDL sur une horloge commune
+	InputDevice* device = nullptr;
+	int          index  = 0;
+
+	switch( event.type )
+	{
+		case SDL_JOYAXISMOTION:
+			device = findDevice( event.jaxis.which );
+			if( device && event.jaxis.axis < device->info.axisCount )
+			{
+				index = device->axisOffset + event.jaxis.axis;
+				if( index <= UINT8_MAX )
+				{
+					pendingEvents.push_back( { event.jaxis.timestamp / 1000.0, INPUT_EVENT_AXIS, static_cast<Uint8>( index ), event.jaxis.value } );
+				}
+			}
+			break;
+
+		case SDL_JOYBUTTONDOWN:
+		case SDL_JOYBUTTONUP:
+			device = findDevice( event.jbutton.which );
+			if( device && event.jbutton.button < device->info.buttonCount )
+			{
+				index          = device->buttonOffset + event.jbutton.button;
+				Sint16 pressed = event.jbutton.state == SDL_PRESSED ? 1 : 0;
+				if( index <= UINT8_MAX )
+				{
+					pendingEvents.push_back( { event.jbutton.timestamp / 1000.0, INPUT_EVENT_BUTTON, static_cast<Uint8>( index ), pressed } );
+				}
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+void DeviceManager::syncInputs()
+{
+	refreshResponseTables();
+
+	for( const auto& device : devices )
+	{
+		if( !device->joystick )
+		{
+			continue;
+		}
+
+		for( int i = 0; i < device->info.axisCount; ++i )
+		{
+			applyAxis( device->axisOffset + i, SDL_JoystickGetAxis( device->joystick, i ) );
+		}
+
+		for( int i = 0; i < device->info.buttonCount; ++i )
+		{
+			buttons.set( device->buttonOffset + i, SDL_JoystickGetButton( device->joystick, i ) == 1 );
+		}
+	}
+}
+
+// Transformation complète d'une valeur brute orientée (-1..1): calibration, zone morte, courbe, saturation
+static float computeAxisResponse( const AxisInfo& axis, float x )
+{
+	float range = std::max( 1e-6f, axis.max - axis.min );
+	float t     = ( x - axis.min ) / range; // 0..1 sur la course calibrée
+	t           = std::max( 0.0f, std::min( 1.0f, t ) );
+
+	// Les axes centrés travaillent sur l'amplitude de part et d'autre du centre
+	float sign = 1.0f;
+	if( !axis.unipolar )
+	{
+		t    = t * 2.0f - 1.0f;
+		sign = t < 0.0f ? -1.0f : 1.0f;
+		t    = fabs( t );
+	}
+
+	// Zone morte autour du centre, ou au repos pour une pédale
+	if( t < axis.deadzone )
+	{
+		return 0.0f;
+	}
+	t = ( t - axis.deadzone ) / std::max( 1e-6f, 1.0f - axis.deadzone );
+
+	t = powf( t, std::max( 0.05f, axis.curve ) );
+	t = std::min( 1.0f, t / std::max( 0.05f, axis.saturation ) );
+
+	return sign * t;
+}
+
+void buildAxisResponseTable( const AxisInfo& axis, AxisResponseTable& table )
+{
+	// 65536 entrées: le coût de la courbe n'est payé qu'à la modification des réglages
+	table.settings = axis;
+	table.values.resize( 65536 );
+	for( int raw = SDL_MIN_SINT16; raw <= SDL_MAX_SINT16; ++raw )
+	{
+		float x = std::max( -1.0f, raw / 32767.0f );
+		if( axis.inverted )
+		{
+			x = -x;
+		}
+		table.values[raw - SDL_MIN_SINT16] = computeAxisResponse( axis, x );
+	}
+}
+
+void applyAxisResponse( AxisInfo& axis, AxisResponseTable& table, Sint16 raw )
+{
+	float x       = std::max( -1.0f, raw / 32767.0f );
+	axis.rawValue = axis.inverted ? -x : x;
+	table.lastRaw = raw;
+	axis.value    = table.values[raw - SDL_MIN_SINT16];
+}
+
+static bool sameResponseSettings( const AxisInfo& a, const AxisInfo& b )
+{
+	return a.min == b.min && a.max == b.max && a.deadzone == b.deadzone && a.inverted == b.inverted &&
+		   a.curve == b.curve && a.saturation == b.saturation && a.unipolar == b.unipolar;
+}
+
+void DeviceManager::refreshResponseTables()
 {
-	// Différents patterns selon le groupe de boutons
-	if( buttonIndex < 6 )
+	if( responseTables.size() != axes.size() )
 	{
-		// Groupe 1: séquence
-		int cycle = static_cast<int>( time * 2.0f ) % 6;
-		return buttonIndex == cycle;
+		responseTables.clear();
+		responseTables.resize( axes.size() );
+		for( auto& table : responseTables )
+		{
+			table.lastRaw = 0;
+		}
+	}
+
+	for( size_t i = 0; i < axes.size(); ++i )
+	{
+		AxisResponseTable& table = responseTables[i];
+		if( !table.values.empty() && sameResponseSettings( table.settings, axes[i] ) )
+		{
+			continue;
+		}
+
+		buildAxisResponseTable( axes[i], table );
+
+		// La valeur affichée suit immédiatement les nouveaux réglages
+		applyAxis( static_cast<int>( i ), table.lastRaw );
+	}
+}
+
+void DeviceManager::applyAxis( int axisIndex, Sint16 raw )
+{
+	applyAxisResponse( axes[axisIndex], responseTables[axisIndex], raw );
+}
+
+void DeviceManager::updateInputs( RecordingManager& recorder, AutoTestManager& autoTest, Logger& logger )
+{
+	// Les transitions de la frame précédente ne sont plus valides
+	frameEvents.clear();
+
+	handleHotplug( recorder, logger );
+
+	if( !usingDemo && !devices.empty() )
+	{
+		// Appliquer uniquement les transitions reçues: le coût dépend de l'activité, pas du nombre de canaux
+		refreshResponseTables();
+		frameEvents.swap( pendingEvents );
+		buttonTaps.clear();
+
+		for( const auto& event : frameEvents )
+		{
+			if( event.type == INPUT_EVENT_AXIS )
+			{
+				if( event.index < axes.size() )
+				{
+					applyAxis( event.index, event.value );
+				}
+			}
+			else if( event.index < buttonCount )
+			{
+				buttons.set( event.index, event.value != 0 );
+				if( event.value )
+				{
+					buttonTaps.set( event.index, true );
+				}
+			}
+
+			recorder.addEvent( event );
+		}
+
+		updateCalibrations();
+
+		// Mettre à jour le retour de force
+		forceManager.update( logger );
+	}
+	else if( autoTest.isTestRunning() )
+	{
+		// Mode test automatique
+		autoTest.update( axes, buttons, buttonCount, forceManager.getEffects() );
+	}
+	else
+	{
+		// Mode démo - animation des axes (horloge SDL, indépendante du rendu)
+		float time = SDL_GetTicks() / 1000.0f;
+
+		// Animation des axes
+		if( !axes.empty() )
+			axes[0].value = sinf( time ) * 0.8f; // Volant
+		if( axes.size() > 1 )
+			axes[1].value = ( sinf( time * 0.7f ) + 1.0f ) * 0.5f; // Accélérateur
+		if( axes.size() > 2 )
+			axes[2].value = ( cosf( time * 0.5f ) + 1.0f ) * 0.5f; // Frein
+
+		// Mettre à jour les valeurs brutes
+		for( auto& axis : axes )
+		{
+			axis.rawValue = axis.value;
+		}
+
+		// Animation des boutons
+		static float lastToggleTime = 0.0f;
+		float        currentTime    = time;
+		if( currentTime - lastToggleTime > 1.0f )
+		{
+			int randomButton = rand() % buttonCount;
+			buttons.set( randomButton, !buttons.test( randomButton ) );
+			lastToggleTime = currentTime;
+		}
+	}
+
+	updateSignalAnalysis();
+
+	// Sans périphérique réel (démo, test automatique), les transitions de boutons sont les fronts de la frame,
+	// obtenus par XOR avec l'état précédent, mot par mot
+	if( usingDemo || devices.empty() )
+	{
+		ButtonBits pressed  = ButtonBits::pressedEdges( previousButtons, buttons );
+		ButtonBits released = ButtonBits::releasedEdges( previousButtons, buttons );
+		double     now      = SDL_GetTicks() / 1000.0;
+		for( int i = pressed.findNext( 0 ); i >= 0; i = pressed.findNext( i + 1 ) )
+		{
+			frameEvents.push_back( { now, INPUT_EVENT_BUTTON, static_cast<Uint8>( i ), 1 } );
+		}
+		for( int i = released.findNext( 0 ); i >= 0; i = released.findNext( i + 1 ) )
+		{
+			frameEvents.push_back( { now, INPUT_EVENT_BUTTON, static_cast<Uint8>( i ), 0 } );
+		}
+	}
+
+	previousButtons = buttons;
+
+	// Enregistrer les entrées si l'enregistrement est actif
+	if( recorder.getIsRecording() )
+	{
+		recorder.addSnapshot( axes, buttons, buttonCount );
+	}
+}
+
+ResultCode DeviceManager::reloadDevice( Logger& logger )
+{
+	return initialize( logger );
+}
+
+WheelInfo& DeviceManager::getWheelInfo()
+{
+	return wheelInfo;
+}
+
+std::vector<AxisInfo>& DeviceManager::getAxes()
+{
+	return axes;
+}
+
+ButtonBits& DeviceManager::getButtons()
+{
+	return buttons;
+}
+
+const ButtonBits& DeviceManager::getButtonTaps() const
+{
+	return buttonTaps;
+}
+
+int DeviceManager::getButtonCount() const
+{
+	return buttonCount;
+}
+
+const std::vector<InputEvent>& DeviceManager::getFrameEvents() const
+{
+	return frameEvents;
+}
+
+ForceManager& DeviceManager::getForceManager()
+{
+	return forceManager;
+}
+
+InputSampler& DeviceManager::getSampler()
+{
+	// Le périphérique principal porte le volant mesuré
+	if( usingDemo || devices.empty() )
+	{
+		return demoSampler;
+	}
+
+	return devices.front()->sampler;
+}
+
+SimulatedWheel& DeviceManager::getSimulatedWheel()
+{
+	return simulatedWheel;
+}
+
+Uint32 DeviceManager::getLayoutVersion() const
+{
+	return layoutVersion;
+}
+
+bool DeviceManager::isUsingDemo() const
+{
+	return usingDemo;
+}
+
+const std::vector<std::unique_ptr<InputDevice>>& DeviceManager::getDevices() const
+{
+	return devices;
+}
+
+InputDevice* DeviceManager::findAxisDevice( int axisIndex, int& outLocalIndex )
+{
+	for( auto& device : devices )
+	{
+		if( axisIndex >= device->axisOffset && axisIndex < device->axisOffset + device->info.axisCount )
+		{
+			outLocalIndex = axisIndex - device->axisOffset;
+			return device.get();
+		}
+	}
+
+	return nullptr;
+}
+
+void DeviceManager::updateCalibrations()
+{
+	if( !isCalibrating() )
+	{
+		return;
+	}
+
+	// Axes échantillonnés à haute fréquence: tous les échantillons depuis la frame précédente
+	for( auto& device : devices )
+	{
+		if( !device->joystick )
+		{
+			continue;
+		}
+
+		int sampledAxes = std::min( device->info.axisCount, MAX_SAMPLED_AXES );
+		device->sampler.readSince( device->calibrationReadIndex, calibrationSamples );
+		for( const auto& sample : calibrationSamples )
+		{
+			for( int j = 0; j < sampledAxes; ++j )
+			{
+				calibrators[device->axisOffset + j].addSample( sample.axes[j], sample.timestamp );
+			}
+		}
+	}
+
+	// Axes au-delà de MAX_SAMPLED_AXES: transitions reçues pendant la frame
+	Uint64 now = SDL_GetPerformanceCounter();
+	for( const auto& event : frameEvents )
+	{
+		int localIndex = 0;
+		if( event.type == INPUT_EVENT_AXIS && findAxisDevice( event.index, localIndex ) && localIndex >= MAX_SAMPLED_AXES )
+		{
+			calibrators[event.index].addSample( event.value, now );
+		}
+	}
+}
+
+void DeviceManager::updateSignalAnalysis()
+{
+	Uint64 now = SDL_GetPerformanceCounter();
+
+	// Mode démo: seul le volant simulé est échantillonné
+	if( usingDemo )
+	{
+		demoSampler.readSince( demoAnalysisReadIndex, analysisSamples );
+		if( !signalAnalyzers.empty() )
+		{
+			for( const auto& sample : analysisSamples )
+			{
+				signalAnalyzers[0].addSample( sample.axes[0] );
+			}
+		}
+
+		// Axes animés (ou pilotés par le test automatique) une fois par mise à jour
+		for( size_t i = 0; i < axisHistories.size() && i < axes.size(); ++i )
+		{
+			axisHistories[i].addSample( now, axes[i].value );
+		}
+		return;
+	}
+
+	// Axes échantillonnés à haute fréquence: tous les échantillons bruts depuis la frame précédente
+	for( auto& device : devices )
+	{
+		if( !device->joystick )
+		{
+			continue;
+		}
+
+		int sampledAxes = std::min( device->info.axisCount, MAX_SAMPLED_AXES );
+		device->sampler.readSince( device->analysisReadIndex, analysisSamples );
+		for( const auto& sample : analysisSamples )
+		{
+			for( int j = 0; j < sampledAxes; ++j )
+			{
+				int axisIndex = device->axisOffset + j;
+				signalAnalyzers[axisIndex].addSample( sample.axes[j] );
+
+				// L'historique suit la valeur affichée (réglages de l'axe appliqués)
+				const AxisResponseTable& table = responseTables[axisIndex];
+				if( !table.values.empty() )
+				{
+					axisHistories[axisIndex].addSample( sample.timestamp, table.values[sample.axes[j] - SDL_MIN_SINT16] );
+				}
+			}
+		}
+	}
+
+	// Axes au-delà de MAX_SAMPLED_AXES: transitions reçues pendant la frame
+	for( const auto& event : frameEvents )
+	{
+		int localIndex = 0;
+		if( event.type == INPUT_EVENT_AXIS && findAxisDevice( event.index, localIndex ) && localIndex >= MAX_SAMPLED_AXES )
+		{
+			signalAnalyzers[event.index].addSample( event.value );
+
+			const AxisResponseTable& table = responseTables[event.index];
+			if( !table.values.empty() )
+			{
+				axisHistories[event.index].addSample( now, table.values[event.value - SDL_MIN_SINT16] );
+			}
+		}
+	}
+}
+
+InputSampler* DeviceManager::getAxisSampler( int axisIndex, int& outLane )
+{
+	// Mode démo: seul le volant simulé est échantillonné
+	if( usingDemo )
+	{
+		outLane = 0;
+		return axisIndex == 0 ? &demoSampler : nullptr;
+	}
+
+	InputDevice* device = findAxisDevice( axisIndex, outLane );
+	if( !device || !device->joystick || outLane >= MAX_SAMPLED_AXES )
+	{
+		return nullptr;
+	}
+
+	return &device->sampler;
+}
+
+const AxisHistory* DeviceManager::getAxisHistory( int axisIndex ) const
+{
+	if( axisIndex < 0 || axisIndex >= axisHistories.size() )
+	{
+		return nullptr;
+	}
+
+	return &axisHistories[axisIndex];
+}
+
+AxisSignalAnalyzer* DeviceManager::getSignalAnalyzer( int axisIndex )
+{
+	if( axisIndex < 0 || axisIndex >= signalAnalyzers.size() )
+	{
+		return nullptr;
+	}
+
+	return &signalAnalyzers[axisIndex];
+}
+
+void DeviceManager::resetSignalAnalysis()
+{
+	for( auto& analyzer : signalAnalyzers )
+	{
+		analyzer.reset();
+	}
+}
+
+ResultCode DeviceManager::exportSignalAnalysis( const std::string& filename ) const
+{
+	std::ofstream file( filename );
+	if( !file.is_open() )
+	{
+		return ERROR_FILE_OPEN_FAILED;
+	}
+
+	file << "axis,samples,mean,std_dev,raw_min,raw_max,distinct_values,effective_bits,quantization_step,resolution_bits,max_step,spikes,spike_threshold,jitter\n";
+	file << std::fixed << std::setprecision( 3 );
+	for( size_t i = 0; i < signalAnalyzers.size() && i < axes.size(); ++i )
+	{
+		AxisSignalStats stats = signalAnalyzers[i].getStats();
+		file << "\"" << axes[i].name << "\"," << stats.sampleCount << "," << stats.mean << "," << stats.stdDev << ","
+			 << stats.rawMin << "," << stats.rawMax << "," << stats.distinctValues << "," << stats.effectiveBits << ","
+			 << stats.quantizationStep << "," << stats.resolutionBits << "," << stats.maxStep << "," << stats.spikeCount << ","
+			 << signalAnalyzers[i].getSpikeThreshold() << "," << stats.jitter << "\n";
+	}
+
+	return file.good() ? SUCCESS : ERROR_FILE_WRITE_FAILED;
+}
+
+void DeviceManager::calibrateAxis( int axisIndex, Logger& logger )
+{
+	if( axisIndex < 0 || axisIndex >= axes.size() )
+	{
+		logger.log( Logger::ERROR, "Index d'axe invalide pour la calibration" );
+		return;
+	}
+
+	if( usingDemo )
+	{
+		logger.log( Logger::WARNING, "Mode démo: calibration simulée" );
+		return;
 	}
-	else if( buttonIndex < 12 )
+
+	int          localIndex = 0;
+	InputDevice* device     = findAxisDevice( axisIndex, localIndex );
+	if( !device || !device->joystick )
 	{
-		// Groupe 2: alternance
-		return fmodf( time + buttonIndex * 0.7f, 2.0f ) < 1.0f;
+		logger.log( Logger::WARNING, "Calibration impossible: périphérique débranché" );
+		return;
 	}
-	else if( buttonIndex < 18 )
+
+	// Reprendre la lecture au présent si aucune autre calibration ne lit ce périphérique
+	bool deviceActive = false;
+	for( int j = 0; j < device->info.axisCount; ++j )
 	{
-		// Groupe 3: courts appuis périodiques
-		return fmodf( time * 3.0f + buttonIndex, 10.0f ) < 0.3f;
+		deviceActive = deviceActive || calibrators[device->axisOffset + j].isActive();
 	}
-	else
+	if( !deviceActive )
 	{
-		// Groupe 4: longs appuis périodiques
-		return fmodf( time + buttonIndex * 0.5f, 5.0f ) < 2.5f;
+		device->calibrationReadIndex = device->sampler.getWriteIndex();
 	}
+
+	calibrators[axisIndex].start( SDL_GetPerformanceCounter() );
+	logger.log( Logger::INFO, "Calibration de l'axe " + axes[axisIndex].name + ": laissez l'axe au repos, puis déplacez-le sur toute sa course" );
 }
 
-void AutoTestManager::update( std::vector<AxisInfo>& axes, std::vector<bool>& buttons, std::vector<ForceEffect>& effects )
+void DeviceManager::finishCalibration( int axisIndex, Logger& logger )
 {
-	if( !isRunning )
+	if( axisIndex < 0 || axisIndex >= calibrators.size() || !calibrators[axisIndex].isActive() )
 	{
 		return;
 	}
 
-	float now   = ImGui::GetTime();
-	currentTime = now - startTime;
+	AxisCalibrator& calibrator = calibrators[axisIndex];
+	calibrator.finish();
 
-	// Vérifier si le test est terminé
-	if( currentTime >= duration )
+	if( calibrator.getSampleCount() == 0 )
 	{
-		isRunning = false;
+		logger.log( Logger::WARNING, "Calibration échouée: aucune donnée collectée" );
 		return;
 	}
 
-	// Mettre à jour les axes
-	if( testAxes )
-	{
-		for( size_t i = 0; i < axes.size(); ++i )
-		{
-			if( i < axes.size() )
-			{
-				axes[i].value = getAxisValue( i, currentTime );
-			}
-		}
-	}
-
-	// Mettre à jour les boutons
-	if( testButtons )
+	// Extrêmes dans le repère de la valeur affichée, avec une marge de trois écarts types de bruit
+	AxisInfo& axis   = axes[axisIndex];
+	float     margin = std::max( 0.005f, 3.0f * calibrator.getNoise() / 32767.0f );
+	float     low    = std::max( -1.0f, calibrator.getRawMin() / 32767.0f );
+	float     high   = calibrator.getRawMax() / 32767.0f;
+	if( axis.inverted )
 	{
-		for( size_t i = 0; i < buttons.size(); ++i )
-		{
-			if( i < buttons.size() )
-			{
-				buttons[i] = getButtonState( i, currentTime );
-			}
-		}
+		std::swap( low, high );
+		low  = -low;
+		high = -high;
 	}
 
-	// Mettre à jour les effets de force
-	if( testFFB )
-	{
-		// Cycle à travers les différents effets
-		size_t effectIndex = static_cast<size_t>( floorf( currentTime / 2.0f ) ) % effects.size();
-
-		// Désactiver tous les effets
-		for( auto& effect : effects )
-		{
-			effect.enabled = false;
-		}
+	axis.min = low - margin;
+	axis.max = high + margin;
 
-		// Activer l'effet courant
-		if( effectIndex < effects.size() )
-		{
-			effects[effectIndex].enabled = true;
-			// Moduler la force (0-100%)
-			effects[effectIndex].strength = fabs( sinf( currentTime * 2.0f ) ) * 100.0f;
-		}
-	}
+	logger.log( Logger::INFO, "Calibration terminée: min=" + std::to_string( axis.min ) + ", max=" + std::to_string( axis.max ) +
+								  ", centre=" + std::to_string( calibrator.getCenter() / 32767.0f ) +
+								  ", bruit=" + std::to_string( calibrator.getNoise() ) + " (" + std::to_string( calibrator.getSampleCount() ) + " échantillons)" );
 }
 
-void AutoTestManager::setTestOptions( bool buttons, bool axes, bool ffb, float testDuration )
+void DeviceManager::cancelCalibration( int axisIndex )
 {
-	testButtons = buttons;
-	testAxes    = axes;
-	testFFB     = ffb;
-	duration    = testDuration;
+	if( axisIndex >= 0 && axisIndex < calibrators.size() )
+	{
+		calibrators[axisIndex].cancel();
+	}
 }
 
-bool AutoTestManager::getTestButtons() const
+bool DeviceManager::isCalibrating() const
 {
-	return testButtons;
+	return std::any_of( calibrators.begin(), calibrators.end(), []( const AxisCalibrator& c ) { return c.isActive(); } );
 }
 
-bool AutoTestManager::getTestAxes() const
+const AxisCalibrator* DeviceManager::getCalibrator( int axisIndex ) const
 {
-	return testAxes;
-}
+	if( axisIndex < 0 || axisIndex >= calibrators.size() )
+	{
+		return nullptr;
+	}
 
-bool AutoTestManager::getTestFFB() const
-{
-	return testFFB;
+	return &calibrators[axisIndex];
 }
 
 // =============================================================================
-// IMPLÉMENTATION DE LA CLASSE FORCEMANAGER
+// IMPLÉMENTATION DE LA CLASSE LATENCYTESTER
 // =============================================================================
 
-ForceManager::ForceManager() : ffbEnabled( true ), masterStrength( 100.0f ), haptic( nullptr )
-{
-	// Initialiser les effets par défaut
-	effects = {
-		{ "Constant", false, 50.0f, 1.0f, -1 },
-		{ "Ressort", false, 70.0f, 0.0f, -1 },
-		{ "Amortissement", false, 60.0f, 0.0f, -1 },
-		{ "Friction", false, 40.0f, 0.0f, -1 },
-		{ "Sinusoïdal", false, 30.0f, 2.0f, -1 },
-		{ "Dent de scie", false, 50.0f, 1.5f, -1 },
-		{ "Rumbble", false, 80.0f, 0.5f, -1 },
-		{ "Choc", false, 100.0f, 0.2f, -1 }
-	};
-}
-
-ForceManager::~ForceManager()
+LatencyTester::LatencyTester() : state( IDLE ), iterations( 0 ), completed( 0 ), timeouts( 0 ), stepLevel( 0.5f ),
+								 threshold( 0.02f ), timeoutMs( 1000.0f ), settleMs( 400.0f ), direction( 1.0f ),
+								 stateStart( 0 ), stepTimestamp( 0 ), readIndex( 0 ), baseline( 0 )
 {
-	cleanup();
+	memset( &stats, 0, sizeof( LatencyStats ) );
 }
 
-void ForceManager::cleanup()
+ResultCode LatencyTester::start( int count, float level, float motionThreshold, InputSampler& sampler, Logger& logger )
 {
-	if( haptic )
+	if( count <= 0 || level <= 0.0f || motionThreshold <= 0.0f )
 	{
-		// Désactiver tous les effets
-		for( auto& effect : effects )
-		{
-			if( effect.effectId >= 0 )
-			{
-				SDL_HapticDestroyEffect( haptic, effect.effectId );
-				effect.effectId = -1;
-			}
-		}
+		return ERROR_INVALID_PARAMETER;
+	}
 
-		SDL_HapticClose( haptic );
-		haptic = nullptr;
+	if( !sampler.isRunning() )
+	{
+		logger.log( Logger::ERROR, "Mesure de latence impossible: échantillonnage inactif" );
+		return ERROR_JOYSTICK_NOT_FOUND;
 	}
+
+	iterations = count;
+	completed  = 0;
+	timeouts   = 0;
+	stepLevel  = std::min( 1.0f, level );
+	threshold  = motionThreshold;
+	direction  = 1.0f;
+	readIndex  = sampler.getWriteIndex();
+	stateStart = SDL_GetPerformanceCounter();
+	state      = SETTLING;
+
+	latencies.clear();
+	latencies.reserve( count );
+	memset( &stats, 0, sizeof( LatencyStats ) );
+
+	logger.log( Logger::INFO, "Mesure de latence démarrée (" + std::to_string( count ) + " répétitions)" );
+	return SUCCESS;
 }
 
-ResultCode ForceManager::initialize( SDL_Joystick* joystick, Logger& logger )
+void LatencyTester::stop( ForceManager& forceManager, Logger& logger )
 {
-	cleanup();
-
-	if( !joystick )
+	if( state == WAITING_MOTION )
 	{
-		logger.log( Logger::ERROR, "Impossible d'initialiser le retour de force: joystick invalide" );
-		return ERROR_JOYSTICK_NOT_FOUND;
+		forceManager.stopConstantStep();
 	}
 
-	// Vérifier si le joystick supporte le haptic
-	if( !SDL_JoystickIsHaptic( joystick ) )
+	if( state != IDLE && state != DONE )
 	{
-		logger.log( Logger::WARNING, "Le joystick ne supporte pas le retour de force" );
-		return ERROR_JOYSTICK_NOT_FOUND;
+		logger.log( Logger::INFO, "Mesure de latence interrompue" );
+		computeStats();
+		state = latencies.empty() ? IDLE : DONE;
 	}
+}
 
-	// Ouvrir le dispositif haptic
-	haptic = SDL_HapticOpenFromJoystick( joystick );
-	if( !haptic )
+void LatencyTester::update( InputSampler& sampler, ForceManager& forceManager, Logger& logger )
+{
+	if( state == IDLE || state == DONE )
 	{
-		logger.log( Logger::ERROR, "Impossible d'ouvrir le dispositif haptic: " + std::string( SDL_GetError() ) );
-		return ERROR_JOYSTICK_NOT_FOUND;
+		return;
 	}
 
-	// Vérifier les capacités
-	unsigned int supportedEffects = SDL_HapticQuery( haptic );
+	if( !sampler.isRunning() )
+	{
+		logger.log( Logger::WARNING, "Échantillonnage arrêté pendant la mesure de latence" );
+		stop( forceManager, logger );
+		return;
+	}
 
-	logger.log( Logger::INFO, "Initialisation du retour de force réussie" );
-	logger.log( Logger::DEBUG, "Effets supportés: " + std::to_string( supportedEffects ) );
+	sampler.readSince( readIndex, pendingSamples );
+	Uint64 now = SDL_GetPerformanceCounter();
 
-	// Initialiser les effets supportés
-	if( supportedEffects & SDL_HAPTIC_CONSTANT )
+	switch( state )
 	{
-		initConstantEffect( 0 );
-		logger.log( Logger::DEBUG, "Effet constant initialisé" );
+		case SETTLING:
+		{
+			// Attendre que le volant soit revenu au repos avant l'échelon suivant
+			RawInputSample latest;
+			if( performanceCounterToMs( now - stateStart ) < settleMs || !sampler.getLatest( latest ) )
+			{
+				break;
+			}
+
+			baseline = latest.axes[sampler.getSteeringLane()];
+			if( forceManager.startConstantStep( direction * stepLevel, stepTimestamp, logger ) != SUCCESS )
+			{
+				stop( forceManager, logger );
+				break;
+			}
+
+			state = WAITING_MOTION;
+			break;
+		}
+
+		case WAITING_MOTION:
+		{
+			// Premier échantillon postérieur à l'échelon qui dépasse le seuil de mouvement
+			const int thresholdRaw = static_cast<int>( threshold * 32767.0f );
+			const int lane         = sampler.getSteeringLane();
+			bool      detected     = false;
+
+			for( const auto& sample : pendingSamples )
+			{
+				if( sample.timestamp >= stepTimestamp && abs( sample.axes[lane] - baseline ) >= thresholdRaw )
+				{
+					latencies.push_back( performanceCounterToMs( sample.timestamp - stepTimestamp ) );
+					detected = true;
+					break;
+				}
+			}
+
+			if( !detected && performanceCounterToMs( now - stepTimestamp ) < timeoutMs )
+			{
+				break;
+			}
+
+			if( !detected )
+			{
+				timeouts++;
+				logger.log( Logger::WARNING, "Mesure de latence: aucun mouvement détecté après " + std::to_string( static_cast<int>( timeoutMs ) ) + " ms" );
+			}
+
+			forceManager.stopConstantStep();
+			completed++;
+			direction = -direction;
+
+			if( completed >= iterations )
+			{
+				computeStats();
+				state = DONE;
+				logger.log( Logger::INFO, "Mesure de latence terminée: médiane " + std::to_string( stats.medianMs ) + " ms, p99 " + std::to_string( stats.p99Ms ) + " ms" );
+			}
+			else
+			{
+				state      = SETTLING;
+				stateStart = now;
+			}
+			break;
+		}
+
+		default:
+			break;
 	}
+}
+
+void LatencyTester::computeStats()
+{
+	stats.count    = static_cast<int>( latencies.size() );
+	stats.timeouts = timeouts;
 
-	if( supportedEffects & SDL_HAPTIC_SPRING )
+	if( latencies.empty() )
 	{
-		initSpringEffect( 1 );
-		logger.log( Logger::DEBUG, "Effet ressort initialisé" );
+		return;
 	}
 
-	if( supportedEffects & SDL_HAPTIC_DAMPER )
+	std::vector<double> sorted = latencies;
+	std::sort( sorted.begin(), sorted.end() );
+
+	// Percentile par rang le plus proche
+	size_t p99Index = static_cast<size_t>( ceil( 0.99 * sorted.size() ) ) - 1;
+
+	stats.minMs    = sorted.front();
+	stats.medianMs = sorted.size() % 2 ? sorted[sorted.size() / 2] : ( sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2] ) * 0.5;
+	stats.p99Ms    = sorted[std::min( p99Index, sorted.size() - 1 )];
+	stats.maxMs    = sorted.back();
+}
+
+bool LatencyTester::isRunning() const
+{
+	return state != IDLE && state != DONE;
+}
+
+bool LatencyTester::hasResults() const
+{
+	return state == DONE;
+}
+
+int LatencyTester::getCompleted() const
+{
+	return completed;
+}
+
+int LatencyTester::getIterations() const
+{
+	return iterations;
+}
+
+const LatencyStats& LatencyTester::getStats() const
+{
+	return stats;
+}
+
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE REALFFT
+// =============================================================================
+
+RealFFT::RealFFT() : size( 0 )
+{
+}
+
+bool RealFFT::setSize( int fftSize )
+{
+	if( fftSize < 4 || ( fftSize & ( fftSize - 1 ) ) != 0 )
 	{
-		initDamperEffect( 2 );
-		logger.log( Logger::DEBUG, "Effet amortissement initialisé" );
+		return false;
 	}
 
-	if( supportedEffects & SDL_HAPTIC_FRICTION )
+	if( fftSize == size )
 	{
-		initFrictionEffect( 3 );
-		logger.log( Logger::DEBUG, "Effet friction initialisé" );
+		return true;
 	}
 
-	if( supportedEffects & SDL_HAPTIC_SINE )
+	size     = fftSize;
+	int half = size / 2;
+
+	// Permutation par inversion des bits des indices de la FFT complexe
+	int bits = 0;
+	while( ( 1 << bits ) < half )
 	{
-		initSineEffect( 4 );
-		logger.log( Logger::DEBUG, "Effet sinusoïdal initialisé" );
+		bits++;
 	}
 
-	if( supportedEffects & SDL_HAPTIC_SAWTOOTHUP )
+	bitReverse.resize( half );
+	for( int i = 0; i < half; ++i )
 	{
-		initSawtoothEffect( 5 );
-		logger.log( Logger::DEBUG, "Effet dent de scie initialisé" );
+		int reversed = 0;
+		for( int b = 0; b < bits; ++b )
+		{
+			reversed |= ( ( i >> b ) & 1 ) << ( bits - 1 - b );
+		}
+		bitReverse[i] = reversed;
 	}
 
-	if( supportedEffects & SDL_HAPTIC_LEFTRIGHT )
+	// Une seule table: les facteurs de la FFT de half points sont les termes pairs
+	twiddles.resize( half );
+	for( int k = 0; k < half; ++k )
 	{
-		initRumbleEffect( 6 );
-		logger.log( Logger::DEBUG, "Effet rumble initialisé" );
+		double angle = -2.0 * M_PI * k / size;
+		twiddles[k]  = std::complex<float>( static_cast<float>( cos( angle ) ), static_cast<float>( sin( angle ) ) );
 	}
 
-	return SUCCESS;
+	work.resize( half );
+	return true;
 }
 
-void ForceManager::initConstantEffect( int index )
+int RealFFT::getSize() const
 {
-	if( !haptic || index >= effects.size() )
-		return;
-
-	SDL_HapticEffect effect;
-	memset( &effect, 0, sizeof( SDL_HapticEffect ) );
-
-	effect.type                      = SDL_HAPTIC_CONSTANT;
-	effect.constant.direction.type   = SDL_HAPTIC_POLAR;
-	effect.constant.direction.dir[0] = 0;
-	effect.constant.length           = static_cast<Uint32>( effects[index].duration * 1000 );
-	effect.constant.level            = static_cast<Sint16>( 32767.0f * effects[index].strength / 100.0f );
-	effect.constant.attack_length    = 0;
-	effect.constant.fade_length      = 0;
+	return size;
+}
 
-	// Créer l'effet
-	if( effects[index].effectId >= 0 )
+void RealFFT::butterflies()
+{
+	int half = size / 2;
+	for( int length = 2; length <= half; length <<= 1 )
 	{
-		SDL_HapticDestroyEffect( haptic, effects[index].effectId );
+		int stride = size / length;
+		int middle = length / 2;
+		for( int start = 0; start < half; start += length )
+		{
+			for( int j = 0; j < middle; ++j )
+			{
+				std::complex<float> even = work[start + j];
+				std::complex<float> odd  = work[start + j + middle] * twiddles[j * stride];
+				work[start + j]          = even + odd;
+				work[start + j + middle] = even - odd;
+			}
+		}
 	}
-
-	effects[index].effectId = SDL_HapticNewEffect( haptic, &effect );
 }
 
-void ForceManager::initSpringEffect( int index )
+void RealFFT::forward( const float* input, std::vector<std::complex<float>>& output )
 {
-	if( !haptic || index >= effects.size() )
-		return;
-
-	SDL_HapticEffect effect;
-	memset( &effect, 0, sizeof( SDL_HapticEffect ) );
+	int half = size / 2;
 
-	effect.type                       = SDL_HAPTIC_SPRING;
-	effect.condition.direction.type   = SDL_HAPTIC_POLAR;
-	effect.condition.direction.dir[0] = 0;
-	effect.condition.length           = SDL_HAPTIC_INFINITY;
-
-	// Paramètres spécifiques à l'effet ressort
-	for( int i = 0; i < SDL_HapticNumAxes( haptic ) && i < 3; ++i )
+	// Échantillons pairs en partie réelle, impairs en partie imaginaire
+	for( int k = 0; k < half; ++k )
 	{
-		effect.condition.right_sat[i]   = static_cast<Uint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.left_sat[i]    = static_cast<Uint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.right_coeff[i] = static_cast<Sint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.left_coeff[i]  = static_cast<Sint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.center[i]      = 0;
-		effect.condition.deadband[i]    = 0;
+		work[bitReverse[k]] = std::complex<float>( input[2 * k], input[2 * k + 1] );
 	}
 
-	// Créer l'effet
-	if( effects[index].effectId >= 0 )
+	butterflies();
+
+	// Séparer les spectres des échantillons pairs et impairs, puis les recombiner
+	output.resize( half + 1 );
+	for( int k = 0; k <= half; ++k )
 	{
-		SDL_HapticDestroyEffect( haptic, effects[index].effectId );
-	}
+		std::complex<float> current  = work[k % half];
+		std::complex<float> mirrored = std::conj( work[( half - k ) % half] );
+		std::complex<float> evenPart = ( current + mirrored ) * 0.5f;
+		std::complex<float> oddPart  = ( current - mirrored ) * std::complex<float>( 0.0f, -0.5f );
+		std::complex<float> rotation = k < half ? twiddles[k] : std::complex<float>( -1.0f, 0.0f );
 
-	effects[index].effectId = SDL_HapticNewEffect( haptic, &effect );
+		output[k] = evenPart + rotation * oddPart;
+	}
 }
 
-void ForceManager::initDamperEffect( int index )
+void RealFFT::inverse( const std::vector<std::complex<float>>& spectrum, float* output )
 {
-	if( !haptic || index >= effects.size() )
-		return;
+	int half = size / 2;
 
-	SDL_HapticEffect effect;
-	memset( &effect, 0, sizeof( SDL_HapticEffect ) );
+	// Reconstituer les spectres des échantillons pairs et impairs, puis la FFT complexe conjuguée
+	for( int k = 0; k < half; ++k )
+	{
+		std::complex<float> current  = spectrum[k];
+		std::complex<float> mirrored = std::conj( spectrum[half - k] );
+		std::complex<float> evenPart = ( current + mirrored ) * 0.5f;
+		std::complex<float> oddPart  = ( current - mirrored ) * 0.5f * std::conj( twiddles[k] );
+
+		work[bitReverse[k]] = std::conj( evenPart + std::complex<float>( 0.0f, 1.0f ) * oddPart );
+	}
 
-	effect.type                       = SDL_HAPTIC_DAMPER;
-	effect.condition.direction.type   = SDL_HAPTIC_POLAR;
-	effect.condition.direction.dir[0] = 0;
-	effect.condition.length           = SDL_HAPTIC_INFINITY;
+	butterflies();
 
-	// Paramètres spécifiques à l'effet amortissement
-	for( int i = 0; i < SDL_HapticNumAxes( haptic ) && i < 3; ++i )
+	// Conjuguer et normaliser: parties réelles = échantillons pairs, imaginaires = impairs
+	float scale = 1.0f / half;
+	for( int k = 0; k < half; ++k )
 	{
-		effect.condition.right_sat[i]   = static_cast<Uint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.left_sat[i]    = static_cast<Uint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.right_coeff[i] = static_cast<Sint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.left_coeff[i]  = static_cast<Sint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.center[i]      = 0;
-		effect.condition.deadband[i]    = 0;
+		output[2 * k]     = work[k].real() * scale;
+		output[2 * k + 1] = -work[k].imag() * scale;
 	}
+}
 
-	// Créer l'effet
-	if( effects[index].effectId >= 0 )
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE SPECTRUMANALYZER
+// =============================================================================
+
+SpectrumAnalyzer::SpectrumAnalyzer() : running( false ), busy( false ), fftSize( 1024 ), windowType( SPECTRUM_WINDOW_HANN ),
+									   history( SPECTRUM_MAX_SIZE, 0.0f ), historyTimes( SPECTRUM_MAX_SIZE, 0 ), historyWrite( 0 ), newSamples( 0 ),
+									   offlinePending( false ), offlineRate( 0.0f ), offlineHold( false ), preparedWindow( SPECTRUM_WINDOW_COUNT ), coefficientSum( 0.0 )
+{
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+	stop();
+}
+
+void SpectrumAnalyzer::start()
+{
+	if( running )
 	{
-		SDL_HapticDestroyEffect( haptic, effects[index].effectId );
+		return;
 	}
 
-	effects[index].effectId = SDL_HapticNewEffect( haptic, &effect );
+	running = true;
+	worker  = std::thread( &SpectrumAnalyzer::run, this );
 }
 
-void ForceManager::initFrictionEffect( int index )
+void SpectrumAnalyzer::stop()
 {
-	if( !haptic || index >= effects.size() )
-		return;
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		running = false;
+	}
+	wake.notify_one();
 
-	SDL_HapticEffect effect;
-	memset( &effect, 0, sizeof( SDL_HapticEffect ) );
+	if( worker.joinable() )
+	{
+		worker.join();
+	}
+}
 
-	effect.type                       = SDL_HAPTIC_FRICTION;
-	effect.condition.direction.type   = SDL_HAPTIC_POLAR;
-	effect.condition.direction.dir[0] = 0;
-	effect.condition.length           = SDL_HAPTIC_INFINITY;
+void SpectrumAnalyzer::configure( int size, SpectrumWindow type )
+{
+	std::lock_guard<std::mutex> lock( mutex );
 
-	// Paramètres spécifiques à l'effet friction
-	for( int i = 0; i < SDL_HapticNumAxes( haptic ) && i < 3; ++i )
+	if( size >= SPECTRUM_MIN_SIZE && size <= SPECTRUM_MAX_SIZE && ( size & ( size - 1 ) ) == 0 )
 	{
-		effect.condition.right_sat[i]   = static_cast<Uint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.left_sat[i]    = static_cast<Uint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.right_coeff[i] = static_cast<Sint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.left_coeff[i]  = static_cast<Sint16>( 32767.0f * effects[index].strength / 100.0f );
-		effect.condition.center[i]      = 0;
-		effect.condition.deadband[i]    = 0;
+		fftSize = size;
 	}
-
-	// Créer l'effet
-	if( effects[index].effectId >= 0 )
+	if( type >= 0 && type < SPECTRUM_WINDOW_COUNT )
 	{
-		SDL_HapticDestroyEffect( haptic, effects[index].effectId );
+		windowType = type;
 	}
 
-	effects[index].effectId = SDL_HapticNewEffect( haptic, &effect );
+	// Recalculer dès que la nouvelle fenêtre est remplie
+	newSamples = fftSize;
+	wake.notify_one();
 }
 
-void ForceManager::initSineEffect( int index )
+int SpectrumAnalyzer::getSize() const
 {
-	if( !haptic || index >= effects.size() )
-		return;
+	std::lock_guard<std::mutex> lock( mutex );
+	return fftSize;
+}
 
-	SDL_HapticEffect effect;
-	memset( &effect, 0, sizeof( SDL_HapticEffect ) );
+SpectrumWindow SpectrumAnalyzer::getWindow() const
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	return windowType;
+}
 
-	effect.type                      = SDL_HAPTIC_SINE;
-	effect.periodic.direction.type   = SDL_HAPTIC_POLAR;
-	effect.periodic.direction.dir[0] = 0;
-	effect.periodic.length           = static_cast<Uint32>( effects[index].duration * 1000 );
-	effect.periodic.period           = 100;
-	effect.periodic.magnitude        = static_cast<Sint16>( 32767.0f * effects[index].strength / 100.0f );
-	effect.periodic.attack_length    = 0;
-	effect.periodic.fade_length      = 0;
+void SpectrumAnalyzer::pushSamples( const std::vector<RawInputSample>& samples, int lane )
+{
+	if( samples.empty() || lane < 0 || lane >= MAX_SAMPLED_AXES )
+	{
+		return;
+	}
 
-	// Créer l'effet
-	if( effects[index].effectId >= 0 )
 	{
-		SDL_HapticDestroyEffect( haptic, effects[index].effectId );
+		std::lock_guard<std::mutex> lock( mutex );
+		for( const auto& sample : samples )
+		{
+			size_t slot        = historyWrite % SPECTRUM_MAX_SIZE;
+			history[slot]      = sample.axes[lane] / 32768.0f;
+			historyTimes[slot] = sample.timestamp;
+			historyWrite++;
+		}
+		newSamples += samples.size();
 	}
 
-	effects[index].effectId = SDL_HapticNewEffect( haptic, &effect );
+	wake.notify_one();
 }
 
-void ForceManager::initSawtoothEffect( int index )
+void SpectrumAnalyzer::clearHistory()
 {
-	if( !haptic || index >= effects.size() )
-		return;
-
-	SDL_HapticEffect effect;
-	memset( &effect, 0, sizeof( SDL_HapticEffect ) );
-
-	effect.type                      = SDL_HAPTIC_SAWTOOTHUP;
-	effect.periodic.direction.type   = SDL_HAPTIC_POLAR;
-	effect.periodic.direction.dir[0] = 0;
-	effect.periodic.length           = static_cast<Uint32>( effects[index].duration * 1000 );
-	effect.periodic.period           = 250;
-	effect.periodic.magnitude        = static_cast<Sint16>( 32767.0f * effects[index].strength / 100.0f );
-	effect.periodic.attack_length    = 0;
-	effect.periodic.fade_length      = 0;
+	std::lock_guard<std::mutex> lock( mutex );
+	historyWrite = 0;
+	newSamples   = 0;
+	liveResult.reset();
+}
 
-	// Créer l'effet
-	if( effects[index].effectId >= 0 )
+void SpectrumAnalyzer::analyzeOffline( std::vector<double> times, std::vector<float> values, float sampleRate, bool hold )
+{
 	{
-		SDL_HapticDestroyEffect( haptic, effects[index].effectId );
+		std::lock_guard<std::mutex> lock( mutex );
+		offlineTimes   = std::move( times );
+		offlineValues  = std::move( values );
+		offlineRate    = sampleRate;
+		offlineHold    = hold;
+		offlinePending = true;
+		busy           = true;
 	}
 
-	effects[index].effectId = SDL_HapticNewEffect( haptic, &effect );
+	wake.notify_one();
 }
 
-void ForceManager::initRumbleEffect( int index )
+std::shared_ptr<const SpectrumResult> SpectrumAnalyzer::getLiveResult() const
 {
-	if( !haptic || index >= effects.size() )
-		return;
+	std::lock_guard<std::mutex> lock( mutex );
+	return liveResult;
+}
 
-	SDL_HapticEffect effect;
-	memset( &effect, 0, sizeof( SDL_HapticEffect ) );
+std::shared_ptr<const SpectrumResult> SpectrumAnalyzer::getOfflineResult() const
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	return offlineResult;
+}
 
-	effect.type                      = SDL_HAPTIC_LEFTRIGHT;
-	effect.leftright.length          = static_cast<Uint32>( effects[index].duration * 1000 );
-	effect.leftright.large_magnitude = static_cast<Uint16>( 65535.0f * effects[index].strength / 100.0f );
-	effect.leftright.small_magnitude = static_cast<Uint16>( 65535.0f * effects[index].strength / 100.0f );
+bool SpectrumAnalyzer::isBusy() const
+{
+	return busy;
+}
 
-	// Créer l'effet
-	if( effects[index].effectId >= 0 )
+const char* SpectrumAnalyzer::getWindowName( SpectrumWindow type )
+{
+	switch( type )
 	{
-		SDL_HapticDestroyEffect( haptic, effects[index].effectId );
+		case SPECTRUM_WINDOW_RECTANGULAR:
+			return "Rectangulaire";
+		case SPECTRUM_WINDOW_HANN:
+			return "Hann";
+		case SPECTRUM_WINDOW_HAMMING:
+			return "Hamming";
+		case SPECTRUM_WINDOW_BLACKMAN_HARRIS:
+			return "Blackman-Harris";
+		default:
+			return "?";
 	}
-
-	effects[index].effectId = SDL_HapticNewEffect( haptic, &effect );
 }
 
-void ForceManager::simulateCollision( float strength, Logger& logger )
+void SpectrumAnalyzer::prepare( int size, SpectrumWindow type )
 {
-	if( !haptic || !ffbEnabled )
+	if( size == fft.getSize() && type == preparedWindow )
 	{
-		logger.log( Logger::DEBUG, "Simulation de collision ignorée: haptic non disponible ou désactivé" );
 		return;
 	}
 
-	// Multiplier par la force globale
-	strength = strength * masterStrength / 100.0f;
-
-	SDL_HapticEffect effect;
-	memset( &effect, 0, sizeof( SDL_HapticEffect ) );
-
-	effect.type                      = SDL_HAPTIC_CONSTANT;
-	effect.constant.direction.type   = SDL_HAPTIC_POLAR;
-	effect.constant.direction.dir[0] = 0;
-	effect.constant.length           = 200; // 200ms
-	effect.constant.level            = static_cast<Sint16>( 32767.0f * strength / 100.0f );
-	effect.constant.attack_length    = 0;
-	effect.constant.fade_length      = 100;
+	fft.setSize( size );
+	preparedWindow = type;
 
-	int effectId = SDL_HapticNewEffect( haptic, &effect );
-	if( effectId < 0 )
+	// Fenêtres périodiques (adaptées à l'analyse spectrale)
+	coefficients.resize( size );
+	coefficientSum = 0.0;
+	for( int i = 0; i < size; ++i )
 	{
-		logger.log( Logger::ERROR, "Impossible de créer l'effet de collision: " + std::string( SDL_GetError() ) );
-		return;
+		double x = 2.0 * M_PI * i / size;
+		double w = 1.0;
+		switch( type )
+		{
+			case SPECTRUM_WINDOW_HANN:
+				w = 0.5 - 0.5 * cos( x );
+				break;
+			case SPECTRUM_WINDOW_HAMMING:
+				w = 0.54 - 0.46 * cos( x );
+				break;
+			case SPECTRUM_WINDOW_BLACKMAN_HARRIS:
+				w = 0.35875 - 0.48829 * cos( x ) + 0.14128 * cos( 2.0 * x ) - 0.01168 * cos( 3.0 * x );
+				break;
+			default:
+				break;
+		}
+		coefficients[i] = static_cast<float>( w );
+		coefficientSum += w;
 	}
 
-	SDL_HapticRunEffect( haptic, effectId, 1 );
-	SDL_Delay( 10 ); // Petit délai pour s'assurer que l'effet démarre
-
-	// L'effet sera détruit après sa durée
-	logger.log( Logger::DEBUG, "Collision simulée avec force: " + std::to_string( strength ) );
-
-	// Destruction différée de l'effet (après sa durée + marge)
-	SDL_TimerID timer = SDL_AddTimer( 300, []( Uint32 interval, void* param ) -> Uint32
-	{
-		int* pEffectId = static_cast<int*>( param );
-		SDL_HapticDestroyEffect( SDL_HapticOpen( 0 ), *pEffectId );
-		delete pEffectId;
-		return 0; // Ne pas répéter le timer
-	}, new int( effectId ) );
+	frame.resize( size );
 }
 
-void ForceManager::playEffect( int index, Logger& logger )
+void SpectrumAnalyzer::accumulate( const float* values )
 {
-	if( !haptic || !ffbEnabled || index >= effects.size() )
+	int size = fft.getSize();
+
+	// Retirer la composante continue pour qu'elle ne fuie pas sur les premières raies
+	double mean = 0.0;
+	for( int i = 0; i < size; ++i )
 	{
-		logger.log( Logger::DEBUG, "Lecture d'effet ignorée: haptic non disponible ou désactivé" );
-		return;
+		mean += values[i];
 	}
+	mean /= size;
 
-	auto& effect = effects[index];
-
-	if( effect.effectId < 0 )
+	for( int i = 0; i < size; ++i )
 	{
-		logger.log( Logger::WARNING, "Effet " + effect.name + " non initialisé" );
-		return;
+		frame[i] = ( values[i] - static_cast<float>( mean ) ) * coefficients[i];
 	}
 
-	// Mettre à jour l'effet avec les paramètres actuels
-	updateEffect( index );
+	fft.forward( frame.data(), bins );
 
-	// Jouer l'effet
-	SDL_HapticRunEffect( haptic, effect.effectId, 1 );
-	logger.log( Logger::DEBUG, "Effet " + effect.name + " joué avec force: " + std::to_string( effect.strength * masterStrength / 100.0f ) );
+	power.resize( bins.size(), 0.0 );
+	for( size_t k = 0; k < bins.size(); ++k )
+	{
+		power[k] += std::norm( bins[k] );
+	}
 }
 
-void ForceManager::updateEffect( int index )
+std::shared_ptr<SpectrumResult> SpectrumAnalyzer::finish( int windowCount, float sampleRate ) const
 {
-	if( !haptic || index >= effects.size() || effects[index].effectId < 0 )
+	auto result         = std::make_shared<SpectrumResult>();
+	result->fftSize     = fft.getSize();
+	result->sampleRate  = sampleRate;
+	result->binWidth    = sampleRate / result->fftSize;
+	result->windowCount = windowCount;
+
+	// Amplitude d'une sinusoïde corrigée du gain de la fenêtre, en dB pleine échelle
+	size_t binCount = power.size();
+	result->levels.resize( binCount );
+	for( size_t k = 0; k < binCount; ++k )
 	{
-		return;
+		double scale     = ( k == 0 || k == binCount - 1 ) ? 1.0 : 2.0;
+		double amplitude = sqrt( power[k] / windowCount ) * scale / coefficientSum;
+		result->levels[k] = static_cast<float>( 20.0 * log10( std::max( amplitude, 1e-7 ) ) );
 	}
 
-	auto& effect           = effects[index];
-	float adjustedStrength = effect.strength * masterStrength / 100.0f;
+	if( binCount < 3 )
+	{
+		return result;
+	}
 
-	SDL_HapticEffect sdlEffect;
-	memset( &sdlEffect, 0, sizeof( SDL_HapticEffect ) );
+	// Pics: maxima locaux nettement au-dessus du plancher (médiane des niveaux), à moins de 60 dB de la raie la plus forte
+	std::vector<float> sorted( result->levels.begin() + 1, result->levels.end() );
+	float              strongest = *std::max_element( sorted.begin(), sorted.end() );
+	std::nth_element( sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end() );
+	float threshold = std::max( sorted[sorted.size() / 2] + 12.0f, strongest - 60.0f );
 
-	if( SDL_HapticGetEffectStatus( haptic, effect.effectId ) >= 0 )
+	for( size_t k = 1; k + 1 < binCount; ++k )
 	{
-		switch( index )
+		float left   = result->levels[k - 1];
+		float center = result->levels[k];
+		float right  = result->levels[k + 1];
+		if( center <= threshold || center <= left || center < right )
 		{
-			case 0: // Constant
-				sdlEffect.type = SDL_HAPTIC_CONSTANT;
-				sdlEffect.constant.direction.type   = SDL_HAPTIC_POLAR;
-				sdlEffect.constant.direction.dir[0] = 0;
-				sdlEffect.constant.length           = static_cast<Uint32>( effect.duration * 1000 );
-				sdlEffect.constant.level            = static_cast<Sint16>( 32767.0f * adjustedStrength / 100.0f );
-				sdlEffect.constant.attack_length    = 0;
-				sdlEffect.constant.fade_length      = 0;
-				break;
-
-			case 1: // Ressort
-			case 2: // Amortissement
-			case 3: // Friction
-			{
-				Uint16 type;
-				switch( index )
-				{
-					case 1:
-						type = SDL_HAPTIC_SPRING;
-						break;
-					case 2:
-						type = SDL_HAPTIC_DAMPER;
-						break;
-					case 3:
-						type = SDL_HAPTIC_FRICTION;
-						break;
-					default:
-						type = SDL_HAPTIC_SPRING;
-						break;
-				}
-
-				sdlEffect.type                       = type;
-				sdlEffect.condition.direction.type   = SDL_HAPTIC_POLAR;
-				sdlEffect.condition.direction.dir[0] = 0;
-				sdlEffect.condition.length           = SDL_HAPTIC_INFINITY;
+			continue;
+		}
 
-				for( int i = 0; i < SDL_HapticNumAxes( haptic ) && i < 3; ++i )
-				{
-					sdlEffect.condition.right_sat[i]   = static_cast<Uint16>( 32767.0f * adjustedStrength / 100.0f );
-					sdlEffect.condition.left_sat[i]    = static_cast<Uint16>( 32767.0f * adjustedStrength / 100.0f );
-					sdlEffect.condition.right_coeff[i] = static_cast<Sint16>( 32767.0f * adjustedStrength / 100.0f );
-					sdlEffect.condition.left_coeff[i]  = static_cast<Sint16>( 32767.0f * adjustedStrength / 100.0f );
-				}
-				break;
-			}
+		// Interpolation parabolique sur les trois raies
+		float denominator = left - 2.0f * center + right;
+		float offset      = denominator != 0.0f ? 0.5f * ( left - right ) / denominator : 0.0f;
+		result->peaks.push_back( { ( k + offset ) * result->binWidth, center - 0.25f * ( left - right ) * offset } );
+	}
 
-			case 4: // Sinusoïdal
-			case 5: // Dent de scie
-			{
-				Uint16 type;
-				switch( index )
-				{
-					case 4:
-						type = SDL_HAPTIC_SINE;
-						break;
-					case 5:
-						type = SDL_HAPTIC_SAWTOOTHUP;
-						break;
-					default:
-						type = SDL_HAPTIC_SINE;
-						break;
-				}
+	const size_t maxPeaks = 5;
+	std::sort( result->peaks.begin(), result->peaks.end(), []( const SpectrumPeak& a, const SpectrumPeak& b ) { return a.level > b.level; } );
+	if( result->peaks.size() > maxPeaks )
+	{
+		result->peaks.resize( maxPeaks );
+	}
 
-				sdlEffect.type                      = type;
-				sdlEffect.periodic.direction.type   = SDL_HAPTIC_POLAR;
-				sdlEffect.periodic.direction.dir[0] = 0;
-				sdlEffect.periodic.length           = static_cast<Uint32>( effect.duration * 1000 );
-				sdlEffect.periodic.period           = index == 4 ? 100 : 250;
-				sdlEffect.periodic.magnitude        = static_cast<Sint16>( 32767.0f * adjustedStrength / 100.0f );
-				break;
-			}
+	return result;
+}
 
-			case 6: // Rumble
-				sdlEffect.type = SDL_HAPTIC_LEFTRIGHT;
-				sdlEffect.leftright.length          = static_cast<Uint32>( effect.duration * 1000 );
-				sdlEffect.leftright.large_magnitude = static_cast<Uint16>( 65535.0f * adjustedStrength / 100.0f );
-				sdlEffect.leftright.small_magnitude = static_cast<Uint16>( 65535.0f * adjustedStrength / 100.0f );
-				break;
+std::shared_ptr<SpectrumResult> SpectrumAnalyzer::analyzeSeries( std::vector<double>& times, std::vector<float>& values, float sampleRate, bool hold, int size, SpectrumWindow type )
+{
+	if( times.size() < 2 || times.size() != values.size() || sampleRate <= 0.0f )
+	{
+		return nullptr;
+	}
 
-			case 7: // Choc
-				sdlEffect.type = SDL_HAPTIC_CONSTANT;
-				sdlEffect.constant.direction.type   = SDL_HAPTIC_POLAR;
-				sdlEffect.constant.direction.dir[0] = 0;
-				sdlEffect.constant.length           = static_cast<Uint32>( effect.duration * 1000 );
-				sdlEffect.constant.level            = static_cast<Sint16>( 32767.0f * adjustedStrength / 100.0f );
-				sdlEffect.constant.attack_length    = 0;
-				sdlEffect.constant.fade_length      = static_cast<Uint16>( effect.duration * 500 );
-				break;
+	// Rééchantillonner sur une grille régulière
+	double             start = times.front();
+	size_t             count = static_cast<size_t>( ( times.back() - start ) * sampleRate ) + 1;
+	std::vector<float> uniform( count );
+	size_t             segment = 0;
+	for( size_t i = 0; i < count; ++i )
+	{
+		double t = start + i / static_cast<double>( sampleRate );
+		while( segment + 2 < times.size() && times[segment + 1] <= t )
+		{
+			segment++;
 		}
 
-		SDL_HapticUpdateEffect( haptic, effect.effectId, &sdlEffect );
+		if( hold || t <= times[segment] || times[segment + 1] <= times[segment] )
+		{
+			uniform[i] = t >= times[segment + 1] ? values[segment + 1] : values[segment];
+		}
+		else
+		{
+			double ratio = std::min( 1.0, ( t - times[segment] ) / ( times[segment + 1] - times[segment] ) );
+			uniform[i]   = static_cast<float>( values[segment] + ( values[segment + 1] - values[segment] ) * ratio );
+		}
 	}
-}
 
-void ForceManager::stopAllEffects()
-{
-	if( !haptic )
+	// Enregistrement plus court que la fenêtre demandée: réduire la fenêtre
+	while( size > SPECTRUM_MIN_SIZE && static_cast<size_t>( size ) > count )
 	{
-		return;
+		size /= 2;
+	}
+	if( static_cast<size_t>( size ) > count )
+	{
+		return nullptr;
 	}
 
-	SDL_HapticStopAll( haptic );
-
-	// Désactiver tous les effets dans le modèle
-	for( auto& effect : effects )
+	// Méthode de Welch: fenêtres recouvrantes à 50 %, puissances moyennées
+	prepare( size, type );
+	power.assign( size / 2 + 1, 0.0 );
+	int windowCount = 0;
+	for( size_t offset = 0; offset + size <= count; offset += size / 2 )
 	{
-		effect.enabled = false;
+		accumulate( uniform.data() + offset );
+		windowCount++;
 	}
+
+	return finish( windowCount, sampleRate );
 }
 
-void ForceManager::update( Logger& logger )
+void SpectrumAnalyzer::run()
 {
-	if( !haptic || !ffbEnabled )
-	{
-		return;
-	}
+	const double       frequency = static_cast<double>( SDL_GetPerformanceFrequency() );
+	std::vector<float> values;
+	std::vector<Uint64> times;
 
-	// Jouer tous les effets actifs
-	for( size_t i = 0; i < effects.size(); ++i )
+	while( running )
 	{
-		auto& effect = effects[i];
+		std::unique_lock<std::mutex> lock( mutex );
+		wake.wait_for( lock, std::chrono::milliseconds( 100 ), [this] { return !running || offlinePending || newSamples >= static_cast<Uint64>( fftSize / 4 ); } );
+		if( !running )
+		{
+			break;
+		}
 
-		if( effect.enabled && effect.effectId >= 0 )
+		int            size = fftSize;
+		SpectrumWindow type = windowType;
+
+		// Analyse hors ligne d'un enregistrement
+		if( offlinePending )
 		{
-			// Vérifier si l'effet est déjà en cours
-			if( SDL_HapticGetEffectStatus( haptic, effect.effectId ) == 0 )
-			{
-				// Mettre à jour et jouer l'effet
-				updateEffect( i );
-				SDL_HapticRunEffect( haptic, effect.effectId, 1 );
-				logger.log( Logger::DEBUG, "Effet " + effect.name + " activé" );
-			}
+			std::vector<double> seriesTimes  = std::move( offlineTimes );
+			std::vector<float>  seriesValues = std::move( offlineValues );
+			float               rate         = offlineRate;
+			bool                hold         = offlineHold;
+			offlinePending                   = false;
+			lock.unlock();
+
+			std::shared_ptr<SpectrumResult> result = analyzeSeries( seriesTimes, seriesValues, rate, hold, size, type );
+
+			lock.lock();
+			offlineResult = result;
+			busy          = offlinePending;
+			continue;
 		}
-		else if( !effect.enabled && effect.effectId >= 0 )
+
+		// Fenêtre glissante: recalcul tous les quarts de fenêtre
+		if( newSamples < static_cast<Uint64>( size / 4 ) || historyWrite < static_cast<Uint64>( size ) )
 		{
-			// Arrêter l'effet s'il est actif
-			if( SDL_HapticGetEffectStatus( haptic, effect.effectId ) > 0 )
-			{
-				SDL_HapticStopEffect( haptic, effect.effectId );
-				logger.log( Logger::DEBUG, "Effet " + effect.name + " désactivé" );
-			}
+			continue;
+		}
+
+		newSamples = 0;
+		values.resize( size );
+		times.resize( size );
+		for( int i = 0; i < size; ++i )
+		{
+			size_t slot = ( historyWrite - size + i ) % SPECTRUM_MAX_SIZE;
+			values[i]   = history[slot];
+			times[i]    = historyTimes[slot];
 		}
+		lock.unlock();
+
+		// Fréquence d'échantillonnage réelle mesurée sur la fenêtre
+		if( times.back() <= times.front() )
+		{
+			continue;
+		}
+		float rate = static_cast<float>( ( size - 1 ) * frequency / static_cast<double>( times.back() - times.front() ) );
+
+		prepare( size, type );
+		power.assign( size / 2 + 1, 0.0 );
+		accumulate( values.data() );
+		std::shared_ptr<SpectrumResult> result = finish( 1, rate );
+
+		lock.lock();
+		liveResult = result;
 	}
 }
 
-bool ForceManager::isFFBEnabled() const
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE BUTTONANALYZER
+// =============================================================================
+
+void DurationHistogram::clear()
 {
-	return ffbEnabled;
+	memset( bins, 0, sizeof( bins ) );
+	count = 0;
+	minMs = 0.0;
+	maxMs = 0.0;
+	sumMs = 0.0;
 }
 
-void ForceManager::setFFBEnabled( bool enabled )
+void DurationHistogram::add( double durationMs )
 {
-	ffbEnabled = enabled;
-
-	if( !enabled && haptic )
+	// Classe en temps constant à partir de l'exposant binaire
+	int bin = 0;
+	if( durationMs >= 1.0 )
 	{
-		SDL_HapticStopAll( haptic );
+		bin = std::min( std::ilogb( durationMs ) + 1, DURATION_HISTOGRAM_BINS - 1 );
+	}
+	else if( durationMs < 0.0 )
+	{
+		durationMs = 0.0;
 	}
+
+	bins[bin]++;
+	minMs = count == 0 ? durationMs : std::min( minMs, durationMs );
+	maxMs = count == 0 ? durationMs : std::max( maxMs, durationMs );
+	sumMs += durationMs;
+	count++;
 }
 
-float ForceManager::getMasterStrength() const
+double DurationHistogram::getMeanMs() const
 {
-	return masterStrength;
+	return count > 0 ? sumMs / count : 0.0;
 }
 
-void ForceManager::setMasterStrength( float strength )
+double DurationHistogram::getBinUpperMs( int bin )
 {
-	masterStrength = strength;
-
-	// Mettre à jour tous les effets
-	for( size_t i = 0; i < effects.size(); ++i )
+	if( bin >= DURATION_HISTOGRAM_BINS - 1 )
 	{
-		updateEffect( i );
+		return HUGE_VAL;
 	}
+
+	return std::ldexp( 1.0, bin );
 }
 
-std::vector<ForceEffect>& ForceManager::getEffects()
+ButtonAnalyzer::ButtonAnalyzer() : stats( MAX_BUTTONS ), bounceWindow( 0.005 ), transitionCount( 0 )
 {
-	return effects;
+	reset();
 }
 
-// =============================================================================
-// IMPLÉMENTATION DE LA CLASSE DEVICEMANAGER
-// =============================================================================
-
-DeviceManager::DeviceManager() : joystick( nullptr ), haptic( nullptr ), usingDemo( true )
+void ButtonAnalyzer::reset()
 {
-	// Initialiser les informations de démo
-	wheelInfo = {
-		"Logitech G29 Racing Wheel", 0, 24, 6, true
-	};
+	for( auto& button : stats )
+	{
+		button.edgeCount     = 0;
+		button.bounceCount   = 0;
+		button.pressCount    = 0;
+		button.releaseCount  = 0;
+		button.pressed       = false;
+		button.lastEdgeTime  = 0.0;
+		button.lastPressTime = 0.0;
+		button.holdTimes.clear();
+		button.pressIntervals.clear();
+	}
 
-	// Axes de démo
-	axes = {
-		{ "Volant", 0.0f, -1.0f, 1.0f, 0.05f, 0.0f },
-		{ "Accélérateur", 0.0f, 0.0f, 1.0f, 0.1f, 0.0f },
-		{ "Frein", 0.0f, 0.0f, 1.0f, 0.1f, 0.0f },
-		{ "Embrayage", 0.0f, 0.0f, 1.0f, 0.1f, 0.0f },
-		{ "Levier de vitesse X", 0.0f, -1.0f, 1.0f, 0.1f, 0.0f },
-		{ "Levier de vitesse Y", 0.0f, -1.0f, 1.0f, 0.1f, 0.0f }
-	};
+	transitionCount = 0;
+}
 
-	// Boutons de démo
-	buttons.resize( 24, false );
+void ButtonAnalyzer::setBounceWindowMs( float windowMs )
+{
+	bounceWindow = std::max( windowMs, 0.0f ) / 1000.0;
 }
 
-DeviceManager::~DeviceManager()
+float ButtonAnalyzer::getBounceWindowMs() const
 {
-	cleanup();
+	return static_cast<float>( bounceWindow * 1000.0 );
 }
 
-void DeviceManager::cleanup()
+void ButtonAnalyzer::applyTransition( ButtonTimingStats& button, bool pressed, double timestamp )
 {
-	if( haptic )
+	if( pressed )
 	{
-		SDL_HapticClose( haptic );
-		haptic = nullptr;
+		if( button.pressCount > 0 )
+		{
+			button.pressIntervals.add( ( timestamp - button.lastPressTime ) * 1000.0 );
+		}
+
+		button.pressCount++;
+		button.lastPressTime = timestamp;
+		button.pressed       = true;
+	}
+	else if( button.pressed )
+	{
+		button.holdTimes.add( ( timestamp - button.lastPressTime ) * 1000.0 );
+		button.releaseCount++;
+		button.pressed = false;
+	}
+}
+
+void ButtonAnalyzer::addTransition( int button, bool pressed, double timestamp )
+{
+	if( button < 0 || button >= MAX_BUTTONS )
+	{
+		return;
+	}
+
+	ButtonTimingStats& target       = stats[button];
+	double             previousEdge = target.lastEdgeTime;
+	bool               first        = target.edgeCount == 0;
+
+	target.edgeCount++;
+	target.lastEdgeTime = timestamp;
+	transitionCount++;
+
+	// Un front trop proche du précédent est un rebond: il ne change pas l'état filtré
+	if( !first && timestamp - previousEdge < bounceWindow )
+	{
+		target.bounceCount++;
+		return;
+	}
+
+	// Si les rebonds ont masqué une transition (appui plus court que la fenêtre), la clore au dernier front
+	if( !first && pressed == target.pressed )
+	{
+		applyTransition( target, !pressed, previousEdge );
 	}
 
-	if( joystick )
+	applyTransition( target, pressed, timestamp );
+}
+
+void ButtonAnalyzer::addEvents( const std::vector<InputEvent>& events )
+{
+	for( const auto& event : events )
 	{
-		SDL_JoystickClose( joystick );
-		joystick = nullptr;
+		if( event.type == INPUT_EVENT_BUTTON )
+		{
+			addTransition( event.index, event.value != 0, event.timestamp );
+		}
 	}
 }
 
-ResultCode DeviceManager::initialize( Logger& logger )
+const ButtonTimingStats& ButtonAnalyzer::getStats( int button ) const
 {
-	cleanup();
+	return stats[std::max( 0, std::min( button, MAX_BUTTONS - 1 ) )];
+}
 
-	// Rechercher des joysticks
-	int numJoysticks = SDL_NumJoysticks();
-	if( numJoysticks <= 0 )
+bool ButtonAnalyzer::hasData() const
+{
+	return transitionCount > 0;
+}
+
+ResultCode ButtonAnalyzer::exportCSV( const std::string& filename, int buttonCount ) const
+{
+	std::ofstream file( filename );
+	if( !file.is_open() )
 	{
-		logger.log( Logger::WARNING, "Aucun joystick détecté, utilisation du mode démo" );
-		usingDemo = true;
-		return SUCCESS;
+		return ERROR_FILE_OPEN_FAILED;
 	}
 
-	// Trouver un joystick qui ressemble à un volant
-	for( int i = 0; i < numJoysticks; ++i )
+	// En-tête: résumé puis classes des deux histogrammes
+	file << "button,edges,bounces,presses,releases,hold_mean_ms,hold_min_ms,hold_max_ms,interval_mean_ms,interval_min_ms,interval_max_ms";
+	const char* prefixes[] = { "hold", "interval" };
+	for( const char* prefix : prefixes )
 	{
-		if( SDL_IsGameController( i ) )
+		for( int bin = 0; bin < DURATION_HISTOGRAM_BINS; ++bin )
 		{
-			continue; // Ignorer les contrôleurs de jeu standard
+			if( bin == DURATION_HISTOGRAM_BINS - 1 )
+				file << "," << prefix << "_ge_" << DurationHistogram::getBinUpperMs( bin - 1 ) << "ms";
+			else
+				file << "," << prefix << "_lt_" << DurationHistogram::getBinUpperMs( bin ) << "ms";
 		}
+	}
+	file << "\n";
 
-		joystick = SDL_JoystickOpen( i );
-		if( !joystick )
+	file << std::fixed << std::setprecision( 3 );
+	for( int i = 0; i < std::min( buttonCount, MAX_BUTTONS ); ++i )
+	{
+		const auto& button = stats[i];
+		if( button.edgeCount == 0 )
 		{
-			logger.log( Logger::WARNING, "Impossible d'ouvrir le joystick " + std::to_string( i ) + ": " + SDL_GetError() );
 			continue;
 		}
 
-		const char* name         = SDL_JoystickName( joystick );
-		std::string joystickName = name ? name : "Unknown";
-
-		// Rechercher des mots-clés de volant dans le nom
-		std::string lowerName = joystickName;
-		std::transform( lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower );
+		file << ( i + 1 ) << "," << button.edgeCount << "," << button.bounceCount << "," << button.pressCount << "," << button.releaseCount << ","
+			 << button.holdTimes.getMeanMs() << "," << button.holdTimes.minMs << "," << button.holdTimes.maxMs << ","
+			 << button.pressIntervals.getMeanMs() << "," << button.pressIntervals.minMs << "," << button.pressIntervals.maxMs;
 
-		if( lowerName.find( "wheel" ) != std::string::npos ||
-			lowerName.find( "volant" ) != std::string::npos ||
-			lowerName.find( "racing" ) != std::string::npos ||
-			lowerName.find( "driving" ) != std::string::npos ||
-			lowerName.find( "g29" ) != std::string::npos ||
-			lowerName.find( "g920" ) != std::string::npos ||
-			lowerName.find( "t300" ) != std::string::npos ||
-			lowerName.find( "t500" ) != std::string::npos )
+		for( Uint32 value : button.holdTimes.bins )
+		{
+			file << "," << value;
+		}
+		for( Uint32 value : button.pressIntervals.bins )
 		{
-			// C'est probablement un volant
-			logger.log( Logger::INFO, "Volant détecté: " + joystickName );
+			file << "," << value;
+		}
+		file << "\n";
+	}
 
-			// Initialiser les informations du volant
-			wheelInfo.name            = joystickName;
-			wheelInfo.id              = i;
-			wheelInfo.buttonCount     = SDL_JoystickNumButtons( joystick );
-			wheelInfo.axisCount       = SDL_JoystickNumAxes( joystick );
-			wheelInfo.hasForceFeeback = SDL_JoystickIsHaptic( joystick );
+	return file.good() ? SUCCESS : ERROR_FILE_WRITE_FAILED;
+}
 
-			// Initialiser les axes et boutons
-			axes.clear();
-			for( int j = 0; j < wheelInfo.axisCount; ++j )
-			{
-				std::string axisName;
+// =============================================================================
+// IMPLÉMENTATION DE LA CLASSE POLLINGRATEMETER
+// =============================================================================
 
-				// Nommer les axes en fonction de leur position habituelle
-				switch( j )
-				{
-					case 0:
-						axisName = "Volant";
-						break;
-					case 1:
-						axisName = "Accélérateur";
-						break;
-					case 2:
-						axisName = "Frein";
-						break;
-					case 3:
-						axisName = "Embrayage";
-						break;
-					case 4:
-						axisName = "Levier de vitesse X";
-						break;
-					case 5:
-						axisName = "Levier de vitesse Y";
-						break;
-					default:
-						axisName = "Axe " + std::to_string( j );
-						break;
-				}
+PollingRateMeter::PollingRateMeter() : running( false ), instanceId( -1 ), lastEvent( 0 ), detached( false ), histogram( BIN_COUNT, 0 ), reportCount( 0 ),
+									   firstReport( 0 ), lastReport( 0 ), intervalCount( 0 ), intervalSumUs( 0.0 ), intervalMaxUs( 0.0 )
+{
+}
 
-				axes.push_back( { axisName, 0.0f, -1.0f, 1.0f, 0.05f, 0.0f } );
-			}
+PollingRateMeter::~PollingRateMeter()
+{
+	stop();
+}
 
-			buttons.resize( wheelInfo.buttonCount, false );
+ResultCode PollingRateMeter::start( SDL_JoystickID joystickId )
+{
+	stop();
 
-			// Initialiser le retour de force
-			if( wheelInfo.hasForceFeeback )
-			{
-				forceManager.initialize( joystick, logger );
-			}
+	if( joystickId < 0 )
+	{
+		return ERROR_INVALID_PARAMETER;
+	}
 
-			usingDemo = false;
-			return SUCCESS;
-		}
+	std::fill( histogram.begin(), histogram.end(), 0 );
+	reportCount   = 0;
+	firstReport   = 0;
+	lastReport    = 0;
+	intervalCount = 0;
+	intervalSumUs = 0.0;
+	intervalMaxUs = 0.0;
 
-		// Ce n'est pas un volant, fermer et passer au suivant
-		SDL_JoystickClose( joystick );
-		joystick = nullptr;
+	{
+		std::lock_guard<std::mutex> lock( eventMutex );
+		pendingReports.clear();
+		lastEvent = 0;
+		detached  = false;
 	}
 
-	logger.log( Logger::WARNING, "Aucun volant détecté, utilisation du mode démo" );
-	usingDemo = true;
+	// Les événements sont horodatés au moment où SDL les publie, pas quand la boucle principale les dépile
+	instanceId = joystickId;
+	running    = true;
+	SDL_AddEventWatch( onEvent, this );
 	return SUCCESS;
 }
 
-void DeviceManager::updateInputs( RecordingManager& recorder, AutoTestManager& autoTest, Logger& logger )
+void PollingRateMeter::stop()
 {
-	if( !usingDemo && joystick )
+	if( !running )
 	{
-		// Lire les entrées réelles du joystick
-		for( int i = 0; i < wheelInfo.axisCount && i < axes.size(); ++i )
-		{
-			float rawValue   = SDL_JoystickGetAxis( joystick, i ) / 32767.0f;
-			axes[i].rawValue = rawValue;
-
-			// Appliquer la zone morte
-			if( fabs( rawValue ) < axes[i].deadzone )
-			{
-				rawValue = 0.0f;
-			}
-			else
-			{
-				// Remapper la valeur après la zone morte
-				float sign = rawValue < 0.0f ? -1.0f : 1.0f;
-				rawValue   = sign * ( fabs( rawValue ) - axes[i].deadzone ) / ( 1.0f - axes[i].deadzone );
-			}
+		return;
+	}
 
-			axes[i].value = rawValue;
-		}
+	SDL_DelEventWatch( onEvent, this );
+	readReports();
+	running = false;
+}
 
-		for( int i = 0; i < wheelInfo.buttonCount && i < buttons.size(); ++i )
-		{
-			buttons[i] = SDL_JoystickGetButton( joystick, i ) == 1;
-		}
+int SDLCALL PollingRateMeter::onEvent( void* userdata, SDL_Event* event )
+{
+	PollingRateMeter* meter = static_cast<PollingRateMeter*>( userdata );
 
-		// Mettre à jour le retour de force
-		forceManager.update( logger );
+	SDL_JoystickID which;
+	switch( event->type )
+	{
+		case SDL_JOYAXISMOTION:
+			which = event->jaxis.which;
+			break;
+		case SDL_JOYBUTTONDOWN:
+		case SDL_JOYBUTTONUP:
+			which = event->jbutton.which;
+			break;
+		case SDL_JOYDEVICEREMOVED:
+			if( event->jdevice.which == meter->instanceId )
+			{
+				std::lock_guard<std::mutex> lock( meter->eventMutex );
+				meter->detached = true;
+			}
+			return 1;
+		default:
+			return 1;
 	}
-	else if( autoTest.isTestRunning() )
+
+	if( which != meter->instanceId )
 	{
-		// Mode test automatique
-		autoTest.update( axes, buttons, forceManager.getEffects() );
+		return 1;
 	}
-	else
+
+	// Les événements d'un même rapport (plusieurs axes, boutons) sont publiés d'affilée
+	Uint64                      now = SDL_GetPerformanceCounter();
+	std::lock_guard<std::mutex> lock( meter->eventMutex );
+	if( meter->lastEvent == 0 || ( now - meter->lastEvent ) * 1000000.0 / SDL_GetPerformanceFrequency() >= REPORT_GAP_US )
 	{
-		// Mode démo - animation des axes
-		static float time = 0.0f;
-		time += ImGui::GetIO().DeltaTime;
+		meter->pendingReports.push_back( now );
+	}
+	meter->lastEvent = now;
+	return 1;
+}
 
-		// Animation des axes
-		if( !axes.empty() )
-			axes[0].value = sinf( time ) * 0.8f; // Volant
-		if( axes.size() > 1 )
-			axes[1].value = ( sinf( time * 0.7f ) + 1.0f ) * 0.5f; // Accélérateur
-		if( axes.size() > 2 )
-			axes[2].value = ( cosf( time * 0.5f ) + 1.0f ) * 0.5f; // Frein
+void PollingRateMeter::update()
+{
+	if( !running )
+	{
+		return;
+	}
 
-		// Mettre à jour les valeurs brutes
-		for( auto& axis : axes )
-		{
-			axis.rawValue = axis.value;
-		}
+	readReports();
 
-		// Animation des boutons
-		static float lastToggleTime = 0.0f;
-		float        currentTime    = ImGui::GetTime();
-		if( currentTime - lastToggleTime > 1.0f )
-		{
-			int randomButton      = rand() % buttons.size();
-			buttons[randomButton] = !buttons[randomButton];
-			lastToggleTime        = currentTime;
-		}
+	// Périphérique débranché: les résultats acquis sont conservés
+	bool removed;
+	{
+		std::lock_guard<std::mutex> lock( eventMutex );
+		removed = detached;
 	}
-
-	// Enregistrer les entrées si l'enregistrement est actif
-	if( recorder.getIsRecording() )
+	if( removed )
 	{
-		recorder.addSnapshot( axes, buttons );
+		stop();
 	}
 }
 
-ResultCode DeviceManager::reloadDevice( Logger& logger )
+void PollingRateMeter::readReports()
 {
-	return initialize( logger );
-}
+	const double frequency = static_cast<double>( SDL_GetPerformanceFrequency() );
 
-WheelInfo& DeviceManager::getWheelInfo()
-{
-	return wheelInfo;
-}
+	{
+		std::lock_guard<std::mutex> lock( eventMutex );
+		reports.swap( pendingReports );
+		pendingReports.clear();
+	}
 
-std::vector<AxisInfo>& DeviceManager::getAxes()
-{
-	return axes;
-}
+	for( Uint64 report : reports )
+	{
+		if( reportCount > 0 )
+		{
+			double intervalUs = ( report - lastReport ) * 1000000.0 / frequency;
+			int    bin        = std::min( static_cast<int>( intervalUs / BIN_US ), BIN_COUNT - 1 );
+			histogram[bin]++;
+			intervalCount++;
+			intervalSumUs += intervalUs;
+			intervalMaxUs = std::max( intervalMaxUs, intervalUs );
+		}
+		else
+		{
+			firstReport = report;
+		}
 
-std::vector<bool>& DeviceManager::getButtons()
-{
-	return buttons;
+		reportCount++;
+		lastReport = report;
+	}
 }
 
-ForceManager& DeviceManager::getForceManager()
+bool PollingRateMeter::isRunning() const
 {
-	return forceManager;
+	return running;
 }
 
-bool DeviceManager::isUsingDemo() const
+bool PollingRateMeter::hasResults() const
 {
-	return usingDemo;
+	return intervalCount > 0;
 }
 
-void DeviceManager::calibrateAxis( int axisIndex, Logger& logger )
+double PollingRateMeter::getPercentileUs( double fraction ) const
 {
-	if( axisIndex < 0 || axisIndex >= axes.size() )
+	if( intervalCount == 0 )
 	{
-		logger.log( Logger::ERROR, "Index d'axe invalide pour la calibration" );
-		return;
+		return 0.0;
 	}
 
-	logger.log( Logger::INFO, "Calibration de l'axe " + axes[axisIndex].name );
-
-	if( usingDemo )
+	// Centre de la classe qui contient le rang demandé
+	Uint64 rank       = static_cast<Uint64>( ceil( fraction * intervalCount ) );
+	Uint64 cumulative = 0;
+	for( int bin = 0; bin < BIN_COUNT; ++bin )
 	{
-		logger.log( Logger::WARNING, "Mode démo: calibration simulée" );
-		return;
+		cumulative += histogram[bin];
+		if( cumulative >= rank )
+		{
+			return std::min( ( bin + 0.5 ) * BIN_US, intervalMaxUs );
+		}
 	}
 
-	// Enregistrer les valeurs min/max pendant quelques secondes
-	float minValue = 0.0f;
-	float maxValue = 0.0f;
-	bool  first    = true;
-
-	// Durée de calibration: 5 secondes
-	float startTime = ImGui::GetTime();
-	float endTime   = startTime + 5.0f;
-
-	logger.log( Logger::INFO, "Déplacez l'axe " + axes[axisIndex].name + " dans toutes les positions pendant 5 secondes..." );
+	return intervalMaxUs;
+}
 
-	while( ImGui::GetTime() < endTime )
-	{
-		SDL_Event event;
-		while( SDL_PollEvent( &event ) )
-		{
-			// Traiter les événements pour éviter que SDL ne se bloque
-		}
+PollingStats PollingRateMeter::getStats() const
+{
+	const double frequency = static_cast<double>( SDL_GetPerformanceFrequency() );
 
-		if( joystick )
-		{
-			float value = SDL_JoystickGetAxis( joystick, axisIndex ) / 32767.0f;
+	PollingStats stats;
+	stats.reportCount = reportCount;
+	stats.reportRate  = reportCount > 1 && lastReport > firstReport ? ( reportCount - 1 ) * frequency / ( lastReport - firstReport ) : 0.0;
+	stats.meanMs      = intervalCount > 0 ? intervalSumUs / intervalCount / 1000.0 : 0.0;
+	stats.p50Ms       = getPercentileUs( 0.50 ) / 1000.0;
+	stats.p99Ms       = getPercentileUs( 0.99 ) / 1000.0;
+	stats.maxMs       = intervalMaxUs / 1000.0;
 
-			if( first )
-			{
-				minValue = maxValue = value;
-				first    = false;
-			}
-			else
-			{
-				minValue = std::min( minValue, value );
-				maxValue = std::max( maxValue, value );
-			}
-		}
+	return stats;
+}
 
-		SDL_Delay( 10 );
-	}
+void PollingRateMeter::getDisplayHistogram( std::vector<float>& bars, int barCount, double rangeMs ) const
+{
+	bars.assign( std::max( barCount, 1 ), 0.0f );
 
-	// Appliquer les nouvelles valeurs avec une marge
-	if( !first )
-	{
-		axes[axisIndex].min = minValue - 0.05f;
-		axes[axisIndex].max = maxValue + 0.05f;
-		logger.log( Logger::INFO, "Calibration terminée: min=" + std::to_string( axes[axisIndex].min ) + ", max=" + std::to_string( axes[axisIndex].max ) );
-	}
-	else
+	int binsInRange = std::max( 1, std::min( BIN_COUNT, static_cast<int>( ceil( rangeMs * 1000.0 / BIN_US ) ) ) );
+	for( int bin = 0; bin < binsInRange; ++bin )
 	{
-		logger.log( Logger::WARNING, "Calibration échouée: aucune donnée collectée" );
+		bars[static_cast<size_t>( bin ) * bars.size() / binsInRange] += static_cast<float>( histogram[bin] );
 	}
 }
 
@@ -1483,7 +7011,12 @@ void DeviceManager::calibrateAxis( int axisIndex, Logger& logger )
 // IMPLÉMENTATION DE LA CLASSE WHEELTESTAPP
 // =============================================================================
 
-WheelTestApp::WheelTestApp() : testMode( 0 ), collisionStrength( 80.0f ), configFilename( "wheel_config.json" )
+WheelTestApp::WheelTestApp() : testMode( 0 ), collisionStrength( 80.0f ), latencyIterations( 20 ), latencyStepLevel( 50.0f ),
+							   latencyThreshold( 2.0f ), analyzedButton( -1 ), configFilename( "wheel_config.json" ),
+							   spectrumAxis( 0 ), spectrumSizeIndex( 4 ), spectrumLive( false ), spectrumReadIndex( 0 ), renderRequested( true ), lastLogCount( 0 ),
+							   labelsVersion( 0 ), frameAllocations( 0 ), appliedThemeVersion( 0 ), showAxisHistory( true ), axisHistoryScrolling( false ),
+							   lastHistoryRender( 0 ), timelineStart( 0.0 ), timelineEnd( 0.0 ), timelineVersion( 0 ), timelineLevel( -1 ),
+							   comparisonThreshold( 0.05f ), comparison{ false, 0.0, 0.0, 0.0, 0.0, {}, {}, {} }
 {
 	// Initialiser la configuration par défaut
 	config.logFilename         = "wheel_test.log";
@@ -1492,15 +7025,35 @@ WheelTestApp::WheelTestApp() : testMode( 0 ), collisionStrength( 80.0f ), config
 	config.updateFrequency     = 0.0f;
 	config.masterForceStrength = 100.0f;
 	config.ffbEnabled          = true;
+	config.themeName           = themeLibrary.getCurrent().name;
 
 	strncpy( logFilename, config.logFilename.c_str(), sizeof( logFilename ) - 1 );
+	recordingFilename[0]  = '\0';
+	comparisonFilename[0] = '\0';
+	strncpy( batchDirectory, ".", sizeof( batchDirectory ) - 1 );
 }
 
 WheelTestApp::~WheelTestApp()
 {
+	// Le filtre d'événements de la mesure du taux de rapport est retiré avant la fermeture des joysticks
+	pollingMeter.stop();
 	deviceManager.cleanup();
 }
 
+// Fichier de données copié à côté de l'exécutable par la compilation, quel que soit le répertoire courant
+static std::string dataFilePath( const char* filename )
+{
+	char* basePath = SDL_GetBasePath();
+	if( !basePath )
+	{
+		return filename;
+	}
+
+	std::string path = std::string( basePath ) + filename;
+	SDL_free( basePath );
+	return path;
+}
+
 ResultCode WheelTestApp::initialize()
 {
 	// Initialiser le logger
@@ -1512,6 +7065,12 @@ ResultCode WheelTestApp::initialize()
 
 	logger.log( Logger::INFO, "Test de volant démarré" );
 
+	// Profils de périphériques, à côté de l'exécutable: sans fichier, les volants sont reconnus par leur type ou leur nom
+	deviceManager.loadDeviceDatabase( dataFilePath( "devices.ini" ), logger );
+
+	// Thèmes de l'interface, à côté de l'exécutable: le thème intégré reste disponible sans fichier
+	themeLibrary.loadFromFile( dataFilePath( "themes.ini" ), logger );
+
 	// Initialiser le gestionnaire de périphérique
 	result = deviceManager.initialize( logger );
 	if( result != SUCCESS )
@@ -1526,13 +7085,64 @@ ResultCode WheelTestApp::initialize()
 	// Charger la configuration si elle existe
 	loadConfig();
 
+	// Les spectres sont calculés hors du thread de l'interface
+	spectrumAnalyzer.start();
+
 	return SUCCESS;
 }
 
+void WheelTestApp::handleEvent( const SDL_Event& event )
+{
+	deviceManager.processEvent( event );
+}
+
 void WheelTestApp::update()
 {
 	// Mettre à jour les entrées du périphérique
 	deviceManager.updateInputs( recordingManager, autoTestManager, logger );
+
+	// Vue d'ensemble de l'enregistrement construite en arrière-plan
+	if( recordingManager.updateOverview() )
+	{
+		renderRequested = true;
+	}
+
+	// Analyser les fronts de boutons de la frame
+	buttonAnalyzer.addEvents( deviceManager.getFrameEvents() );
+
+	// Alimenter l'analyse spectrale en direct
+	feedSpectrum();
+
+	// Mesure du taux de rapport du périphérique principal
+	pollingMeter.update();
+
+	// Faire avancer la mesure de latence du retour de force
+	latencyTester.update( deviceManager.getSampler(), deviceManager.getForceManager(), logger );
+
+	// Redessiner si une entrée a changé ou si un message a été journalisé
+	Uint64 logCount = logger.getMessageCount();
+	if( !deviceManager.getFrameEvents().empty() || logCount != lastLogCount )
+	{
+		renderRequested = true;
+		lastLogCount    = logCount;
+	}
+}
+
+bool WheelTestApp::needsRender()
+{
+	// Les entrées simulées changent à chaque mise à jour. Un tracé visible n'avance avec le temps que tant
+	// qu'une variation reste dans sa fenêtre: une fois plat, seules les nouvelles entrées le redessinent.
+	bool scrolling  = axisHistoryScrolling && SDL_GetTicks() - lastHistoryRender >= HISTORY_FRAME_MS;
+	bool result     = renderRequested || isBusy() || deviceManager.isUsingDemo() || scrolling;
+	renderRequested = false;
+	return result;
+}
+
+bool WheelTestApp::isBusy() const
+{
+	return recordingManager.getIsRecording() || recordingManager.isOverviewBuilding() || autoTestManager.isTestRunning() || latencyTester.isRunning() || pollingMeter.isRunning() ||
+		   spectrumLive || spectrumAnalyzer.isBusy() || deviceManager.isCalibrating() || comparisonTask.valid() ||
+		   batchTask.valid() || exportTask.valid();
 }
 
 ResultCode WheelTestApp::loadConfig()
@@ -1581,43 +7191,136 @@ ResultCode WheelTestApp::loadConfig()
 				config.ffbEnabled = ( value == "true" || value == "1" );
 				deviceManager.getForceManager().setFFBEnabled( config.ffbEnabled );
 			}
+			else if( key == "theme" )
+			{
+				if( themeLibrary.select( value ) )
+				{
+					config.themeName = value;
+				}
+				else
+				{
+					logger.log( Logger::WARNING, "Thème inconnu: " + value );
+				}
+			}
+		}
+	}
+
+	logger.log( Logger::INFO, "Configuration chargée depuis " + configFilename );
+	logger.setLogToFile( config.logToFile, config.logFilename );
+	logger.setVerbose( config.verboseLogging );
+
+	return SUCCESS;
+}
+
+ResultCode WheelTestApp::saveConfig()
+{
+	std::ofstream file( configFilename );
+	if( !file.is_open() )
+	{
+		logger.log( Logger::ERROR, "Impossible de créer le fichier de configuration: " + configFilename );
+		return ERROR_FILE_OPEN_FAILED;
+	}
+
+	// Mettre à jour la config avec les valeurs actuelles
+	config.logFilename         = logFilename;
+	config.logToFile           = logger.isLogToFile();
+	config.verboseLogging      = logger.isVerbose();
+	config.masterForceStrength = deviceManager.getForceManager().getMasterStrength();
+	config.ffbEnabled          = deviceManager.getForceManager().isFFBEnabled();
+	config.themeName           = themeLibrary.getCurrent().name;
+
+	// Format simplifié pour cet exemple
+	file << "logFilename=" << config.logFilename << std::endl;
+	file << "logToFile=" << ( config.logToFile ? "true" : "false" ) << std::endl;
+	file << "verboseLogging=" << ( config.verboseLogging ? "true" : "false" ) << std::endl;
+	file << "updateFrequency=" << config.updateFrequency << std::endl;
+	file << "masterForceStrength=" << config.masterForceStrength << std::endl;
+	file << "ffbEnabled=" << ( config.ffbEnabled ? "true" : "false" ) << std::endl;
+	file << "theme=" << config.themeName << std::endl;
+
+	logger.log( Logger::INFO, "Configuration sauvegardée dans " + configFilename );
+
+	return SUCCESS;
+}
+
+void WheelTestApp::feedSpectrum()
+{
+	if( !spectrumLive )
+	{
+		return;
+	}
+
+	int           lane    = 0;
+	InputSampler* sampler = deviceManager.getAxisSampler( spectrumAxis, lane );
+	if( !sampler )
+	{
+		return;
+	}
+
+	// Copie seulement: la FFT est calculée par le thread de l'analyse
+	sampler->readSince( spectrumReadIndex, spectrumSamples );
+	spectrumAnalyzer.pushSamples( spectrumSamples, lane );
+}
+
+void WheelTestApp::analyzeRecordingSpectrum()
+{
+	std::vector<double> times;
+	std::vector<float>  values;
+
+	// Transitions brutes de l'axe si l'enregistrement en contient (horodatage à la milliseconde)
+	for( const auto& event : recordingManager.getEvents() )
+	{
+		if( event.type == INPUT_EVENT_AXIS && event.index == spectrumAxis )
+		{
+			times.push_back( event.timestamp );
+			values.push_back( event.value / 32768.0f );
+		}
+	}
+
+	if( times.size() >= 2 )
+	{
+		// Valeur tenue entre deux transitions, grille à la résolution des horodatages SDL
+		spectrumAnalyzer.analyzeOffline( std::move( times ), std::move( values ), 1000.0f, true );
+		return;
+	}
+
+	// Sinon, valeurs normalisées des instantanés (une par frame), interpolées
+	times.clear();
+	values.clear();
+	for( const auto& snapshot : recordingManager.getSnapshots() )
+	{
+		if( spectrumAxis < snapshot.axisValues.size() )
+		{
+			times.push_back( snapshot.timestamp );
+			values.push_back( snapshot.axisValues[spectrumAxis] );
 		}
 	}
 
-	logger.log( Logger::INFO, "Configuration chargée depuis " + configFilename );
-	logger.setLogToFile( config.logToFile, config.logFilename );
-	logger.setVerbose( config.verboseLogging );
+	if( times.size() < 2 || times.back() <= times.front() )
+	{
+		logger.log( Logger::WARNING, "Analyse spectrale: aucune donnée enregistrée pour cet axe" );
+		return;
+	}
 
-	return SUCCESS;
+	float rate = static_cast<float>( ( times.size() - 1 ) / ( times.back() - times.front() ) );
+	spectrumAnalyzer.analyzeOffline( std::move( times ), std::move( values ), rate, false );
 }
 
-ResultCode WheelTestApp::saveConfig()
+void WheelTestApp::updateLabels()
 {
-	std::ofstream file( configFilename );
-	if( !file.is_open() )
+	if( labelsVersion == deviceManager.getLayoutVersion() && buttonLabels.size() == static_cast<size_t>( deviceManager.getButtonCount() ) )
 	{
-		logger.log( Logger::ERROR, "Impossible de créer le fichier de configuration: " + configFilename );
-		return ERROR_FILE_OPEN_FAILED;
+		return;
 	}
 
-	// Mettre à jour la config avec les valeurs actuelles
-	config.logFilename         = logFilename;
-	config.logToFile           = logger.isLogToFile();
-	config.verboseLogging      = logger.isVerbose();
-	config.masterForceStrength = deviceManager.getForceManager().getMasterStrength();
-	config.ffbEnabled          = deviceManager.getForceManager().isFFBEnabled();
-
-	// Format simplifié pour cet exemple
-	file << "logFilename=" << config.logFilename << std::endl;
-	file << "logToFile=" << ( config.logToFile ? "true" : "false" ) << std::endl;
-	file << "verboseLogging=" << ( config.verboseLogging ? "true" : "false" ) << std::endl;
-	file << "updateFrequency=" << config.updateFrequency << std::endl;
-	file << "masterForceStrength=" << config.masterForceStrength << std::endl;
-	file << "ffbEnabled=" << ( config.ffbEnabled ? "true" : "false" ) << std::endl;
-
-	logger.log( Logger::INFO, "Configuration sauvegardée dans " + configFilename );
+	// Les identifiants ImGui viennent de PushID: les libellés ne portent que le texte affiché
+	buttonLabels.resize( deviceManager.getButtonCount() );
+	for( int i = 0; i < buttonLabels.size(); ++i )
+	{
+		buttonLabels[i] = i < IM_ARRAYSIZE( defaultButtonNames ) ? defaultButtonNames[i] : std::to_string( i + 1 );
+	}
 
-	return SUCCESS;
+	labelsVersion = deviceManager.getLayoutVersion();
 }
 
 std::string WheelTestApp::getCurrentTimeString()
@@ -1629,102 +7332,213 @@ std::string WheelTestApp::getCurrentTimeString()
 	return ss.str();
 }
 
+bool WheelTestApp::sectionHeader( const char* label, ImGuiTreeNodeFlags flags )
+{
+	const UITheme& theme = themeLibrary.getCurrent();
+
+	ImGui::PushStyleColor( ImGuiCol_Header, theme.sectionHeader );
+	ImGui::PushStyleColor( ImGuiCol_HeaderHovered, theme.sectionHeaderHovered );
+	ImGui::PushStyleColor( ImGuiCol_HeaderActive, theme.sectionHeaderActive );
+	bool open = ImGui::CollapsingHeader( label, flags );
+	ImGui::PopStyleColor( 3 );
+
+	return open;
+}
+
+// Cadre d'un tracé et bande min/max par colonne (columns = 0: cadre seul). Les colonnes identiques
+// consécutives (signal stable) forment un seul rectangle.
+static void drawMinMaxPlot( const ImVec2& origin, const ImVec2& size, const float* mins, const float* maxs, int columns, bool unipolar, ImU32 color )
+{
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	ImVec2      corner( origin.x + size.x, origin.y + size.y );
+	drawList->AddRectFilled( origin, corner, ImGui::GetColorU32( ImGuiCol_FrameBg ), ImGui::GetStyle().FrameRounding );
+
+	float low    = unipolar ? 0.0f : -1.0f;
+	float scaleY = size.y / ( 1.0f - low );
+	if( !unipolar )
+	{
+		drawList->AddLine( ImVec2( origin.x, origin.y + size.y * 0.5f ), ImVec2( corner.x, origin.y + size.y * 0.5f ), ImGui::GetColorU32( ImGuiCol_Border ) );
+	}
+
+	float columnWidth = columns > 0 ? size.x / columns : 0.0f;
+	int   runStart    = -1;
+	for( int column = 0; column <= columns; ++column )
+	{
+		bool sameRun = column < columns && runStart >= 0 && mins[column] == mins[runStart] && maxs[column] == maxs[runStart];
+		if( runStart >= 0 && !sameRun )
+		{
+			float top    = origin.y + ( 1.0f - std::max( low, std::min( 1.0f, maxs[runStart] ) ) ) * scaleY;
+			float bottom = origin.y + ( 1.0f - std::max( low, std::min( 1.0f, mins[runStart] ) ) ) * scaleY;
+			top          = std::min( top, corner.y - 1.0f );
+			drawList->AddRectFilled( ImVec2( origin.x + runStart * columnWidth, top ), ImVec2( origin.x + column * columnWidth, std::max( bottom, top + 1.0f ) ), color );
+			runStart = -1;
+		}
+
+		if( column < columns && runStart < 0 && mins[column] <= maxs[column] )
+		{
+			runStart = column;
+		}
+	}
+}
+
+bool WheelTestApp::drawAxisHistory( const AxisHistory& history, bool unipolar, const ImVec4& color, const ImVec2& size )
+{
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	ImGui::Dummy( size );
+	if( !ImGui::IsRectVisible( size ) )
+	{
+		return false;
+	}
+
+	// Une colonne par pixel: le nombre de sommets dépend de la largeur, pas de la fréquence d'échantillonnage
+	int columns = std::max( 1, static_cast<int>( size.x ) );
+	historyMin.resize( columns );
+	historyMax.resize( columns );
+	bool hasData = history.getColumns( SDL_GetPerformanceCounter(), columns, historyMin.data(), historyMax.data() );
+
+	drawMinMaxPlot( origin, size, historyMin.data(), historyMax.data(), hasData ? columns : 0, unipolar, ImGui::ColorConvertFloat4ToU32( color ) );
+	return true;
+}
+
+void WheelTestApp::startComparison()
+{
+	// La vue de référence est partagée sans copie: une capture relancée pendant le calcul en publie une nouvelle.
+	// Le candidat est chargé et indexé dans la tâche, rien de coûteux ne reste sur le thread de l'interface
+	std::shared_ptr<const RecordingOverview> reference = recordingManager.getSharedOverview();
+	std::string                              filename  = comparisonFilename;
+	float                                    threshold = comparisonThreshold;
+
+	comparisonTask = std::async( std::launch::async, [reference, filename, threshold]() {
+		RecordingManager candidate;
+		if( candidate.loadRecording( filename ) != SUCCESS )
+		{
+			RecordingComparison failed = { false, 0.0, 0.0, 0.0, 0.0, {}, {}, {} };
+			failed.error               = "chargement de " + filename + ": " + candidate.getLastError();
+			return failed;
+		}
+		candidate.waitForOverview();
+
+		const RecordingOverview& overview  = candidate.getOverview();
+		double                   maxOffset = std::max( reference->getEndTime() - reference->getStartTime(), overview.getEndTime() - overview.getStartTime() );
+		return compareRecordings( *reference, overview, threshold, maxOffset );
+	} );
+}
+
+void WheelTestApp::startExport( bool arrow )
+{
+	std::string input = recordingFilename;
+	size_t      dot   = input.find_last_of( '.' );
+	exportFilename    = input.substr( 0, dot ) + ( arrow ? ".arrow" : ".csv" );
+
+	std::string output = exportFilename;
+	exportTask         = std::async( std::launch::async, [input, output, arrow]() {
+		return arrow ? exportRecordingArrow( input, output ) : exportRecordingCSV( input, output );
+	} );
+}
+
+void WheelTestApp::drawRecordingTimeline( float width )
+{
+	const RecordingOverview& overview = recordingManager.getOverview();
+	if( overview.isEmpty() )
+	{
+		return;
+	}
+
+	// Nouvelle capture ou nouveau fichier: afficher tout l'enregistrement
+	double first = overview.getStartTime();
+	double last  = std::max( overview.getEndTime(), first + 0.001 );
+	if( timelineVersion != overview.getVersion() )
+	{
+		timelineStart   = first;
+		timelineEnd     = last;
+		timelineVersion = overview.getVersion();
+	}
+
+	const auto&  axes       = deviceManager.getAxes();
+	const float  laneHeight = 36.0f;
+	int          axisCount  = overview.getAxisCount();
+	ImVec2       size( std::max( 1.0f, width ), laneHeight * axisCount + 4.0f * std::max( 0, axisCount - 1 ) );
+	ImVec2       origin = ImGui::GetCursorScreenPos();
+	ImGuiIO&     io     = ImGui::GetIO();
+
+	ImGui::InvisibleButton( "##timeline", size );
+
+	// Molette: zoom autour du curseur; glisser: déplacement; double-clic: vue complète
+	double span    = timelineEnd - timelineStart;
+	double minSpan = std::max( 0.001, ( last - first ) * 16.0 / overview.getSampleCount() );
+	if( ImGui::IsItemHovered() && io.MouseWheel != 0.0f )
+	{
+		double pivot   = timelineStart + ( io.MousePos.x - origin.x ) / size.x * span;
+		double newSpan = std::max( minSpan, std::min( last - first, span * pow( 0.8, io.MouseWheel ) ) );
+		timelineStart  = pivot - ( pivot - timelineStart ) * newSpan / span;
+		span           = newSpan;
+	}
+	if( ImGui::IsItemActive() && ImGui::IsMouseDragging( 0 ) )
+	{
+		timelineStart -= io.MouseDelta.x / size.x * span;
+	}
+	if( ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked( 0 ) )
+	{
+		timelineStart = first;
+		span          = last - first;
+	}
+	timelineStart = std::max( first, std::min( timelineStart, last - span ) );
+	timelineEnd   = timelineStart + span;
+
+	if( !ImGui::IsRectVisible( size ) )
+	{
+		return;
+	}
+
+	// Une colonne par pixel et par axe, lue au niveau de la pyramide qui correspond au zoom
+	int columns = std::max( 1, static_cast<int>( size.x ) );
+	historyMin.resize( columns );
+	historyMax.resize( columns );
+	timelineLevel = -1;
+	for( int axis = 0; axis < axisCount; ++axis )
+	{
+		ImVec2 laneOrigin( origin.x, origin.y + axis * ( laneHeight + 4.0f ) );
+		int    level    = overview.query( axis, timelineStart, timelineEnd, columns, historyMin.data(), historyMax.data() );
+		bool   unipolar = axis < axes.size() && axes[axis].unipolar;
+		timelineLevel   = std::max( timelineLevel, level );
+
+		drawMinMaxPlot( laneOrigin, ImVec2( size.x, laneHeight ), historyMin.data(), historyMax.data(), level >= 0 ? columns : 0, unipolar,
+						ImGui::GetColorU32( ImGuiCol_PlotLines ) );
+		if( axis < axes.size() )
+		{
+			ImGui::GetWindowDrawList()->AddText( ImVec2( laneOrigin.x + 4.0f, laneOrigin.y + 2.0f ), ImGui::GetColorU32( ImGuiCol_TextDisabled ), axes[axis].name.c_str() );
+		}
+	}
+}
+
 void WheelTestApp::renderUI( SDL_Window* window )
 {
+	Uint64 allocationsAtStart = getThreadAllocationCount();
+	updateLabels();
+
 	// Récupérer la taille de la fenêtre SDL
 	int windowWidth, windowHeight;
 	SDL_GetWindowSize( window, &windowWidth, &windowHeight );
 
-	// Définir les couleurs de l'application
-	ImVec4 primaryColor     = ImVec4( 0.07f, 0.13f, 0.17f, 1.0f ); // Bleu foncé
-	ImVec4 secondaryColor   = ImVec4( 0.11f, 0.22f, 0.33f, 1.0f ); // Bleu intermédiaire
-	ImVec4 accentColor      = ImVec4( 0.0f, 0.47f, 0.84f, 1.0f );  // Bleu vif
-	ImVec4 accentLightColor = ImVec4( 0.2f, 0.6f, 1.0f, 1.0f );    // Bleu plus clair
-	ImVec4 textColor        = ImVec4( 0.9f, 0.9f, 0.9f, 1.0f );    // Blanc cassé
-	ImVec4 mutedTextColor   = ImVec4( 0.7f, 0.7f, 0.7f, 1.0f );    // Gris clair
-	ImVec4 activeColor      = ImVec4( 0.1f, 0.75f, 0.4f, 1.0f );   // Vert
-	ImVec4 activeHoverColor = ImVec4( 0.2f, 0.85f, 0.5f, 1.0f );   // Vert plus clair
-	ImVec4 warningColor     = ImVec4( 1.0f, 0.6f, 0.0f, 1.0f );    // Orange
-	ImVec4 errorColor       = ImVec4( 0.9f, 0.2f, 0.2f, 1.0f );    // Rouge
-
-	// Appliquons un style global
-	ImGuiStyle& style = ImGui::GetStyle();
-
-	// Arrondir les éléments
-	style.WindowRounding    = 8.0f;
-	style.ChildRounding     = 6.0f;
-	style.FrameRounding     = 5.0f;
-	style.PopupRounding     = 5.0f;
-	style.ScrollbarRounding = 5.0f;
-	style.GrabRounding      = 5.0f;
-	style.TabRounding       = 5.0f;
-
-	// Espacement et taille
-	style.WindowPadding    = ImVec2( 12, 12 );
-	style.FramePadding     = ImVec2( 8, 4 );
-	style.ItemSpacing      = ImVec2( 10, 8 );
-	style.ItemInnerSpacing = ImVec2( 8, 6 );
-	style.IndentSpacing    = 22.0f;
-	style.ScrollbarSize    = 14.0f;
-	style.GrabMinSize      = 10.0f;
-
-	// Bordures et couleurs
-	style.WindowBorderSize = 1.0f;
-	style.ChildBorderSize  = 1.0f;
-	style.PopupBorderSize  = 1.0f;
-	style.FrameBorderSize  = 1.0f;
-	style.TabBorderSize    = 1.0f;
+	// Le style ImGui n'est réécrit que lorsque le thème change
+	if( appliedThemeVersion != themeLibrary.getVersion() )
+	{
+		themeLibrary.apply( ImGui::GetStyle() );
+		appliedThemeVersion = themeLibrary.getVersion();
+	}
 
-	// Couleurs du style
-	style.Colors[ImGuiCol_Text]                 = textColor;
-	style.Colors[ImGuiCol_TextDisabled]         = mutedTextColor;
-	style.Colors[ImGuiCol_WindowBg]             = primaryColor;
-	style.Colors[ImGuiCol_ChildBg]              = ImVec4( primaryColor.x + 0.03f, primaryColor.y + 0.03f, primaryColor.z + 0.03f, 1.0f );
-	style.Colors[ImGuiCol_PopupBg]              = secondaryColor;
-	style.Colors[ImGuiCol_Border]               = ImVec4( accentColor.x, accentColor.y, accentColor.z, 0.4f );
-	style.Colors[ImGuiCol_BorderShadow]         = ImVec4( 0.0f, 0.0f, 0.0f, 0.0f );
-	style.Colors[ImGuiCol_FrameBg]              = secondaryColor;
-	style.Colors[ImGuiCol_FrameBgHovered]       = ImVec4( secondaryColor.x + 0.1f, secondaryColor.y + 0.1f, secondaryColor.z + 0.1f, 1.0f );
-	style.Colors[ImGuiCol_FrameBgActive]        = ImVec4( secondaryColor.x + 0.15f, secondaryColor.y + 0.15f, secondaryColor.z + 0.15f, 1.0f );
-	style.Colors[ImGuiCol_TitleBg]              = secondaryColor;
-	style.Colors[ImGuiCol_TitleBgActive]        = accentColor;
-	style.Colors[ImGuiCol_TitleBgCollapsed]     = ImVec4( accentColor.x, accentColor.y, accentColor.z, 0.5f );
-	style.Colors[ImGuiCol_MenuBarBg]            = ImVec4( secondaryColor.x - 0.02f, secondaryColor.y - 0.02f, secondaryColor.z - 0.02f, 1.0f );
-	style.Colors[ImGuiCol_ScrollbarBg]          = ImVec4( secondaryColor.x - 0.05f, secondaryColor.y - 0.05f, secondaryColor.z - 0.05f, 1.0f );
-	style.Colors[ImGuiCol_ScrollbarGrab]        = accentColor;
-	style.Colors[ImGuiCol_ScrollbarGrabHovered] = accentLightColor;
-	style.Colors[ImGuiCol_ScrollbarGrabActive]  = ImVec4( accentLightColor.x + 0.1f, accentLightColor.y + 0.1f, accentLightColor.z + 0.1f, 1.0f );
-	style.Colors[ImGuiCol_CheckMark]            = accentLightColor;
-	style.Colors[ImGuiCol_SliderGrab]           = accentColor;
-	style.Colors[ImGuiCol_SliderGrabActive]     = accentLightColor;
-	style.Colors[ImGuiCol_Button]               = accentColor;
-	style.Colors[ImGuiCol_ButtonHovered]        = accentLightColor;
-	style.Colors[ImGuiCol_ButtonActive]         = ImVec4( accentLightColor.x - 0.1f, accentLightColor.y - 0.1f, accentLightColor.z - 0.1f, 1.0f );
-	style.Colors[ImGuiCol_Header]               = accentColor;
-	style.Colors[ImGuiCol_HeaderHovered]        = accentLightColor;
-	style.Colors[ImGuiCol_HeaderActive]         = ImVec4( accentLightColor.x - 0.1f, accentLightColor.y - 0.1f, accentLightColor.z - 0.1f, 1.0f );
-	style.Colors[ImGuiCol_Separator]            = ImVec4( accentColor.x, accentColor.y, accentColor.z, 0.5f );
-	style.Colors[ImGuiCol_SeparatorHovered]     = ImVec4( accentLightColor.x, accentLightColor.y, accentLightColor.z, 0.5f );
-	style.Colors[ImGuiCol_SeparatorActive]      = ImVec4( accentLightColor.x, accentLightColor.y, accentLightColor.z, 0.7f );
-	style.Colors[ImGuiCol_ResizeGrip]           = ImVec4( accentColor.x, accentColor.y, accentColor.z, 0.25f );
-	style.Colors[ImGuiCol_ResizeGripHovered]    = ImVec4( accentColor.x, accentColor.y, accentColor.z, 0.67f );
-	style.Colors[ImGuiCol_ResizeGripActive]     = accentColor;
-	style.Colors[ImGuiCol_Tab]                  = secondaryColor;
-	style.Colors[ImGuiCol_TabHovered]           = accentColor;
-	style.Colors[ImGuiCol_TabActive]            = ImVec4( accentColor.x + 0.1f, accentColor.y + 0.1f, accentColor.z + 0.1f, 1.0f );
-	style.Colors[ImGuiCol_TabUnfocused]         = ImVec4( secondaryColor.x - 0.1f, secondaryColor.y - 0.1f, secondaryColor.z - 0.1f, 1.0f );
-	style.Colors[ImGuiCol_TabUnfocusedActive]   = secondaryColor;
-	style.Colors[ImGuiCol_PlotLines]            = accentColor;
-	style.Colors[ImGuiCol_PlotLinesHovered]     = accentLightColor;
-	style.Colors[ImGuiCol_PlotHistogram]        = accentColor;
-	style.Colors[ImGuiCol_PlotHistogramHovered] = accentLightColor;
-	style.Colors[ImGuiCol_TableHeaderBg]        = ImVec4( secondaryColor.x + 0.05f, secondaryColor.y + 0.05f, secondaryColor.z + 0.05f, 1.0f );
-	style.Colors[ImGuiCol_TableBorderStrong]    = ImVec4( accentColor.x, accentColor.y, accentColor.z, 0.7f );
-	style.Colors[ImGuiCol_TableBorderLight]     = ImVec4( accentColor.x, accentColor.y, accentColor.z, 0.3f );
-	style.Colors[ImGuiCol_TableRowBg]           = ImVec4( 0.0f, 0.0f, 0.0f, 0.0f );
-	style.Colors[ImGuiCol_TableRowBgAlt]        = ImVec4( 1.0f, 1.0f, 1.0f, 0.06f );
-	//style.Colors[ImGuiCol_ProgressBar]          = accentColor;
-	//style.Colors[ImGuiCol_ProgressBarFill]      = accentLightColor;
+	// Couleurs du thème courant
+	const UITheme& theme            = themeLibrary.getCurrent();
+	const ImVec4&  primaryColor     = theme.primary;
+	const ImVec4&  secondaryColor   = theme.secondary;
+	const ImVec4&  accentColor      = theme.accent;
+	const ImVec4&  accentLightColor = theme.accentLight;
+	const ImVec4&  textColor        = theme.text;
+	const ImVec4&  mutedTextColor   = theme.mutedText;
+	const ImVec4&  activeColor      = theme.active;
+	const ImVec4&  activeHoverColor = theme.activeHover;
+	const ImVec4&  warningColor     = theme.warning;
+	const ImVec4&  errorColor       = theme.error;
 
 	// Définir la fenêtre ImGui pour qu'elle prenne toute la taille
 	ImGui::SetNextWindowPos( ImVec2( 0, 0 ) );
@@ -1767,6 +7581,19 @@ void WheelTestApp::renderUI( SDL_Window* window )
 			{
 				loadConfig();
 			}
+			if( ImGui::BeginMenu( "Thème" ) )
+			{
+				const auto& themes = themeLibrary.getThemes();
+				for( size_t i = 0; i < themes.size(); ++i )
+				{
+					if( ImGui::MenuItem( themes[i].name.c_str(), NULL, i == themeLibrary.getCurrentIndex(), true ) )
+					{
+						themeLibrary.select( i );
+						config.themeName = themes[i].name;
+					}
+				}
+				ImGui::EndMenu();
+			}
 			ImGui::EndMenu();
 		}
 		ImGui::EndMenuBar();
@@ -1784,17 +7611,8 @@ void WheelTestApp::renderUI( SDL_Window* window )
 	ImGui::Spacing();
 
 	// Zone d'informations générales
-	ImGui::PushStyleColor( ImGuiCol_Header, secondaryColor );
-	ImGui::PushStyleColor( ImGuiCol_HeaderHovered, ImVec4( secondaryColor.x + 0.1f, secondaryColor.y + 0.1f, secondaryColor.z + 0.1f, 1.0f ) );
-	ImGui::PushStyleColor( ImGuiCol_HeaderActive, ImVec4( secondaryColor.x + 0.15f, secondaryColor.y + 0.15f, secondaryColor.z + 0.15f, 1.0f ) );
-
-	if( ImGui::CollapsingHeader( "Informations du périphérique", ImGuiTreeNodeFlags_DefaultOpen ) )
+	if( sectionHeader( "Informations du périphérique", ImGuiTreeNodeFlags_DefaultOpen ) )
 	{
-		ImGui::PopStyleColor( 3 );
-
-		// Ajouter une bordure et un fond pour cette section
-		ImGui::PushStyleColor( ImGuiCol_ChildBg, ImVec4( secondaryColor.x - 0.02f, secondaryColor.y - 0.02f, secondaryColor.z - 0.02f, 1.0f ) );
-
 		auto& info = deviceManager.getWheelInfo();
 
 		// Utiliser un layout en deux colonnes pour les informations
@@ -1811,6 +7629,11 @@ void WheelTestApp::renderUI( SDL_Window* window )
 		ImGui::Text( "%d", info.id );
 		ImGui::NextColumn();
 
+		ImGui::TextColored( textColor, "VID:PID:" );
+		ImGui::NextColumn();
+		ImGui::Text( "%04x:%04x", info.vendorId, info.productId );
+		ImGui::NextColumn();
+
 		ImGui::TextColored( textColor, "Nombre de boutons:" );
 		ImGui::NextColumn();
 		ImGui::Text( "%d", info.buttonCount );
@@ -1843,6 +7666,85 @@ void WheelTestApp::renderUI( SDL_Window* window )
 		{
 			ImGui::TextColored( activeColor, "Périphérique réel" );
 		}
+		ImGui::NextColumn();
+
+		// Pédaliers, leviers et freins à main capturés en même temps que le volant
+		const auto& devices      = deviceManager.getDevices();
+		bool        disconnected = std::any_of( devices.begin(), devices.end(), []( const auto& device ) { return !device->joystick; } );
+		if( devices.size() > 1 || disconnected )
+		{
+			ImGui::TextColored( textColor, "Périphériques:" );
+			ImGui::NextColumn();
+			for( const auto& device : devices )
+			{
+				if( device->joystick )
+				{
+					ImGui::Text( "%s (%d axes, %d boutons)", device->info.name.c_str(), device->info.axisCount, device->info.buttonCount );
+				}
+				else
+				{
+					ImGui::TextColored( warningColor, "%s (débranché, reconnexion...)", device->info.name.c_str() );
+				}
+			}
+			ImGui::NextColumn();
+		}
+
+		// Taux de rapport mesuré (événements reçus du périphérique principal)
+		ImGui::TextColored( textColor, "Taux de rapport:" );
+		ImGui::NextColumn();
+		PollingStats polling = pollingMeter.getStats();
+		if( pollingMeter.hasResults() )
+		{
+			ImGui::TextColored( accentLightColor, "%.0f Hz", polling.reportRate );
+		}
+		else if( pollingMeter.isRunning() )
+		{
+			ImGui::TextColored( warningColor, "Bougez le volant ou les pédales..." );
+		}
+		else
+		{
+			ImGui::TextColored( mutedTextColor, "Non mesuré" );
+		}
+
+		ImGui::SameLine();
+		if( ImGui::SmallButton( pollingMeter.isRunning() ? "Arrêter##rapport" : "Mesurer##rapport" ) )
+		{
+			if( pollingMeter.isRunning() )
+			{
+				pollingMeter.stop();
+				logger.log( Logger::INFO, "Taux de rapport mesuré: " + std::to_string( static_cast<int>( pollingMeter.getStats().reportRate ) ) + " Hz" );
+			}
+			else
+			{
+				// Le volant simulé du mode démo ne publie pas de rapports USB
+				const auto& devices = deviceManager.getDevices();
+				if( deviceManager.isUsingDemo() || devices.empty() || !devices.front()->joystick )
+				{
+					logger.log( Logger::WARNING, "Taux de rapport: aucun périphérique réel à mesurer" );
+				}
+				else if( pollingMeter.start( devices.front()->instanceId ) != SUCCESS )
+				{
+					logger.log( Logger::WARNING, "Taux de rapport: impossible de mesurer " + devices.front()->info.name );
+				}
+			}
+		}
+		ImGui::NextColumn();
+
+		if( pollingMeter.hasResults() )
+		{
+			ImGui::TextColored( textColor, "Intervalles:" );
+			ImGui::NextColumn();
+			ImGui::Text( "moy. %.3f ms  p50 %.3f ms  p99 %.3f ms  max %.3f ms", polling.meanMs, polling.p50Ms, polling.p99Ms, polling.maxMs );
+
+			// Distribution jusqu'à deux fois le p99
+			double rangeMs = std::max( 0.1, polling.p99Ms * 2.0 );
+			pollingMeter.getDisplayHistogram( pollingBars, 50, rangeMs );
+
+			char overlay[64];
+			snprintf( overlay, sizeof( overlay ), "0 .. %.2f ms", rangeMs );
+			ImGui::PlotHistogram( "##intervallesRapport", pollingBars.data(), static_cast<int>( pollingBars.size() ), 0, overlay, 0.0f, FLT_MAX, ImVec2( ImGui::GetContentRegionAvail().x, 60 ) );
+			ImGui::NextColumn();
+		}
 		ImGui::Columns( 1 );
 
 		ImGui::Spacing();
@@ -1855,34 +7757,26 @@ void WheelTestApp::renderUI( SDL_Window* window )
 			deviceManager.reloadDevice( logger );
 			logger.log( Logger::INFO, "Informations du périphérique actualisées" );
 		}
-
-		ImGui::PopStyleColor();
-	}
-	else
-	{
-		ImGui::PopStyleColor( 3 );
 	}
 
 	// Zone des axes avec graphiques
-	ImGui::PushStyleColor( ImGuiCol_Header, secondaryColor );
-	ImGui::PushStyleColor( ImGuiCol_HeaderHovered, ImVec4( secondaryColor.x + 0.1f, secondaryColor.y + 0.1f, secondaryColor.z + 0.1f, 1.0f ) );
-	ImGui::PushStyleColor( ImGuiCol_HeaderActive, ImVec4( secondaryColor.x + 0.15f, secondaryColor.y + 0.15f, secondaryColor.z + 0.15f, 1.0f ) );
-
-	if( ImGui::CollapsingHeader( "Axes", ImGuiTreeNodeFlags_DefaultOpen ) )
+	bool historyScrolling = false;
+	if( sectionHeader( "Axes", ImGuiTreeNodeFlags_DefaultOpen ) )
 	{
-		ImGui::PopStyleColor( 3 );
-
-		ImGui::PushStyleColor( ImGuiCol_ChildBg, ImVec4( secondaryColor.x - 0.02f, secondaryColor.y - 0.02f, secondaryColor.z - 0.02f, 1.0f ) );
-
 		auto& axes = deviceManager.getAxes();
 
+		ImGui::Checkbox( "Historique", &showAxisHistory );
+		if( showAxisHistory && !axes.empty() )
+		{
+			const AxisHistory* history = deviceManager.getAxisHistory( 0 );
+			ImGui::SameLine();
+			ImGui::TextColored( mutedTextColor, "%.0f dernières secondes, min/max par pixel", history ? history->getDuration() : 0.0 );
+		}
+
 		for( int i = 0; i < axes.size(); ++i )
 		{
 			auto& axis = axes[i];
 
-			// Cadre pour chaque axe
-			ImGui::PushStyleColor( ImGuiCol_ChildBg, ImVec4( primaryColor.x + 0.02f, primaryColor.y + 0.02f, primaryColor.z + 0.02f, 1.0f ) );
-
 			// Nom et valeur de l'axe
 			ImGui::TextColored( accentLightColor, "%s:", axis.name.c_str() );
 			ImGui::SameLine( 150 );
@@ -1892,8 +7786,8 @@ void WheelTestApp::renderUI( SDL_Window* window )
 			char overlay[32];
 			sprintf( overlay, "%.2f", axis.value );
 
-			// Normaliser la valeur pour la barre de progression
-			float normalized = ( axis.value - axis.min ) / ( axis.max - axis.min );
+			// La valeur est déjà calibrée: 0..1 pour une pédale, -1..1 pour un axe centré
+			float normalized = axis.unipolar ? axis.value : ( axis.value + 1.0f ) * 0.5f;
 			normalized       = std::max( 0.0f, std::min( 1.0f, normalized ) ); // Limiter entre 0 et 1
 
 			// Choisir la couleur en fonction de la valeur
@@ -1939,23 +7833,66 @@ void WheelTestApp::renderUI( SDL_Window* window )
 			ImGui::ProgressBar( normalized, ImVec2( -1, 20 ), overlay );
 			ImGui::PopStyleColor();
 
-			// Afficher des boutons pour les options
+			// Tracé défilant: les pics entre deux images restent visibles
+			const AxisHistory* history = deviceManager.getAxisHistory( i );
+			if( showAxisHistory && history )
+			{
+				if( drawAxisHistory( *history, axis.unipolar, barColor, ImVec2( ImGui::GetContentRegionAvail().x, 48.0f ) ) &&
+					history->isScrolling( SDL_GetPerformanceCounter() ) )
+				{
+					historyScrolling = true;
+				}
+			}
+
+			// Calibration en cours (plusieurs axes peuvent être calibrés en même temps)
+			const AxisCalibrator* calibrator = deviceManager.getCalibrator( i );
+			if( calibrator && calibrator->isActive() )
+			{
+				ImGui::PushID( i );
+				if( calibrator->getState() == AxisCalibrator::SETTLING )
+				{
+					ImGui::TextColored( warningColor, "Calibration: laissez l'axe au repos..." );
+				}
+				else
+				{
+					ImGui::TextColored( warningColor, "Calibration: déplacez l'axe sur toute sa course" );
+					ImGui::Text( "Brut min %d / max %d, centre %.0f, bruit %.1f (%llu échantillons)", calibrator->getRawMin(), calibrator->getRawMax(),
+								 calibrator->getCenter(), calibrator->getNoise(), static_cast<unsigned long long>( calibrator->getSampleCount() ) );
+				}
+
+				if( ImGui::Button( "Terminer", ImVec2( 100, 20 ) ) )
+				{
+					deviceManager.finishCalibration( i, logger );
+				}
+				ImGui::SameLine();
+				if( ImGui::Button( "Annuler", ImVec2( 100, 20 ) ) )
+				{
+					deviceManager.cancelCalibration( i );
+				}
+				ImGui::PopID();
+			}
+
+			// Afficher des boutons pour les options (identifiants propres à l'axe)
+			ImGui::PushID( i );
 			ImGui::PushStyleVar( ImGuiStyleVar_FrameRounding, 12.0f );
 			ImGui::PushStyleColor( ImGuiCol_Button, ImVec4( secondaryColor.x + 0.05f, secondaryColor.y + 0.05f, secondaryColor.z + 0.05f, 1.0f ) );
 
 			if( ImGui::Button( "Options", ImVec2( 80, 20 ) ) )
 			{
-				ImGui::OpenPopup( ( "Options##" + std::to_string( i ) ).c_str() );
+				ImGui::OpenPopup( "Options" );
 			}
 
 			ImGui::PopStyleColor();
 			ImGui::PopStyleVar();
 
-			if( ImGui::BeginPopup( ( "Options##" + std::to_string( i ) ).c_str() ) )
+			if( ImGui::BeginPopup( "Options" ) )
 			{
 				ImGui::SliderFloat( "Zone morte", &axis.deadzone, 0.0f, 0.5f );
 				ImGui::DragFloat( "Valeur minimum", &axis.min, 0.1f );
 				ImGui::DragFloat( "Valeur maximum", &axis.max, 0.1f );
+				ImGui::SliderFloat( "Courbe", &axis.curve, 0.2f, 5.0f, "%.2f" );
+				ImGui::SliderFloat( "Saturation", &axis.saturation, 0.5f, 1.0f, "%.2f" );
+				ImGui::Checkbox( "Inverser", &axis.inverted );
 				ImGui::Text( "Valeur brute: %.2f", axis.rawValue );
 
 				if( ImGui::Button( "Calibrer", ImVec2( 100, 24 ) ) )
@@ -1963,39 +7900,60 @@ void WheelTestApp::renderUI( SDL_Window* window )
 					deviceManager.calibrateAxis( i, logger );
 				}
 
+				// Qualité du signal mesurée sur le flux brut
+				AxisSignalAnalyzer* analyzer = deviceManager.getSignalAnalyzer( i );
+				if( analyzer )
+				{
+					ImGui::Separator();
+					ImGui::TextColored( accentLightColor, "Qualité du signal" );
+
+					AxisSignalStats signal = analyzer->getStats();
+					if( signal.sampleCount == 0 )
+					{
+						ImGui::TextColored( mutedTextColor, "Aucun échantillon" );
+					}
+					else
+					{
+						ImGui::Text( "Échantillons: %llu", static_cast<unsigned long long>( signal.sampleCount ) );
+						ImGui::Text( "Moyenne: %.1f   Écart type: %.2f", signal.mean, signal.stdDev );
+						ImGui::Text( "Plage: %d .. %d", signal.rawMin, signal.rawMax );
+						ImGui::Text( "Valeurs distinctes: %u (%.1f bits)", signal.distinctValues, signal.effectiveBits );
+						ImGui::Text( "Pas de quantification: %d (%.1f bits)", signal.quantizationStep, signal.resolutionBits );
+						ImGui::Text( "Saut maximum: %d   Gigue: %.2f", signal.maxStep, signal.jitter );
+						ImGui::TextColored( signal.spikeCount > 0 ? warningColor : textColor, "Pics: %u", signal.spikeCount );
+					}
+
+					int spikeThreshold = analyzer->getSpikeThreshold();
+					if( ImGui::SliderInt( "Seuil de pic", &spikeThreshold, 64, 16384 ) )
+					{
+						analyzer->setSpikeThreshold( spikeThreshold );
+					}
+
+					if( ImGui::Button( "Réinitialiser##signal", ImVec2( 100, 24 ) ) )
+					{
+						analyzer->reset();
+					}
+				}
+
 				ImGui::EndPopup();
 			}
-
-			ImGui::PopStyleColor();
+			ImGui::PopID();
 		}
-
-		ImGui::PopStyleColor();
 	}
-	else
+
+	// Les tracés défilants demandent un rendu régulier tant qu'ils sont visibles et changent encore
+	axisHistoryScrolling = historyScrolling;
+	if( historyScrolling )
 	{
-		ImGui::PopStyleColor( 3 );
+		lastHistoryRender = SDL_GetTicks();
 	}
 
 	// Zone des boutons
-	ImGui::PushStyleColor( ImGuiCol_Header, secondaryColor );
-	ImGui::PushStyleColor( ImGuiCol_HeaderHovered, ImVec4( secondaryColor.x + 0.1f, secondaryColor.y + 0.1f, secondaryColor.z + 0.1f, 1.0f ) );
-	ImGui::PushStyleColor( ImGuiCol_HeaderActive, ImVec4( secondaryColor.x + 0.15f, secondaryColor.y + 0.15f, secondaryColor.z + 0.15f, 1.0f ) );
-
-	if( ImGui::CollapsingHeader( "Boutons", ImGuiTreeNodeFlags_DefaultOpen ) )
+	if( sectionHeader( "Boutons", ImGuiTreeNodeFlags_DefaultOpen ) )
 	{
-		ImGui::PopStyleColor( 3 );
-
-		ImGui::PushStyleColor( ImGuiCol_ChildBg, ImVec4( secondaryColor.x - 0.02f, secondaryColor.y - 0.02f, secondaryColor.z - 0.02f, 1.0f ) );
-
-		auto&       buttons       = deviceManager.getButtons();
-		const char* buttonNames[] = {
-			"X", "Square", "Circle", "Triangle",
-			"L1", "R1", "L2", "R2",
-			"Share", "Options", "L3", "R3",
-			"PS", "TouchPad", "Up", "Down",
-			"Left", "Right", "1", "2",
-			"3", "4", "5", "6", "7", "8", "9", "10", "11", "12"
-		};
+		const auto& buttons       = deviceManager.getButtons();
+		const auto& buttonTaps    = deviceManager.getButtonTaps();
+		int         buttonCount   = std::min( deviceManager.getButtonCount(), static_cast<int>( buttonLabels.size() ) );
 
 		ImGui::TextColored( accentLightColor, "État des boutons:" );
 		ImGui::Spacing();
@@ -2008,17 +7966,13 @@ void WheelTestApp::renderUI( SDL_Window* window )
 		ImGui::SetColumnWidth( 3, windowWidth / 6 );
 		ImGui::SetColumnWidth( 4, windowWidth / 6 );
 
-		for( int i = 0; i < buttons.size(); ++i )
-		{
-			// Obtenir le nom du bouton
-			std::string name;
-			if( i < IM_ARRAYSIZE( buttonNames ) )
-				name = buttonNames[i];
-			else
-				name = std::to_string( i + 1 );
+		// Appuis plus courts qu'une frame inclus
+		ButtonBits shown = buttons | buttonTaps;
 
+		for( int i = 0; i < buttonCount; ++i )
+		{
 			// Style pour les boutons actifs/inactifs
-			if( buttons[i] )
+			if( shown.test( i ) )
 			{
 				ImGui::PushStyleColor( ImGuiCol_Button, activeColor );
 				ImGui::PushStyleColor( ImGuiCol_ButtonHovered, activeHoverColor );
@@ -2035,71 +7989,155 @@ void WheelTestApp::renderUI( SDL_Window* window )
 
 			// Bouton avec une taille fixe et des coins arrondis
 			ImGui::PushStyleVar( ImGuiStyleVar_FrameRounding, 15.0f );
-			ImGui::Button( ( name + "##" + std::to_string( i ) ).c_str(), ImVec2( -1, 30 ) );
+			ImGui::PushID( i );
+			ImGui::Button( buttonLabels[i].c_str(), ImVec2( -1, 30 ) );
+			ImGui::PopID();
 			ImGui::PopStyleVar();
 			ImGui::PopStyleColor( 4 );
 
 			ImGui::NextColumn();
 		}
-		ImGui::Columns( 1 );
+		ImGui::Columns( 1 );
+
+		// Affichage des boutons actuellement pressés
+		ImGui::Spacing();
+		ImGui::Separator();
+		ImGui::Spacing();
+
+		ImGui::TextColored( accentLightColor, "Boutons actifs:" );
+		ImGui::SameLine();
+
+		// Parcourir uniquement les bits à 1
+		bool anyButtonActive = false;
+		for( int i = buttons.findNext( 0 ); i >= 0 && i < buttonCount; i = buttons.findNext( i + 1 ) )
+		{
+			if( anyButtonActive )
+			{
+				ImGui::SameLine( 0, 5 );
+				ImGui::TextColored( activeColor, " | %s", buttonLabels[i].c_str() );
+			}
+			else
+			{
+				ImGui::SameLine( 0, 5 );
+				ImGui::TextColored( activeColor, "%s", buttonLabels[i].c_str() );
+			}
+			anyButtonActive = true;
+		}
+
+		if( !anyButtonActive )
+		{
+			ImGui::SameLine();
+			ImGui::TextColored( mutedTextColor, "Aucun" );
+		}
 
-		// Affichage des boutons actuellement pressés
-		ImGui::Spacing();
-		ImGui::Separator();
+		// Analyse des fronts: appuis, maintien, intervalles et rebonds
 		ImGui::Spacing();
+		if( ImGui::TreeNode( "Analyse des appuis" ) )
+		{
+			float bounceWindowMs = buttonAnalyzer.getBounceWindowMs();
+			ImGui::SetNextItemWidth( 150 );
+			if( ImGui::SliderFloat( "Fenêtre de rebond", &bounceWindowMs, 1.0f, 50.0f, "%.0f ms" ) )
+			{
+				buttonAnalyzer.setBounceWindowMs( bounceWindowMs );
+			}
 
-		ImGui::TextColored( accentLightColor, "Boutons actifs:" );
-		ImGui::SameLine();
+			ImGui::SameLine();
+			if( ImGui::Button( "Réinitialiser##analyse" ) )
+			{
+				buttonAnalyzer.reset();
+				analyzedButton = -1;
+			}
 
-		bool anyButtonActive = false;
-		for( int i = 0; i < buttons.size(); ++i )
-		{
-			if( buttons[i] )
+			ImGui::SameLine();
+			if( ImGui::Button( "Exporter CSV##analyse" ) )
 			{
-				std::string name;
-				if( i < IM_ARRAYSIZE( buttonNames ) )
-					name = buttonNames[i];
+				std::string filename = "buttons_" + getCurrentTimeString() + ".csv";
+				if( buttonAnalyzer.exportCSV( filename, buttonCount ) == SUCCESS )
+				{
+					logger.log( Logger::INFO, "Analyse des boutons exportée dans " + filename );
+				}
 				else
-					name = std::to_string( i + 1 );
+				{
+					logger.log( Logger::ERROR, "Erreur lors de l'export de l'analyse des boutons" );
+				}
+			}
 
-				if( anyButtonActive )
+			if( !buttonAnalyzer.hasData() )
+			{
+				ImGui::TextColored( mutedTextColor, "Aucune transition reçue" );
+			}
+			else if( ImGui::BeginTable( "AnalyseBoutons", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg ) )
+			{
+				ImGui::TableSetupColumn( "Bouton", ImGuiTableColumnFlags_WidthFixed, 90.0f );
+				ImGui::TableSetupColumn( "Appuis", ImGuiTableColumnFlags_WidthStretch );
+				ImGui::TableSetupColumn( "Rebonds", ImGuiTableColumnFlags_WidthStretch );
+				ImGui::TableSetupColumn( "Maintien moy. (ms)", ImGuiTableColumnFlags_WidthStretch );
+				ImGui::TableSetupColumn( "Maintien min/max", ImGuiTableColumnFlags_WidthStretch );
+				ImGui::TableSetupColumn( "Intervalle moy. (ms)", ImGuiTableColumnFlags_WidthStretch );
+				ImGui::TableSetupColumn( "Intervalle min", ImGuiTableColumnFlags_WidthStretch );
+				ImGui::TableHeadersRow();
+
+				for( int i = 0; i < buttonCount; ++i )
 				{
-					ImGui::SameLine( 0, 5 );
-					ImGui::TextColored( activeColor, " | %s", name.c_str() );
+					const auto& timing = buttonAnalyzer.getStats( i );
+					if( timing.edgeCount == 0 )
+					{
+						continue;
+					}
+
+					ImGui::TableNextRow();
+
+					// Sélectionner une ligne pour afficher ses histogrammes
+					ImGui::TableNextColumn();
+					ImGui::PushID( i );
+					if( ImGui::Selectable( buttonLabels[i].c_str(), analyzedButton == i, ImGuiSelectableFlags_SpanAllColumns ) )
+					{
+						analyzedButton = analyzedButton == i ? -1 : i;
+					}
+					ImGui::PopID();
+
+					ImGui::TableNextColumn();
+					ImGui::Text( "%u", timing.pressCount );
+					ImGui::TableNextColumn();
+					ImGui::TextColored( timing.bounceCount > 0 ? warningColor : textColor, "%u", timing.bounceCount );
+					ImGui::TableNextColumn();
+					ImGui::Text( "%.1f", timing.holdTimes.getMeanMs() );
+					ImGui::TableNextColumn();
+					ImGui::Text( "%.1f / %.1f", timing.holdTimes.minMs, timing.holdTimes.maxMs );
+					ImGui::TableNextColumn();
+					ImGui::Text( "%.1f", timing.pressIntervals.getMeanMs() );
+					ImGui::TableNextColumn();
+					ImGui::Text( "%.1f", timing.pressIntervals.minMs );
 				}
-				else
+
+				ImGui::EndTable();
+			}
+
+			// Histogrammes du bouton sélectionné (classes en puissances de deux)
+			if( analyzedButton >= 0 && analyzedButton < buttonCount )
+			{
+				const auto& timing = buttonAnalyzer.getStats( analyzedButton );
+				float       holdBins[DURATION_HISTOGRAM_BINS];
+				float       intervalBins[DURATION_HISTOGRAM_BINS];
+				for( int bin = 0; bin < DURATION_HISTOGRAM_BINS; ++bin )
 				{
-					ImGui::SameLine( 0, 5 );
-					ImGui::TextColored( activeColor, "%s", name.c_str() );
+					holdBins[bin]     = static_cast<float>( timing.holdTimes.bins[bin] );
+					intervalBins[bin] = static_cast<float>( timing.pressIntervals.bins[bin] );
 				}
-				anyButtonActive = true;
+
+				float graphWidth = ( ImGui::GetContentRegionAvail().x - 10 ) * 0.5f;
+				ImGui::PlotHistogram( "##maintien", holdBins, DURATION_HISTOGRAM_BINS, 0, "Maintien (1 ms .. 16 s)", 0.0f, FLT_MAX, ImVec2( graphWidth, 80 ) );
+				ImGui::SameLine();
+				ImGui::PlotHistogram( "##intervalles", intervalBins, DURATION_HISTOGRAM_BINS, 0, "Intervalles (1 ms .. 16 s)", 0.0f, FLT_MAX, ImVec2( graphWidth, 80 ) );
 			}
-		}
 
-		if( !anyButtonActive )
-		{
-			ImGui::SameLine();
-			ImGui::TextColored( mutedTextColor, "Aucun" );
+			ImGui::TreePop();
 		}
-
-		ImGui::PopStyleColor();
-	}
-	else
-	{
-		ImGui::PopStyleColor( 3 );
 	}
 
 	// Zone de retour de force
-	ImGui::PushStyleColor( ImGuiCol_Header, secondaryColor );
-	ImGui::PushStyleColor( ImGuiCol_HeaderHovered, ImVec4( secondaryColor.x + 0.1f, secondaryColor.y + 0.1f, secondaryColor.z + 0.1f, 1.0f ) );
-	ImGui::PushStyleColor( ImGuiCol_HeaderActive, ImVec4( secondaryColor.x + 0.15f, secondaryColor.y + 0.15f, secondaryColor.z + 0.15f, 1.0f ) );
-
-	if( ImGui::CollapsingHeader( "Retour de Force", ImGuiTreeNodeFlags_DefaultOpen ) )
+	if( sectionHeader( "Retour de Force", ImGuiTreeNodeFlags_DefaultOpen ) )
 	{
-		ImGui::PopStyleColor( 3 );
-
-		ImGui::PushStyleColor( ImGuiCol_ChildBg, ImVec4( secondaryColor.x - 0.02f, secondaryColor.y - 0.02f, secondaryColor.z - 0.02f, 1.0f ) );
-
 		auto& forceManager = deviceManager.getForceManager();
 		auto& effects      = forceManager.getEffects();
 
@@ -2114,20 +8152,27 @@ void WheelTestApp::renderUI( SDL_Window* window )
 			logger.log( Logger::INFO, "Retour de force " + std::string( ffbEnabled ? "activé" : "désactivé" ) );
 		}
 
+		bool softwareMixing = forceManager.isSoftwareMixing();
+		if( ImGui::Checkbox( "Mixage logiciel (un seul effet matériel)", &softwareMixing ) )
+		{
+			forceManager.setSoftwareMixing( softwareMixing, logger );
+		}
+
 		ImGui::PopStyleColor( 2 );
 
+		if( forceManager.isSoftwareMixing() )
+		{
+			ImGui::SameLine();
+			ImGui::TextColored( mutedTextColor, "Sortie: %+.0f%%", forceManager.getMixerOutput() * 100.0f / 32767.0f );
+		}
+
 		// Réglage de la force globale avec un curseur amélioré
 		float masterStrength = forceManager.getMasterStrength();
-		ImGui::PushStyleColor( ImGuiCol_SliderGrab, accentColor );
-		ImGui::PushStyleColor( ImGuiCol_SliderGrabActive, accentLightColor );
-
 		if( ImGui::SliderFloat( "Force globale", &masterStrength, 0.0f, 100.0f, "%.0f%%" ) )
 		{
 			forceManager.setMasterStrength( masterStrength );
 		}
 
-		ImGui::PopStyleColor( 2 );
-
 		ImGui::Spacing();
 		ImGui::Separator();
 		ImGui::Spacing();
@@ -2151,6 +8196,7 @@ void WheelTestApp::renderUI( SDL_Window* window )
 			{
 				auto& effect = effects[i];
 				ImGui::TableNextRow();
+				ImGui::PushID( i );
 
 				// Nom de l'effet
 				ImGui::TableNextColumn();
@@ -2160,7 +8206,7 @@ void WheelTestApp::renderUI( SDL_Window* window )
 				ImGui::TableNextColumn();
 				ImGui::PushStyleColor( ImGuiCol_CheckMark, activeColor );
 
-				if( ImGui::Checkbox( ( "##effect" + std::to_string( i ) ).c_str(), &effect.enabled ) )
+				if( ImGui::Checkbox( "##effect", &effect.enabled ) )
 				{
 					logger.log( Logger::DEBUG, "Effet " + effect.name + ( effect.enabled ? " activé" : " désactivé" ) );
 				}
@@ -2169,28 +8215,20 @@ void WheelTestApp::renderUI( SDL_Window* window )
 
 				// Force
 				ImGui::TableNextColumn();
-				ImGui::PushStyleColor( ImGuiCol_SliderGrab, accentColor );
-				ImGui::PushStyleColor( ImGuiCol_SliderGrabActive, accentLightColor );
-
-				ImGui::SliderFloat( ( "##strength" + std::to_string( i ) ).c_str(), &effect.strength, 0.0f, 100.0f, "%.0f%%" );
-
-				ImGui::PopStyleColor( 2 );
+				ImGui::SliderFloat( "##strength", &effect.strength, 0.0f, 100.0f, "%.0f%%" );
 
 				// Durée (si applicable)
 				ImGui::TableNextColumn();
 				if( effect.duration > 0.0f )
 				{
-					ImGui::PushStyleColor( ImGuiCol_SliderGrab, accentColor );
-					ImGui::PushStyleColor( ImGuiCol_SliderGrabActive, accentLightColor );
-
-					ImGui::SliderFloat( ( "##duration" + std::to_string( i ) ).c_str(), &effect.duration, 0.1f, 5.0f, "%.1fs" );
-
-					ImGui::PopStyleColor( 2 );
+					ImGui::SliderFloat( "##duration", &effect.duration, 0.1f, 5.0f, "%.1fs" );
 				}
 				else
 				{
 					ImGui::TextColored( mutedTextColor, "N/A" );
 				}
+
+				ImGui::PopID();
 			}
 			ImGui::EndTable();
 		}
@@ -2265,24 +8303,73 @@ void WheelTestApp::renderUI( SDL_Window* window )
 		ImGui::PopStyleColor( 2 );
 		ImGui::PopStyleVar();
 
-		ImGui::PopStyleColor();
-	}
-	else
-	{
-		ImGui::PopStyleColor( 3 );
-	}
+		ImGui::Spacing();
+		ImGui::Separator();
+		ImGui::Spacing();
 
-	// Zone des réglages de test
-	ImGui::PushStyleColor( ImGuiCol_Header, secondaryColor );
-	ImGui::PushStyleColor( ImGuiCol_HeaderHovered, ImVec4( secondaryColor.x + 0.1f, secondaryColor.y + 0.1f, secondaryColor.z + 0.1f, 1.0f ) );
-	ImGui::PushStyleColor( ImGuiCol_HeaderActive, ImVec4( secondaryColor.x + 0.15f, secondaryColor.y + 0.15f, secondaryColor.z + 0.15f, 1.0f ) );
+		// Mesure de la latence aller-retour (échelon de force -> mouvement de l'axe de direction)
+		ImGui::TextColored( accentLightColor, "Mesure de latence:" );
+		ImGui::SliderInt( "Répétitions", &latencyIterations, 5, 200 );
+		ImGui::SliderFloat( "Force de l'échelon", &latencyStepLevel, 5.0f, 100.0f, "%.0f%%" );
+		ImGui::SliderFloat( "Seuil de mouvement", &latencyThreshold, 0.1f, 10.0f, "%.1f%%" );
 
-	if( ImGui::CollapsingHeader( "Réglages de test" ) )
-	{
-		ImGui::PopStyleColor( 3 );
+		if( deviceManager.isUsingDemo() )
+		{
+			float simulatedLatency = deviceManager.getSimulatedWheel().getLatency();
+			if( ImGui::SliderFloat( "Latence simulée", &simulatedLatency, 0.0f, 100.0f, "%.0f ms" ) )
+			{
+				deviceManager.getSimulatedWheel().setLatency( simulatedLatency );
+			}
+		}
+
+		ImGui::SetCursorPosX( ( ImGui::GetWindowWidth() - 200 ) * 0.5f );
+		ImGui::PushStyleVar( ImGuiStyleVar_FrameRounding, 8.0f );
+
+		if( latencyTester.isRunning() )
+		{
+			ImGui::PushStyleColor( ImGuiCol_Button, errorColor );
+			ImGui::PushStyleColor( ImGuiCol_ButtonHovered, ImVec4( errorColor.x + 0.1f, errorColor.y + 0.1f, errorColor.z + 0.1f, 1.0f ) );
+
+			if( ImGui::Button( "Arrêter la mesure", ImVec2( 200, 30 ) ) )
+			{
+				latencyTester.stop( forceManager, logger );
+			}
+
+			ImGui::PopStyleColor( 2 );
+
+			ImGui::PushStyleColor( ImGuiCol_PlotHistogram, accentColor );
+			ImGui::ProgressBar( static_cast<float>( latencyTester.getCompleted() ) / latencyTester.getIterations(), ImVec2( -1, 15 ) );
+			ImGui::PopStyleColor();
+		}
+		else
+		{
+			ImGui::PushStyleColor( ImGuiCol_Button, activeColor );
+			ImGui::PushStyleColor( ImGuiCol_ButtonHovered, activeHoverColor );
+
+			if( ImGui::Button( "Mesurer la latence", ImVec2( 200, 30 ) ) )
+			{
+				latencyTester.start( latencyIterations, latencyStepLevel / 100.0f, latencyThreshold / 100.0f, deviceManager.getSampler(), logger );
+			}
+
+			ImGui::PopStyleColor( 2 );
+		}
+
+		ImGui::PopStyleVar();
+
+		if( latencyTester.hasResults() )
+		{
+			const LatencyStats& latency = latencyTester.getStats();
 
-		ImGui::PushStyleColor( ImGuiCol_ChildBg, ImVec4( secondaryColor.x - 0.02f, secondaryColor.y - 0.02f, secondaryColor.z - 0.02f, 1.0f ) );
+			ImGui::TextColored( textColor, "Min: %.2f ms   Médiane: %.2f ms   P99: %.2f ms   Max: %.2f ms",
+								latency.minMs, latency.medianMs, latency.p99Ms, latency.maxMs );
+			ImGui::TextColored( latency.timeouts > 0 ? warningColor : mutedTextColor, "Mesures: %d   Sans mouvement: %d",
+								latency.count, latency.timeouts );
+		}
+	}
 
+	// Zone des réglages de test
+	if( sectionHeader( "Réglages de test" ) )
+	{
 		ImGui::TextColored( accentLightColor, "Sélection du mode de test:" );
 		ImGui::PushStyleColor( ImGuiCol_FrameBg, ImVec4( secondaryColor.x + 0.05f, secondaryColor.y + 0.05f, secondaryColor.z + 0.05f, 1.0f ) );
 
@@ -2336,11 +8423,7 @@ void WheelTestApp::renderUI( SDL_Window* window )
 				changed |= ImGui::Checkbox( "Tester le retour de force", &autoFFBTest );
 				ImGui::PopStyleColor();
 
-				ImGui::PushStyleColor( ImGuiCol_SliderGrab, accentColor );
-				ImGui::PushStyleColor( ImGuiCol_SliderGrabActive, accentLightColor );
 				changed |= ImGui::SliderFloat( "Durée du test (secondes)", &testDuration, 5.0f, 120.0f, "%.0fs" );
-				ImGui::PopStyleColor( 2 );
-
 				if( changed )
 				{
 					autoTestManager.setTestOptions( autoButtonTest, autoAxisTest, autoFFBTest, testDuration );
@@ -2439,6 +8522,8 @@ void WheelTestApp::renderUI( SDL_Window* window )
 
 					if( ImGui::Button( "Commencer l'enregistrement", ImVec2( 180, 30 ) ) )
 					{
+						// L'analyse du signal exportée avec l'enregistrement couvre la même période
+						deviceManager.resetSignalAnalysis();
 						recordingManager.startRecording();
 						logger.log( Logger::INFO, "Enregistrement démarré" );
 					}
@@ -2470,6 +8555,14 @@ void WheelTestApp::renderUI( SDL_Window* window )
 							if( result == SUCCESS )
 							{
 								logger.log( Logger::INFO, "Enregistrement sauvegardé dans " + filename );
+								strncpy( recordingFilename, filename.c_str(), sizeof( recordingFilename ) - 1 );
+
+								// Qualité du signal à côté de l'enregistrement
+								std::string signalFilename = filename.substr( 0, filename.size() - 4 ) + "_signal.csv";
+								if( deviceManager.exportSignalAnalysis( signalFilename ) != SUCCESS )
+								{
+									logger.log( Logger::WARNING, "Impossible d'exporter la qualité du signal dans " + signalFilename );
+								}
 							}
 							else
 							{
@@ -2481,29 +8574,308 @@ void WheelTestApp::renderUI( SDL_Window* window )
 					}
 
 					ImGui::PopStyleVar();
+
+					// Recharger une capture sauvegardée
+					ImGui::Spacing();
+					ImGui::SetNextItemWidth( 300 );
+					ImGui::InputText( "##fichierEnregistrement", recordingFilename, IM_ARRAYSIZE( recordingFilename ) );
+					ImGui::SameLine();
+					if( ImGui::Button( "Charger", ImVec2( 100, 0 ) ) && recordingFilename[0] != '\0' )
+					{
+						if( recordingManager.loadRecording( recordingFilename ) == SUCCESS )
+						{
+							logger.log( Logger::INFO, "Enregistrement chargé depuis " + std::string( recordingFilename ) );
+						}
+						else
+						{
+							logger.log( Logger::ERROR, "Impossible de charger l'enregistrement " + std::string( recordingFilename ) + ": " +
+														   recordingManager.getLastError() );
+						}
+					}
+
+					// Export du fichier pour les outils d'analyse (lu par blocs, sans le charger)
+					ImGui::SameLine();
+					if( exportTask.valid() )
+					{
+						ImGui::TextColored( warningColor, "Export en cours..." );
+						if( exportTask.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+						{
+							if( exportTask.get() == SUCCESS )
+							{
+								logger.log( Logger::INFO, "Enregistrement exporté dans " + exportFilename );
+							}
+							else
+							{
+								logger.log( Logger::ERROR, "Impossible d'exporter l'enregistrement dans " + exportFilename );
+							}
+						}
+					}
+					else if( recordingFilename[0] != '\0' )
+					{
+						if( ImGui::Button( "Exporter CSV", ImVec2( 110, 0 ) ) )
+						{
+							startExport( false );
+						}
+						ImGui::SameLine();
+						if( ImGui::Button( "Exporter Arrow", ImVec2( 110, 0 ) ) )
+						{
+							startExport( true );
+						}
+					}
+
+					// Vue d'ensemble: molette pour zoomer, glisser pour se déplacer
+					const RecordingOverview& overview = recordingManager.getOverview();
+					if( !overview.isEmpty() )
+					{
+						ImGui::Spacing();
+						drawRecordingTimeline( ImGui::GetContentRegionAvail().x );
+						ImGui::TextColored( mutedTextColor, "%.3f - %.3f s   %zu instantanés   %d par seau (niveau %d/%d)", timelineStart, timelineEnd,
+											overview.getSampleCount(), timelineLevel >= 0 ? 1 << timelineLevel : 0, timelineLevel, overview.getLevelCount() - 1 );
+
+						// Comparer avec un autre enregistrement (même script, autre firmware)
+						ImGui::Spacing();
+						ImGui::SetNextItemWidth( 300 );
+						ImGui::InputText( "##fichierComparaison", comparisonFilename, IM_ARRAYSIZE( comparisonFilename ) );
+						ImGui::SameLine();
+						ImGui::SetNextItemWidth( 150 );
+						ImGui::SliderFloat( "Seuil", &comparisonThreshold, 0.005f, 0.5f, "%.3f" );
+						ImGui::SameLine();
+						if( comparisonTask.valid() )
+						{
+							ImGui::TextColored( warningColor, "Comparaison en cours..." );
+						}
+						else if( ImGui::Button( "Comparer", ImVec2( 100, 0 ) ) && comparisonFilename[0] != '\0' )
+						{
+							startComparison();
+						}
+					}
+					else if( recordingManager.isOverviewBuilding() )
+					{
+						ImGui::Spacing();
+						ImGui::TextColored( mutedTextColor, "Construction de la vue d'ensemble..." );
+					}
+
+					if( comparisonTask.valid() && comparisonTask.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+					{
+						comparison = comparisonTask.get();
+						if( comparison.valid )
+						{
+							logger.log( Logger::INFO, "Comparaison: décalage " + std::to_string( comparison.offset ) + " s, corrélation " +
+														  std::to_string( comparison.correlation ) + ", " + std::to_string( comparison.buttonMismatches.size() ) +
+														  " écarts de boutons (" + std::to_string( comparison.elapsedMs ) + " ms)" );
+						}
+						else
+						{
+							logger.log( Logger::WARNING, "Comparaison impossible: " + comparison.error );
+						}
+					}
+
+					if( comparison.valid )
+					{
+						ImGui::Text( "Décalage: %.4f s   Corrélation: %.3f   Durée comparée: %.1f s   (%.0f ms)", comparison.offset, comparison.correlation,
+									 comparison.overlap, comparison.elapsedMs );
+
+						if( ImGui::BeginTable( "comparaison", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg ) )
+						{
+							ImGui::TableSetupColumn( "Axe", ImGuiTableColumnFlags_WidthFixed, 60.0f );
+							ImGui::TableSetupColumn( "RMSE", ImGuiTableColumnFlags_WidthStretch );
+							ImGui::TableSetupColumn( "Écart max", ImGuiTableColumnFlags_WidthStretch );
+							ImGui::TableSetupColumn( "À (s)", ImGuiTableColumnFlags_WidthStretch );
+							ImGui::TableSetupColumn( "Divergence (s)", ImGuiTableColumnFlags_WidthStretch );
+							ImGui::TableHeadersRow();
+
+							for( size_t i = 0; i < comparison.axes.size(); ++i )
+							{
+								const AxisComparison& axis = comparison.axes[i];
+								ImGui::TableNextRow();
+								ImGui::TableNextColumn();
+								ImGui::Text( "%zu", i );
+								ImGui::TableNextColumn();
+								ImGui::Text( "%.4f", axis.rmse );
+								ImGui::TableNextColumn();
+								ImGui::Text( "%.4f", axis.maxDeviation );
+								ImGui::TableNextColumn();
+								ImGui::Text( "%.3f", axis.maxDeviationTime );
+								ImGui::TableNextColumn();
+								if( axis.divergenceTime >= 0.0 )
+								{
+									ImGui::TextColored( warningColor, "%.3f", axis.divergenceTime );
+								}
+								else
+								{
+									ImGui::TextColored( activeColor, "-" );
+								}
+							}
+
+							ImGui::EndTable();
+						}
+
+						ImGui::Text( "Boutons différents: %zu intervalles", comparison.buttonMismatches.size() );
+						for( size_t i = 0; i < comparison.buttonMismatches.size() && i < 8; ++i )
+						{
+							const ButtonMismatch& mismatch = comparison.buttonMismatches[i];
+							const char*           label    = mismatch.button < static_cast<int>( buttonLabels.size() ) ? buttonLabels[mismatch.button].c_str() : "?";
+							ImGui::TextColored( mutedTextColor, "  %s: %.3f - %.3f s", label, mismatch.startTime, mismatch.endTime );
+						}
+					}
+
+					// Analyse de tous les enregistrements d'un dossier (tableau récapitulatif CSV)
+					ImGui::Spacing();
+					ImGui::SetNextItemWidth( 300 );
+					ImGui::InputText( "##dossierLots", batchDirectory, IM_ARRAYSIZE( batchDirectory ) );
+					ImGui::SameLine();
+					if( batchTask.valid() )
+					{
+						size_t total = batchAnalyzer.getFileCount();
+						ImGui::ProgressBar( total > 0 ? static_cast<float>( batchAnalyzer.getCompletedCount() ) / total : 0.0f, ImVec2( -1, 15 ) );
+
+						if( batchTask.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+						{
+							std::string filename = "batch_" + getCurrentTimeString() + ".csv";
+							ResultCode  result   = batchTask.get();
+							if( result == SUCCESS )
+							{
+								result = batchAnalyzer.exportCSV( filename );
+							}
+
+							if( result == SUCCESS )
+							{
+								char summary[160];
+								snprintf( summary, sizeof( summary ), "%zu enregistrements analysés en %.2f s (%.1f/s), %zu avec anomalies", total,
+										  batchAnalyzer.getElapsedSeconds(), batchAnalyzer.getThroughput(), batchAnalyzer.getAnomalyCount() );
+								logger.log( Logger::INFO, std::string( summary ) + " -> " + filename );
+							}
+							else
+							{
+								logger.log( Logger::ERROR, "Analyse par lots impossible dans " + std::string( batchDirectory ) );
+							}
+						}
+					}
+					else if( ImGui::Button( "Analyser le dossier", ImVec2( 150, 0 ) ) )
+					{
+						std::string directory = batchDirectory;
+						batchTask             = std::async( std::launch::async, [this, directory]() { return batchAnalyzer.run( directory ); } );
+					}
 				}
 			}
 			break;
 		}
-
-		ImGui::PopStyleColor();
 	}
-	else
+
+	// Analyse spectrale des axes
+	if( sectionHeader( "Analyse spectrale" ) )
 	{
-		ImGui::PopStyleColor( 3 );
-	}
+		auto&       axes        = deviceManager.getAxes();
+		const char* fftSizes[]  = { "64", "128", "256", "512", "1024", "2048", "4096", "8192" };
+		int         windowIndex = spectrumAnalyzer.getWindow();
 
-	// Statistiques et débogage
-	ImGui::PushStyleColor( ImGuiCol_Header, secondaryColor );
-	ImGui::PushStyleColor( ImGuiCol_HeaderHovered, ImVec4( secondaryColor.x + 0.1f, secondaryColor.y + 0.1f, secondaryColor.z + 0.1f, 1.0f ) );
-	ImGui::PushStyleColor( ImGuiCol_HeaderActive, ImVec4( secondaryColor.x + 0.15f, secondaryColor.y + 0.15f, secondaryColor.z + 0.15f, 1.0f ) );
+		if( spectrumAxis >= axes.size() )
+		{
+			spectrumAxis = 0;
+		}
 
-	if( ImGui::CollapsingHeader( "Statistiques" ) )
-	{
-		ImGui::PopStyleColor( 3 );
+		ImGui::PushStyleColor( ImGuiCol_FrameBg, ImVec4( secondaryColor.x + 0.05f, secondaryColor.y + 0.05f, secondaryColor.z + 0.05f, 1.0f ) );
+
+		// Axe analysé: changer d'axe repart d'une fenêtre vide
+		ImGui::SetNextItemWidth( 200 );
+		if( ImGui::BeginCombo( "Axe##spectre", axes.empty() ? "-" : axes[spectrumAxis].name.c_str() ) )
+		{
+			for( int i = 0; i < axes.size(); ++i )
+			{
+				ImGui::PushID( i );
+				if( ImGui::Selectable( axes[i].name.c_str(), i == spectrumAxis ) && i != spectrumAxis )
+				{
+					spectrumAxis      = i;
+					spectrumReadIndex = 0;
+					spectrumAnalyzer.clearHistory();
+				}
+				ImGui::PopID();
+			}
+			ImGui::EndCombo();
+		}
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth( 80 );
+		if( ImGui::Combo( "Taille##spectre", &spectrumSizeIndex, fftSizes, IM_ARRAYSIZE( fftSizes ) ) )
+		{
+			spectrumAnalyzer.configure( SPECTRUM_MIN_SIZE << spectrumSizeIndex, static_cast<SpectrumWindow>( windowIndex ) );
+		}
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth( 140 );
+		if( ImGui::BeginCombo( "Fenêtre##spectre", SpectrumAnalyzer::getWindowName( static_cast<SpectrumWindow>( windowIndex ) ) ) )
+		{
+			for( int i = 0; i < SPECTRUM_WINDOW_COUNT; ++i )
+			{
+				if( ImGui::Selectable( SpectrumAnalyzer::getWindowName( static_cast<SpectrumWindow>( i ) ), i == windowIndex ) )
+				{
+					spectrumAnalyzer.configure( SPECTRUM_MIN_SIZE << spectrumSizeIndex, static_cast<SpectrumWindow>( i ) );
+				}
+			}
+			ImGui::EndCombo();
+		}
+
+		ImGui::PopStyleColor();
+
+		if( ImGui::Checkbox( "En direct", &spectrumLive ) && spectrumLive )
+		{
+			spectrumReadIndex = 0;
+			spectrumAnalyzer.clearHistory();
+		}
+
+		ImGui::SameLine();
+		bool canAnalyzeRecording = recordingManager.hasRecording() && !recordingManager.getIsRecording() && !spectrumAnalyzer.isBusy();
+		if( ImGui::Button( "Analyser l'enregistrement", ImVec2( 200, 24 ) ) && canAnalyzeRecording )
+		{
+			analyzeRecordingSpectrum();
+		}
+		if( spectrumAnalyzer.isBusy() )
+		{
+			ImGui::SameLine();
+			ImGui::TextColored( warningColor, "Calcul en cours..." );
+		}
+
+		// Courbe en dB pleine échelle et pics principaux
+		auto showSpectrum = [&]( const char* id, const char* title, const std::shared_ptr<const SpectrumResult>& result ) {
+			if( !result || result->levels.empty() )
+			{
+				return;
+			}
+
+			char overlay[128];
+			snprintf( overlay, sizeof( overlay ), "%s - %d points, %.0f Hz, %d fenêtre(s)", title, result->fftSize, result->sampleRate, result->windowCount );
+			ImGui::PlotLines( id, result->levels.data(), static_cast<int>( result->levels.size() ), 0, overlay, -120.0f, 0.0f, ImVec2( ImGui::GetContentRegionAvail().x, 150 ) );
+			ImGui::TextColored( mutedTextColor, "0 Hz .. %.1f Hz (%.2f Hz par raie), -120 .. 0 dB", result->sampleRate * 0.5f, result->binWidth );
+
+			ImGui::TextColored( accentLightColor, "Pics:" );
+			if( result->peaks.empty() )
+			{
+				ImGui::SameLine();
+				ImGui::TextColored( mutedTextColor, "Aucun" );
+			}
+			for( const auto& peak : result->peaks )
+			{
+				ImGui::SameLine();
+				ImGui::TextColored( textColor, "%.1f Hz (%.0f dB)", peak.frequency, peak.level );
+			}
+		};
+
+		if( spectrumLive )
+		{
+			int lane = 0;
+			if( !deviceManager.getAxisSampler( spectrumAxis, lane ) )
+			{
+				ImGui::TextColored( warningColor, "Cet axe n'est pas échantillonné à haute fréquence" );
+			}
+			showSpectrum( "##spectreDirect", "Direct", spectrumAnalyzer.getLiveResult() );
+		}
 
-		ImGui::PushStyleColor( ImGuiCol_ChildBg, ImVec4( secondaryColor.x - 0.02f, secondaryColor.y - 0.02f, secondaryColor.z - 0.02f, 1.0f ) );
+		showSpectrum( "##spectreEnregistrement", "Enregistrement", spectrumAnalyzer.getOfflineResult() );
+	}
 
+	// Statistiques et débogage
+	if( sectionHeader( "Statistiques" ) )
+	{
 		ImGui::Columns( 2, "StatsColumns", false );
 		ImGui::SetColumnWidth( 0, ImGui::GetWindowWidth() * 0.5f );
 
@@ -2511,11 +8883,12 @@ void WheelTestApp::renderUI( SDL_Window* window )
 		ImGui::TextColored( accentLightColor, "Performances:" );
 		ImGui::TextColored( textColor, "FPS: %.1f", ImGui::GetIO().Framerate );
 		ImGui::TextColored( textColor, "Temps par image: %.3f ms", 1000.0f / ImGui::GetIO().Framerate );
+		if( isAllocationCountingEnabled() )
+		{
+			ImGui::TextColored( frameAllocations > 0 ? warningColor : textColor, "Allocations par image: %llu", static_cast<unsigned long long>( frameAllocations ) );
+		}
 
-		ImGui::PushStyleColor( ImGuiCol_SliderGrab, accentColor );
-		ImGui::PushStyleColor( ImGuiCol_SliderGrabActive, accentLightColor );
 		ImGui::SliderFloat( "Fréquence de mise à jour", &config.updateFrequency, 0.0f, 100.0f, "%.0f Hz" );
-		ImGui::PopStyleColor( 2 );
 
 		ImGui::NextColumn();
 
@@ -2570,17 +8943,9 @@ void WheelTestApp::renderUI( SDL_Window* window )
 		ImGui::PopStyleVar();
 
 		ImGui::Columns( 1 );
-
-		ImGui::PopStyleColor();
-	}
-	else
-	{
-		ImGui::PopStyleColor( 3 );
 	}
 
 	// Barre d'état en bas
-	ImGui::PushStyleColor( ImGuiCol_ChildBg, secondaryColor );
-
 	ImGui::Text( "État: " );
 	ImGui::SameLine();
 
@@ -2596,7 +8961,7 @@ void WheelTestApp::renderUI( SDL_Window* window )
 	ImGui::SameLine( ImGui::GetWindowWidth() - 120 );
 	ImGui::TextColored( mutedTextColor, "v%s", APP_VERSION );
 
-	ImGui::PopStyleColor();
-
 	ImGui::End();
+
+	frameAllocations = getThreadAllocationCount() - allocationsAtStart;
 }
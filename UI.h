@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SDL.h>
+#include "imgui.h"
 #include <string>
 #include <vector>
 #include <fstream>
@@ -11,6 +12,19 @@
 #include <memory>
 #include <ctime>
 #include <filesystem>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <condition_variable>
+#include <map>
+#include <unordered_map>
+#include <istream>
+#include <numeric>
+#include <complex>
+#include <future>
+#include <functional>
+#include <charconv>
 
 // =============================================================================
 // DFINITION DES CODES DE RETOUR ET CONSTANTES
@@ -19,6 +33,10 @@
 // Version de l'application
 extern const char* APP_VERSION;
 
+// Allocations du tas faites par le thread appelant (comptes uniquement en debug dans l'application, voir WHEELTEST_COUNT_ALLOCATIONS)
+Uint64 getThreadAllocationCount();
+bool   isAllocationCountingEnabled();
+
 // Codes de retour
 enum ResultCode
 {
@@ -30,7 +48,9 @@ enum ResultCode
 	ERROR_RECORDING_NOT_ACTIVE,
 	ERROR_SDL_INIT_FAILED,
 	ERROR_JOYSTICK_NOT_FOUND,
-	ERROR_INVALID_PARAMETER
+	ERROR_INVALID_PARAMETER,
+	ERROR_FILE_TRUNCATED, // Taille du fichier infrieure  celle annonce par son en-tte
+	ERROR_FILE_CORRUPTED  // En-tte incohrent (version, dimensions)
 };
 
 // =============================================================================
@@ -45,6 +65,8 @@ struct WheelInfo
 	int         buttonCount;
 	int         axisCount;
 	bool        hasForceFeeback;
+	Uint16      vendorId;
+	Uint16      productId;
 };
 
 // Structure pour les axes
@@ -56,6 +78,65 @@ struct AxisInfo
 	float       max;
 	float       deadzone;
 	float       rawValue; // Valeur brute avant application de la zone morte
+	bool        inverted; // Sens de l'axe invers (pdales qui vont de 32767  -32768)
+	float       curve;      // Exposant de la courbe de rponse (1 = linaire)
+	float       saturation; // Part de la course qui donne dj la valeur maximale (1 = aucune)
+	bool        unipolar;   // Pdale ou frein  main: valeur de 0  1, zone morte au repos
+};
+
+// Table de rponse d'un axe: transformation complte indexe par la valeur brute. Une lecture par
+// chantillon, quelle que soit la courbe: le calcul vectoriel (AVX2) ne gagne qu'environ 20 % et repasse
+// par la table pour les axes  courbe. Sert aussi bien aux vnements qu'au flux haute frquence.
+struct AxisResponseTable
+{
+	AxisInfo           settings; // Rglages ayant servi  construire la table
+	std::vector<float> values;   // 65536 entres, indice = valeur brute - SDL_MIN_SINT16
+	Sint16             lastRaw;  // Dernire valeur brute applique, rvalue aprs reconstruction
+};
+
+// Rle d'un axe dans un poste de pilotage
+enum AxisRole : Uint8
+{
+	AXIS_ROLE_NONE,
+	AXIS_ROLE_STEERING,
+	AXIS_ROLE_THROTTLE,
+	AXIS_ROLE_BRAKE,
+	AXIS_ROLE_CLUTCH,
+	AXIS_ROLE_SHIFTER_X,
+	AXIS_ROLE_SHIFTER_Y,
+	AXIS_ROLE_HANDBRAKE
+};
+
+// Type de priphrique d'un poste de pilotage
+enum DeviceKind : Uint8
+{
+	DEVICE_KIND_WHEEL,
+	DEVICE_KIND_PEDALS,
+	DEVICE_KIND_SHIFTER,
+	DEVICE_KIND_HANDBRAKE
+};
+
+// Rglages par dfaut d'un axe dans un profil
+struct AxisProfile
+{
+	AxisRole role;
+	float    min;
+	float    max;
+	float    deadzone;
+	bool     inverted;
+};
+
+// Profil d'un priphrique connu
+struct DeviceProfile
+{
+	std::string              name;
+	Uint16                   vendorId;
+	Uint16                   productId; // 0 = tous les produits du fabricant
+	std::string              guid;      // Facultatif, prioritaire sur VID/PID
+	DeviceKind               kind;
+	bool                     hasForceFeedback;
+	unsigned                 ffbEffects; // Masque SDL_HAPTIC_* autoris
+	std::vector<AxisProfile> axes;
 };
 
 // Structure pour les effets de force
@@ -68,12 +149,199 @@ struct ForceEffect
 	int         effectId; // ID utilis par le systme de force feedback
 };
 
+// Famille de paramtres SDL utilise par un effet
+enum EffectKind
+{
+	EFFECT_KIND_CONSTANT,
+	EFFECT_KIND_CONDITION,
+	EFFECT_KIND_PERIODIC,
+	EFFECT_KIND_LEFTRIGHT
+};
+
+// Descripteur statique d'un effet (table construite une seule fois)
+struct EffectDescriptor
+{
+	const char*  name;
+	float        defaultStrength;
+	float        defaultDuration;
+	Uint16       sdlType;
+	unsigned int supportFlag;    // Bit de SDL_HapticQuery requis
+	EffectKind   kind;
+	Uint16       period;         // Priode en ms (effets priodiques)
+	Uint16       attackFraction; // Part de la dure en attaque (Q16)
+	Uint16       fadeFraction;   // Part de la dure en attnuation (Q16)
+};
+
+// Type de transition d'entre
+enum InputEventType : Uint8
+{
+	INPUT_EVENT_AXIS,
+	INPUT_EVENT_BUTTON,
+	INPUT_EVENT_DISCONNECTED, // Dbut d'un trou dans la capture (index = priphrique)
+	INPUT_EVENT_RECONNECTED   // Fin du trou
+};
+
+// Transition d'entre horodate (issue des vnements SDL du joystick)
+struct InputEvent
+{
+	double timestamp; // Secondes (horloge des vnements SDL; celle des instantans pour les marqueurs)
+	Uint8  type;
+	Uint8  index;
+	Sint16 value; // Valeur brute de l'axe ou tat du bouton (0/1)
+};
+
+// Format des fichiers d'enregistrement
+constexpr Uint32 RECORDING_MAGIC   = 0x43525457; // "WTRC"
+constexpr Uint32 RECORDING_VERSION = 3;
+
+// Nombre maximum de boutons de la vue fusionne (les indices d'vnements sont sur 8 bits)
+constexpr int MAX_BUTTONS  = 256;
+constexpr int BUTTON_WORDS = MAX_BUTTONS / 64;
+
+// tat des boutons compact: un bit par bouton, copi et compar par mots de 64 bits
+struct ButtonBits
+{
+	Uint64 words[BUTTON_WORDS];
+
+	void clear();
+	bool test( int index ) const;
+	void set( int index, bool pressed );
+	int  count() const; // Nombre de boutons presss
+
+	// Prochain bouton press  partir de l'indice donn (-1 s'il n'y en a plus)
+	int findNext( int from ) const;
+
+	bool       operator==( const ButtonBits& other ) const;
+	bool       operator!=( const ButtonBits& other ) const;
+	ButtonBits operator^( const ButtonBits& other ) const;
+	ButtonBits operator&( const ButtonBits& other ) const;
+	ButtonBits operator|( const ButtonBits& other ) const;
+
+	// Fronts entre deux tats: appuis = changements & tat courant, relchements = changements & tat prcdent
+	static ButtonBits pressedEdges( const ButtonBits& previous, const ButtonBits& current );
+	static ButtonBits releasedEdges( const ButtonBits& previous, const ButtonBits& current );
+};
+
 // Structure pour un tat instantan des entres
 struct InputSnapshot
 {
 	double             timestamp;
 	std::vector<float> axisValues;
-	std::vector<bool>  buttonStates;
+	ButtonBits         buttonStates;
+};
+
+// Nombre maximum d'axes chantillonns par le thread haute frquence
+constexpr int MAX_SAMPLED_AXES = 8;
+
+// Structure pour un chantillon brut horodat (flux haute frquence)
+struct RawInputSample
+{
+	Uint64 timestamp; // Compteur haute rsolution (SDL_GetPerformanceCounter)
+	Sint16 axes[MAX_SAMPLED_AXES];
+};
+
+// Rsultats d'une mesure de latence du retour de force
+struct LatencyStats
+{
+	int    count;
+	int    timeouts;
+	double minMs;
+	double medianMs;
+	double p99Ms;
+	double maxMs;
+};
+
+// Rsum de la qualit du signal d'un axe (units brutes)
+struct AxisSignalStats
+{
+	Uint64 sampleCount;
+	double mean;
+	double stdDev; // Bruit de fond quand l'axe est au repos
+	Sint16 rawMin;
+	Sint16 rawMax;
+	Uint32 distinctValues;
+	int    quantizationStep; // Plus grand diviseur commun des carts entre chantillons
+	int    maxStep;          // Plus grand cart entre deux chantillons conscutifs
+	Uint32 spikeCount;       // chantillons isols hors de la tendance
+	double jitter;           // Bruit estim par les petits carts successifs (axe en mouvement lent ou au repos)
+	float  effectiveBits;    // log2 du nombre de valeurs distinctes observes
+	float  resolutionBits;   // log2 de la plage 16 bits divise par le pas de quantification
+};
+
+// Histogramme de dures  classes fixes (puissances de deux en millisecondes)
+constexpr int DURATION_HISTOGRAM_BINS = 16;
+
+struct DurationHistogram
+{
+	Uint32 bins[DURATION_HISTOGRAM_BINS]; // Classe 0: < 1 ms, classe k: [2^(k-1), 2^k[ ms, dernire classe ouverte
+	Uint32 count;
+	double minMs;
+	double maxMs;
+	double sumMs;
+
+	void   clear();
+	void   add( double durationMs );
+	double getMeanMs() const;
+
+	// Borne haute d'une classe en millisecondes (infinie pour la dernire)
+	static double getBinUpperMs( int bin );
+};
+
+// Statistiques de temporisation d'un bouton
+struct ButtonTimingStats
+{
+	Uint32            edgeCount;   // Fronts bruts reus
+	Uint32            bounceCount; // Fronts arrivs dans la fentre de rebond du front prcdent
+	Uint32            pressCount;  // Appuis aprs filtrage des rebonds
+	Uint32            releaseCount;
+	bool              pressed; // tat filtr
+	double            lastEdgeTime;
+	double            lastPressTime;
+	DurationHistogram holdTimes;
+	DurationHistogram pressIntervals;
+};
+
+// Fentre d'apodisation de l'analyse spectrale
+enum SpectrumWindow
+{
+	SPECTRUM_WINDOW_RECTANGULAR,
+	SPECTRUM_WINDOW_HANN,
+	SPECTRUM_WINDOW_HAMMING,
+	SPECTRUM_WINDOW_BLACKMAN_HARRIS,
+	SPECTRUM_WINDOW_COUNT
+};
+
+// Tailles de FFT acceptes (puissances de deux)
+constexpr int SPECTRUM_MIN_SIZE = 64;
+constexpr int SPECTRUM_MAX_SIZE = 8192;
+
+// Raie dominante du spectre (frquence affine par interpolation parabolique)
+struct SpectrumPeak
+{
+	float frequency; // Hz
+	float level;     // dB pleine chelle
+};
+
+// Spectre d'amplitude d'un axe
+struct SpectrumResult
+{
+	std::vector<float>        levels; // dB pleine chelle, fftSize / 2 + 1 raies de 0 Hz  Nyquist
+	std::vector<SpectrumPeak> peaks;  // Par niveau dcroissant
+	float                     sampleRate;
+	float                     binWidth;
+	int                       fftSize;
+	int                       windowCount; // Fentres moyennes (mthode de Welch hors ligne, 1 en direct)
+};
+
+// Rsultats de la mesure du taux de rapport d'un priphrique
+struct PollingStats
+{
+	Uint64 reportCount; // Rapports reus (vnements regroups)
+	double reportRate;  // Rapports par seconde
+	double meanMs;
+	double p50Ms;
+	double p99Ms;
+	double maxMs;
 };
 
 // Structure pour la configuration
@@ -85,6 +353,29 @@ struct Config
 	float       updateFrequency;
 	float       masterForceStrength;
 	bool        ffbEnabled;
+	std::string themeName;
+};
+
+// Thme de l'interface: palette lue dans themes.ini, couleurs drives calcules au chargement
+struct UITheme
+{
+	std::string name;
+	ImVec4      primary;     // Fond des fentres
+	ImVec4      secondary;   // Cadres, en-ttes de section
+	ImVec4      accent;      // Boutons, slection
+	ImVec4      accentLight; // Survol, titres
+	ImVec4      text;
+	ImVec4      mutedText;
+	ImVec4      active;
+	ImVec4      activeHover;
+	ImVec4      warning;
+	ImVec4      error;
+	float       rounding;
+
+	// Drives de la palette (ThemeLibrary::addTheme)
+	ImVec4 sectionHeader;
+	ImVec4 sectionHeaderHovered;
+	ImVec4 sectionHeaderActive;
 };
 
 // =============================================================================
@@ -95,9 +386,10 @@ struct Config
 class Logger
 {
 private:
-	std::ofstream logFile;
-	bool          toFile;
-	bool          verbose;
+	std::ofstream       logFile;
+	bool                toFile;
+	bool                verbose;
+	std::atomic<Uint64> messageCount; // Messages mis (l'interface se redessine quand il change)
 
 	// Date et heure formates pour le log
 	std::string getCurrentTimestamp();
@@ -120,18 +412,81 @@ public:
 	void       setVerbose( bool verboseLogging );
 	void       setLogToFile( bool logToFile, const std::string& filename );
 
-	bool isLogToFile() const { return toFile; }
-	bool isVerbose() const { return verbose; }
+	bool   isLogToFile() const { return toFile; }
+	bool   isVerbose() const { return verbose; }
+	Uint64 getMessageCount() const { return messageCount; }
+};
+
+// Index multi-rsolution d'un enregistrement: pyramide min/max par axe, chaque niveau
+// regroupe deux seaux du niveau infrieur. Construit  la fin d'une capture ou au chargement.
+class RecordingOverview
+{
+private:
+	// Niveau k (k >= 1): seau i = instantans [ i * 2^k, ( i + 1 ) * 2^k )
+	struct Level
+	{
+		std::vector<float> mins;
+		std::vector<float> maxs;
+	};
+
+	std::vector<double>             times;   // Horodatage de chaque instantan
+	std::vector<std::vector<float>> values;  // Niveau 0, une colonne par axe
+	std::vector<std::vector<Level>> levels;  // Niveaux 1 et suivants, par axe
+	std::vector<ButtonBits>         buttons; // Colonne des tats de boutons
+	int                             buttonCount;
+	Uint32                          version;
+
+public:
+	RecordingOverview();
+
+	void build( const std::vector<InputSnapshot>& snapshots, int numButtons );
+	void clear();
+
+	// Colonnes brutes (niveau 0)
+	const std::vector<double>&     getTimes() const;
+	const std::vector<float>&      getValues( int axis ) const;
+	const std::vector<ButtonBits>& getButtons() const;
+	int                            getButtonCount() const;
+
+	bool   isEmpty() const;
+	int    getAxisCount() const;
+	size_t getSampleCount() const;
+	int    getLevelCount() const;
+	double getStartTime() const;
+	double getEndTime() const;
+	Uint32 getVersion() const; // Change  chaque reconstruction
+
+	// Min/max par colonne entre startTime et endTime (colonne sans donne: min > max). Chaque colonne
+	// est couverte par des seaux aligns de la pyramide: le cot dpend du nombre de colonnes, pas de
+	// la dure affiche. Retourne le niveau le plus grossier utilis (-1 si rien  afficher).
+	int query( int axis, double startTime, double endTime, int columnCount, float* outMin, float* outMax ) const;
 };
 
+class RecordingReader;
+
 // Gestionnaire d'enregistrement
 class RecordingManager
 {
 private:
 	std::vector<InputSnapshot>            recordedData;
+	std::vector<InputEvent>               recordedEvents;
+	int                                   buttonCount; // Boutons significatifs dans chaque instantan
 	std::chrono::steady_clock::time_point startTime;
+	Uint32                                startTicks; // Origine des horodatages d'vnements SDL
 	bool                                  isRecording;
 	float                                 currentTime;
+	std::shared_ptr<RecordingOverview>    overview;  // Remplace  chaque reconstruction, jamais modifie une fois publie
+	std::string                           lastError; // Cause du dernier chec de chargement
+
+	// Construction de la vue d'ensemble en arrire-plan: les instantans ne sont pas modifis tant
+	// qu'elle tourne (startRecording et le chargement l'attendent)
+	std::future<std::shared_ptr<RecordingOverview>> overviewTask;
+
+	void startOverview();
+
+	// Charger les instantans et vnements d'un lecteur ouvert; l'enregistrement courant n'est
+	// remplac qu'en cas de succs
+	ResultCode load( RecordingReader& reader, bool buildOverview );
 
 public:
 	RecordingManager();
@@ -142,7 +497,19 @@ public:
 	float      getRecordingDuration() const;
 
 	// Ajouter un instantan des entres  l'enregistrement
-	void addSnapshot( const std::vector<AxisInfo>& axes, const std::vector<bool>& buttons );
+	void addSnapshot( const std::vector<AxisInfo>& axes, const ButtonBits& buttons, int numButtons );
+
+	// Ajouter une transition d'entre (dans l'ordre de rception)
+	void addEvent( const InputEvent& event );
+
+	// Marquer un dbranchement ou une reconnexion, horodat sur l'horloge des instantans
+	void addMarker( InputEventType type, Uint8 deviceIndex );
+
+	// Transitions enregistres, horodates depuis le dbut de l'enregistrement
+	const std::vector<InputEvent>& getEvents() const;
+
+	// Instantans enregistrs (un par frame)
+	const std::vector<InputSnapshot>& getSnapshots() const;
 
 	// Obtenir le snapshot pour la lecture  un moment donn
 	bool getSnapshotAtTime( float time, InputSnapshot& outSnapshot );
@@ -150,14 +517,248 @@ public:
 	// Sauvegarder l'enregistrement dans un fichier
 	ResultCode saveRecording( const std::string& filename );
 
-	// Charger un enregistrement depuis un fichier
-	ResultCode loadRecording( const std::string& filename );
+	// Charger un enregistrement depuis un fichier (la vue d'ensemble peut tre omise pour une analyse seule).
+	// Les tailles de l'en-tte sont vrifies avant toute allocation: un fichier invalide choue
+	// immdiatement, avec une mmoire borne par sa longueur, et getLastError() en donne la raison
+	ResultCode loadRecording( const std::string& filename, bool buildOverview = true );
+	ResultCode loadRecordingFromMemory( const void* data, size_t size, bool buildOverview = true );
+
+	const std::string& getLastError() const;
 
 	// Obtenir la dure totale de l'enregistrement
 	float getTotalDuration() const;
 	bool  hasRecording() const;
+	int   getButtonCount() const;
+
+	// Vue multi-rsolution de la dernire capture termine ou charge (vide tant qu'elle est en construction)
+	const RecordingOverview& getOverview() const;
+
+	// Publier la vue construite en arrire-plan quand elle est prte (vrai si elle vient d'tre publie)
+	bool updateOverview();
+	bool isOverviewBuilding() const;
+
+	// Attendre la vue en construction (tches de fond qui en ont besoin tout de suite)
+	void waitForOverview();
+
+	// Mme vue, partage sans copie avec une tche de fond (elle reste valide si la capture est relance)
+	std::shared_ptr<const RecordingOverview> getSharedOverview() const;
+};
+
+// Threads de calcul crs une fois et rutiliss par tous les lots parallles (comparaison, export CSV).
+// Un seul lot  la fois: un appel concurrent attend la fin du lot en cours.
+class WorkerPool
+{
+private:
+	std::vector<std::thread>             threads;
+	std::mutex                           runMutex; // Tenu pendant tout un lot
+	std::mutex                           mutex;
+	std::condition_variable              wake;
+	std::condition_variable              done;
+	const std::function<void( size_t )>* task;
+	size_t                               count;
+	std::atomic<size_t>                  next;
+	Uint64                               generation;  // Incrment  chaque lot
+	size_t                               activeCount; // Threads encore occups par le lot courant
+	bool                                 stopping;
+
+	void loop();
+	void work();
+
+public:
+	// threadCount = 0: un thread par coeur (l'appelant de run compte pour un)
+	explicit WorkerPool( size_t threadCount = 0 );
+	~WorkerPool();
+
+	// Excuter task( i ) pour chaque i < taskCount (bloquant, l'appelant participe)
+	void run( size_t taskCount, const std::function<void( size_t )>& task );
+};
+
+// cart d'un axe entre deux enregistrements aligns
+struct AxisComparison
+{
+	double rmse;
+	double maxDeviation;
+	double maxDeviationTime; // Secondes dans la rfrence
+	double divergenceTime;   // Premier cart au-dessus du seuil (-1: jamais)
+};
+
+// Intervalle pendant lequel un bouton diffre entre les deux enregistrements
+struct ButtonMismatch
+{
+	int    button;
+	double startTime; // Secondes dans la rfrence
+	double endTime;
+};
+
+// Rsultat de la comparaison d'un enregistrement avec une rfrence
+struct RecordingComparison
+{
+	bool                        valid;
+	double                      offset;      // Le candidat  t + offset correspond  la rfrence  t
+	double                      correlation; // Corrlation normalise au dcalage retenu
+	double                      overlap;     // Dure compare (secondes)
+	double                      elapsedMs;
+	std::vector<AxisComparison> axes;
+	std::vector<ButtonMismatch> buttonMismatches;
+	std::string                 error; // Raison de l'chec si la comparaison n'est pas valide
+};
+
+// Aligner le candidat sur la rfrence par intercorrlation (FFT, dcalage limit  maxOffset secondes),
+// puis mesurer les carts. Les axes et les boutons sont traits en parallle.
+RecordingComparison compareRecordings( const RecordingOverview& reference, const RecordingOverview& candidate, float divergenceThreshold,
+									   double maxOffset );
+
+// Anomalies dtectes par l'analyse par lots (combinables)
+enum RecordingAnomaly
+{
+	ANOMALY_NONE           = 0,
+	ANOMALY_UNREADABLE     = 1 << 0, // Fichier illisible ou tronqu
+	ANOMALY_EMPTY          = 1 << 1, // Moins de deux instantans
+	ANOMALY_TIME_BACKWARDS = 1 << 2, // Horodatage dcroissant
+	ANOMALY_GAP            = 1 << 3, // Intervalle suprieur  10 fois l'intervalle mdian
+	ANOMALY_OUT_OF_RANGE   = 1 << 4, // Valeur d'axe non finie ou hors de [-1, 1]
+	ANOMALY_NOISY_AXIS     = 1 << 5, // Bruit (mdiane des diffrences secondes sur tout l'enregistrement) au-dessus du seuil
+	ANOMALY_NO_INPUT       = 1 << 6  // Aucun axe ni bouton ne bouge
+};
+
+// Statistiques d'un axe sur tout un enregistrement
+struct AxisSummary
+{
+	float  minValue;
+	float  maxValue;
+	double mean;
+	double stdDev;
+	double noise; // cart type des petites variations entre instantans successifs
+};
+
+// Rsultat de l'analyse d'un enregistrement
+struct RecordingSummary
+{
+	std::string              filename;
+	double                   duration;
+	size_t                   snapshotCount;
+	double                   medianInterval; // Secondes
+	double                   maxGap;
+	int                      buttonCount;
+	Uint32                   pressCount;  // Appuis, tous boutons confondus
+	int                      buttonsUsed; // Boutons appuys au moins une fois
+	Uint32                   anomalies;   // Combinaison de RecordingAnomaly
+	std::vector<AxisSummary> axes;
+};
+
+// Analyse de tous les enregistrements d'un dossier sur tous les coeurs. Chaque thread a sa file de
+// fichiers (les plus gros d'abord) et vole par la fin dans celle des autres quand la sienne est vide.
+class BatchAnalyzer
+{
+private:
+	static constexpr float NOISE_THRESHOLD = 0.01f; // Environ 1 % de la course
+
+	struct WorkQueue
+	{
+		std::mutex         mutex;
+		std::deque<size_t> tasks;
+	};
+
+	std::vector<std::string>      files;
+	std::vector<RecordingSummary> summaries;
+	std::atomic<size_t>           fileCount;
+	std::atomic<size_t>           completedCount;
+	std::atomic<size_t>           stolenCount;
+	double                        elapsedSeconds;
+
+	// Tche suivante du thread worker: sa propre file, sinon vol dans une autre
+	bool nextTask( std::vector<std::unique_ptr<WorkQueue>>& queues, size_t worker, size_t& task );
+
+public:
+	BatchAnalyzer();
+
+	// Analyser un enregistrement; recording est rutilis d'un fichier  l'autre
+	static void analyzeRecording( const std::string& filename, RecordingManager& recording, RecordingSummary& summary );
+
+	// Analyser les fichiers .dat du dossier (bloquant, threadCount = 0: un thread par coeur)
+	ResultCode run( const std::string& directory, int threadCount = 0 );
+
+	// Tableau rcapitulatif, une ligne par enregistrement
+	ResultCode exportCSV( const std::string& filename ) const;
+
+	// Progression, lisible depuis un autre thread pendant run()
+	size_t getFileCount() const;
+	size_t getCompletedCount() const;
+
+	size_t                               getStolenCount() const;
+	double                               getElapsedSeconds() const;
+	double                               getThroughput() const; // Enregistrements par seconde
+	size_t                               getAnomalyCount() const;
+	const std::vector<RecordingSummary>& getSummaries() const;
+
+	// Codes des anomalies spars par '|' ("" si aucune)
+	static std::string describeAnomalies( Uint32 anomalies );
 };
 
+// Bloc d'instantans lu dans un fichier d'enregistrement, en colonnes
+struct RecordingChunk
+{
+	size_t                  count;
+	std::vector<double>     times;
+	std::vector<float>      values; // Axe par axe: values[axis * count + i]
+	std::vector<ButtonBits> buttons;
+};
+
+// Lecture par blocs d'un fichier d'enregistrement, sans le charger en entier. L'en-tte est valid
+//  l'ouverture: dimensions plausibles et nombre d'instantans compatible avec la taille du fichier.
+class RecordingReader
+{
+private:
+	// Limites de l'en-tte, au-del desquelles le fichier est considr comme corrompu
+	static constexpr size_t MAX_FILE_AXES    = 1024;
+	static constexpr size_t MAX_FILE_BUTTONS = 65536;
+
+	std::ifstream     file;
+	std::istream*     stream;
+	Uint64            remaining; // Octets non lus
+	Uint32            version;
+	size_t            snapshotCount;
+	size_t            axisCount;
+	size_t            buttonCount; // Boutons stocks dans le fichier
+	size_t            recordSize;  // Octets par instantan
+	size_t            readCount;
+	bool              failed;
+	std::string       error;
+	std::vector<char> buffer;
+
+	// Lire size octets dj compts dans remaining
+	bool readBytes( void* destination, size_t size );
+
+public:
+	static constexpr size_t CHUNK_SIZE = 65536; // Instantans par bloc conseills
+
+	RecordingReader();
+
+	ResultCode open( const std::string& filename );
+	ResultCode open( std::istream& input ); // Le flux doit permettre seekg et rester valide pendant la lecture
+
+	// Lire au plus maxCount instantans (0: fin du fichier, ou erreur de lecture si hasFailed())
+	size_t readChunk( size_t maxCount, RecordingChunk& chunk );
+	bool   hasFailed() const;
+
+	// Lire les vnements (version 2 et suivantes), une fois tous les instantans lus
+	ResultCode readEvents( std::vector<InputEvent>& events );
+
+	// Description de la dernire erreur ("" si aucune)
+	const std::string& getError() const;
+
+	Uint32 getVersion() const;
+	size_t getSnapshotCount() const;
+	size_t getAxisCount() const;
+	int    getButtonCount() const; // Boutons reprsentables (au plus MAX_BUTTONS)
+};
+
+// Exporter un fichier d'enregistrement bloc par bloc, colonnes time, axisN et buttonN:
+// - CSV, nombres formats par std::to_chars (plus courte reprsentation relue  l'identique)
+// - fichier Arrow IPC (time: double, axisN: float, buttonN: bool), lisible par pyarrow, pandas, polars ou DuckDB
+ResultCode exportRecordingCSV( const std::string& input, const std::string& output );
+ResultCode exportRecordingArrow( const std::string& input, const std::string& output );
+
 // Gestionnaire de test automatique
 class AutoTestManager
 {
@@ -186,7 +787,7 @@ public:
 	float      getCurrentTime() const;
 
 	// Mettre  jour le test et gnrer les valeurs actuelles
-	void update( std::vector<AxisInfo>& axes, std::vector<bool>& buttons, std::vector<ForceEffect>& effects );
+	void update( std::vector<AxisInfo>& axes, ButtonBits& buttons, int buttonCount, std::vector<ForceEffect>& effects );
 
 	// Getters/Setters pour les options
 	void setTestOptions( bool buttons, bool axes, bool ffb, float testDuration );
@@ -195,6 +796,223 @@ public:
 	bool getTestFFB() const;
 };
 
+// Convertir un cart du compteur haute rsolution en millisecondes
+double performanceCounterToMs( Uint64 ticks );
+
+// Volant simul rpondant aux commandes de force (mode dmo)
+class SimulatedWheel
+{
+private:
+	struct PendingForce
+	{
+		Uint64 applyAt;
+		float  level;
+	};
+
+	mutable std::mutex       mutex;
+	std::deque<PendingForce> pending;
+	float                    latencyMs;
+	float                    noise;
+	float                    position;
+	float                    velocity;
+	float                    force;
+	Uint64                   lastTime;
+	Uint32                   noiseSeed;
+
+public:
+	SimulatedWheel();
+
+	void reset();
+
+	// Appliquer une force (-1  1), effective aprs la latence simule
+	void applyForce( float level, Uint64 timestamp );
+
+	// Faire avancer la dynamique jusqu' l'instant donn et lire la position du volant
+	Sint16 sampleSteering( Uint64 now );
+
+	void  setLatency( float ms );
+	float getLatency() const;
+};
+
+// Thread d'chantillonnage haute frquence des axes d'un priphrique. Seul le thread principal met  jour
+// les joysticks (SDL_PollEvent, SDL_WaitEventTimeout): l'chantillonneur lit l'tat publi sous SDL_LockJoysticks.
+class InputSampler
+{
+private:
+	static constexpr size_t RING_CAPACITY = 4096;
+
+	SDL_Joystick*               joystick;
+	SimulatedWheel*             simulatedWheel;
+	int                         axisCount;
+	int                         steeringLane; // Voie de l'axe de direction, rsolue au dmarrage
+	std::thread                 worker;
+	std::atomic<bool>           running;
+	std::atomic<Uint32>         periodUs;
+	mutable std::mutex          ringMutex;
+	std::vector<RawInputSample> ring;
+	Uint64                      writeIndex;
+
+	// Boucle du thread d'chantillonnage
+	void run();
+
+public:
+	InputSampler();
+	~InputSampler();
+
+	// steering: indice de l'axe de direction du priphrique (voie 0 pour le volant simul)
+	ResultCode start( SDL_Joystick* device, int numAxes, SimulatedWheel* simulation, int steering = 0 );
+	void       stop();
+	bool       isRunning() const;
+	int        getSteeringLane() const;
+
+	// Copier les chantillons produits depuis readIndex (avanc en consquence)
+	size_t readSince( Uint64& readIndex, std::vector<RawInputSample>& out ) const;
+
+	// Obtenir le dernier chantillon
+	bool getLatest( RawInputSample& outSample ) const;
+
+	Uint64 getWriteIndex() const;
+	void   setSamplingPeriod( Uint32 microseconds );
+	Uint32 getSamplingPeriod() const;
+};
+
+// Construire la table de rponse d'un axe
+void buildAxisResponseTable( const AxisInfo& axis, AxisResponseTable& table );
+
+// Appliquer une valeur brute reue: valeur normalise lue dans la table, valeur brute affiche calcule
+void applyAxisResponse( AxisInfo& axis, AxisResponseTable& table, Sint16 raw );
+
+// Priphrique ouvert (base, pdalier, levier de vitesse, frein  main...)
+struct InputDevice
+{
+	SDL_Joystick*  joystick; // nullptr tant que le priphrique est dbranch
+	SDL_JoystickID instanceId;
+	std::string    guid;
+	DeviceProfile  profile;
+	WheelInfo      info;
+	int            axisOffset;   // Premier axe dans la vue fusionne
+	int            buttonOffset; // Premier bouton dans la vue fusionne
+	InputSampler   sampler;      // chantillonnage propre au priphrique
+	Uint64         calibrationReadIndex;
+	Uint64         analysisReadIndex; // Lecture du flux brut par l'analyse du signal
+};
+
+// Calibration incrmentale d'un axe, alimente par le flux d'chantillons haute frquence
+class AxisCalibrator
+{
+public:
+	enum State
+	{
+		IDLE,
+		SETTLING, // Axe au repos: mesure du centre et du bruit
+		SWEEPING, // Axe dplac sur toute sa course: mesure des extrmes
+		DONE
+	};
+
+private:
+	State  state;
+	Uint64 stateStart;
+	float  settleMs;
+
+	// Repos: moyenne et variance par l'algorithme de Welford
+	Uint64 restCount;
+	double restMean;
+	double restM2;
+
+	// Course complte
+	Uint64 sweepCount;
+	Sint16 rawMin;
+	Sint16 rawMax;
+
+public:
+	AxisCalibrator();
+
+	void start( Uint64 now );
+	void addSample( Sint16 raw, Uint64 timestamp );
+	void finish();
+	void cancel();
+
+	State  getState() const;
+	bool   isActive() const;
+	Uint64 getSampleCount() const;
+	Sint16 getRawMin() const;
+	Sint16 getRawMax() const;
+	float  getCenter() const; // Valeur brute moyenne au repos
+	float  getNoise() const;  // cart type au repos (units brutes)
+};
+
+// Statistiques en continu du flux brut d'un axe, en O(1) par chantillon
+class AxisSignalAnalyzer
+{
+private:
+	// carts successifs au-dessus de cette valeur exclus de l'estimation de la gigue
+	static constexpr int STILL_STEP = 256;
+
+	Uint64 distinctBits[65536 / 64]; // Une case par valeur brute possible (8 Kio)
+	Uint32 distinctCount;
+
+	// Moyenne et variance par l'algorithme de Welford
+	Uint64 count;
+	double mean;
+	double m2;
+
+	Sint16 rawMin;
+	Sint16 rawMax;
+	int    quantizationStep;
+	int    maxStep;
+	Uint32 spikeCount;
+	int    spikeThreshold;
+	Sint16 previous[2]; // Avant-dernier et dernier chantillons
+	Uint64 jitterCount;
+	double jitterSumSquares;
+
+public:
+	AxisSignalAnalyzer();
+
+	void reset();
+	void addSample( Sint16 raw );
+
+	// Un chantillon qui s'carte de plus que le seuil puis revient est un pic
+	void setSpikeThreshold( int threshold );
+	int  getSpikeThreshold() const;
+
+	AxisSignalStats getStats() const;
+};
+
+// Historique dfilant d'un axe: anneau de seaux min/max de dure fixe. La mmoire et le cot
+// du trac ne dpendent pas de la frquence d'chantillonnage, et aucun pic n'est perdu.
+class AxisHistory
+{
+private:
+	static constexpr int BUCKET_COUNT = 1024;
+
+	float  bucketMin[BUCKET_COUNT];
+	float  bucketMax[BUCKET_COUNT];
+	Uint64 bucketTicks; // Dure d'un seau (compteur haute rsolution)
+	double duration;
+	Uint64 firstBucket;  // Premier seau renseign depuis la remise  zro
+	Uint64 headBucket;   // Seau le plus rcent
+	Uint64 changeBucket; // Dernier seau o la valeur a vari
+	float  lastValue;    // Tenue dans les seaux sans chantillon
+	bool   hasData;
+
+public:
+	AxisHistory();
+
+	// Dure couverte par l'anneau (vide l'historique)
+	void   setDuration( double seconds );
+	double getDuration() const;
+	void   reset();
+
+	void addSample( Uint64 timestamp, float value );
+
+	// Min/max par colonne sur la fentre qui se termine  now (colonne sans donne: min > max)
+	bool getColumns( Uint64 now, int columnCount, float* outMin, float* outMax ) const;
+
+	// Vrai tant qu'une variation reste dans la fentre qui se termine  now: le trac change encore en dfilant
+	bool isScrolling( Uint64 now ) const;
+};
+
 // Gestionnaire de force feedback
 class ForceManager
 {
@@ -203,22 +1021,79 @@ private:
 	float                    masterStrength;
 	std::vector<ForceEffect> effects;
 	SDL_Haptic*              haptic;
+	SimulatedWheel*          simulatedWheel;
+	int                      stepEffectId; // Effet constant ddi aux mesures de latence
+	int                      hapticAxes;
+	Uint32                   masterScale; // Force globale en virgule fixe (Q16)
+
+	// Paramtres SDL compils et valeurs source ayant servi  les produire
+	struct CompiledEffect
+	{
+		SDL_HapticEffect sdlEffect;
+		Sint16           level; // Amplitude signe (Q15)
+		Uint32           length;
+		Uint16           attack;
+		Uint16           fade;
+		Uint32           attackRate; // Pente de l'enveloppe: gain Q15 par ms, en Q16
+		Uint32           fadeRate;
+		float            strength;
+		float            duration;
+		Uint32           masterScale;
+	};
+	std::vector<CompiledEffect> compiled;
+
+	// Effet tel que vu par le mixeur logiciel
+	struct MixerEffect
+	{
+		EffectKind kind;
+		Uint16     sdlType;
+		Uint16     period;
+		bool       enabled;
+		bool       oneShot; // Jou une seule fois au lieu d'tre boucl
+		Sint16     level;
+		Uint32     length;
+		Uint16     attack;
+		Uint16     fade;
+		Uint32     attackRate;
+		Uint32     fadeRate;
+		Uint64     startTime;
+	};
+
+	// Mixeur logiciel: tous les effets sont combins en un seul flux de force constante
+	bool                     softwareMixing;
+	int                      mixerEffectId;
+	InputSampler*            inputSource;
+	std::thread              mixerThread;
+	std::atomic<bool>        mixerRunning;
+	std::atomic<int>         mixerStep;   // chelon de mesure de latence (Q15)
+	std::atomic<int>         mixerOutput; // Dernire force envoye (Q15)
+	std::mutex               mixerMutex;
+	std::mutex               hapticMutex;
+	std::vector<MixerEffect> mixerEffects; // Publis par le thread principal (protgs par mixerMutex)
+	std::vector<MixerEffect> mixerScratch; // Copie de travail du thread de mixage
+
+	// Compiler un effet en paramtres SDL entiers  partir de son descripteur
+	void compileEffect( size_t index );
+	bool isCompiledCurrent( size_t index ) const;
+
+	// Crer l'effet sur le dispositif haptic
+	void initEffect( size_t index );
+
+	// Dmarrer/arrter le thread de mixage et l'effet constant de sortie
+	void startMixer();
+	void stopMixer();
+	void mixerLoop();
+	void publishMixerEffects();
 
-	// Initialisation des diffrents types d'effets
-	void initConstantEffect( int index );
-	void initSpringEffect( int index );
-	void initDamperEffect( int index );
-	void initFrictionEffect( int index );
-	void initSineEffect( int index );
-	void initSawtoothEffect( int index );
-	void initRumbleEffect( int index );
+	// valuer la somme des effets actifs (Q15, non borne)
+	Sint32 mixForces( const std::vector<MixerEffect>& mix, float position, float velocity, Uint64 now ) const;
 
 public:
 	ForceManager();
 	~ForceManager();
 
 	void       cleanup();
-	ResultCode initialize( SDL_Joystick* joystick, Logger& logger );
+	ResultCode initialize( SDL_Joystick* joystick, unsigned effectMask, Logger& logger );
 
 	// Mettre  jour l'effet avec les paramtres actuels
 	void updateEffect( int index );
@@ -232,6 +1107,23 @@ public:
 	// Arrter tous les effets
 	void stopAllEffects();
 
+	// Dmarrer un chelon de force constante et retourner l'instant d'mission
+	ResultCode startConstantStep( float level, Uint64& outTimestamp, Logger& logger );
+
+	// Relcher l'chelon de force constante
+	void stopConstantStep();
+
+	// Rediriger les commandes de force vers un volant simul (mode dmo)
+	void setSimulatedWheel( SimulatedWheel* simulation );
+
+	// Source de la position du volant pour les effets conditionnels du mixeur
+	void setInputSource( InputSampler* source );
+
+	// Activer le mixage logiciel des effets
+	void setSoftwareMixing( bool enabled, Logger& logger );
+	bool isSoftwareMixing() const;
+	int  getMixerOutput() const;
+
 	// Mettre  jour le retour de force
 	void update( Logger& logger );
 
@@ -243,18 +1135,149 @@ public:
 	std::vector<ForceEffect>& getEffects();
 };
 
+// Base de profils de priphriques, indexe par GUID et par VID/PID
+class DeviceDatabase
+{
+private:
+	std::vector<DeviceProfile>              profiles;
+	std::unordered_map<Uint32, size_t>      byVendorProduct; // ( vendorId << 16 ) | productId
+	std::unordered_map<std::string, size_t> byGuid;
+	DeviceProfile                           genericWheel; // Volant absent de la base
+
+	// Ajouter ou remplacer un profil (un profil de mme cl remplace le prcdent)
+	void addProfile( const DeviceProfile& profile );
+
+public:
+	DeviceDatabase();
+
+	// Lire des profils au format texte [Nom] / cl=valeur
+	size_t     loadFromStream( std::istream& stream );
+	ResultCode loadFromFile( const std::string& filename, Logger& logger );
+
+	// Recherche en temps constant: GUID, puis VID/PID, puis fabricant seul
+	const DeviceProfile* find( Uint16 vendorId, Uint16 productId, const std::string& guid ) const;
+
+	// Profil des volants sans entre dans le fichier, reconnus par leur type SDL ou leur nom
+	const DeviceProfile& getGenericWheel() const;
+
+	size_t getProfileCount() const;
+};
+
+// Thmes de l'interface, au mme format [Nom] / cl=valeur que les profils de priphriques
+class ThemeLibrary
+{
+private:
+	std::vector<UITheme> themes;
+	size_t               current;
+	Uint32               version; // Incrment quand le thme courant change
+
+	// Calculer les couleurs drives puis ajouter ou remplacer le thme de mme nom
+	void addTheme( UITheme theme );
+
+public:
+	ThemeLibrary();
+
+	size_t     loadFromStream( std::istream& stream );
+	ResultCode loadFromFile( const std::string& filename, Logger& logger );
+
+	// Choisir le thme courant (faux si le nom est inconnu)
+	bool select( const std::string& name );
+	void select( size_t index );
+
+	const std::vector<UITheme>& getThemes() const;
+	const UITheme&              getCurrent() const;
+	size_t                      getCurrentIndex() const;
+	Uint32                      getVersion() const;
+
+	// crire tout le style ImGui du thme courant ( appeler seulement quand la version change)
+	void apply( ImGuiStyle& style ) const;
+};
+
 // Gestionnaire de priphrique
 class DeviceManager
 {
 private:
-	SDL_Joystick*         joystick;
 	SDL_Haptic*           haptic;
 	WheelInfo             wheelInfo;
 	std::vector<AxisInfo> axes;
-	std::vector<bool>     buttons;
+	ButtonBits            buttons;
+	ButtonBits            buttonTaps;      // Boutons presss pendant la frame, mme brivement
+	ButtonBits            previousButtons; // tat  la fin de la frame prcdente
+	int                   buttonCount;     // Boutons de la vue fusionne
 	ForceManager          forceManager;
+	SimulatedWheel        simulatedWheel;
+	InputSampler          demoSampler; // chantillonnage du volant simul
 	bool                  usingDemo;
 
+	// Tables de rponse (une par axe), reconstruites quand les rglages changent
+	std::vector<AxisResponseTable> responseTables;
+
+	// Calibrations en cours (une par axe de la vue fusionne)
+	std::vector<AxisCalibrator> calibrators;
+	std::vector<RawInputSample> calibrationSamples;
+
+	// Analyse de la qualit du signal (une par axe), alimente en continu par le flux brut
+	std::vector<AxisSignalAnalyzer> signalAnalyzers;
+	std::vector<RawInputSample>     analysisSamples;
+	Uint64                          demoAnalysisReadIndex;
+
+	// Historique dfilant (un par axe), aliment par le mme flux que l'analyse
+	std::vector<AxisHistory> axisHistories;
+
+	// Priphriques ouverts; le premier est le priphrique principal (volant, retour de force)
+	std::vector<std::unique_ptr<InputDevice>> devices;
+	DeviceDatabase                            database;
+
+	// Calibration des axes mmorise par GUID, rapplique  la rouverture
+	std::map<std::string, std::vector<AxisInfo>> savedCalibrations;
+
+	// Branchements et dbranchements reus, traits pendant la frame
+	std::vector<SDL_JoyDeviceEvent> hotplugEvents;
+
+	// Incrment  chaque changement des axes ou boutons de la vue fusionne
+	Uint32 layoutVersion;
+
+	// Transitions reues depuis la dernire frame, puis appliques pendant la frame
+	std::vector<InputEvent> pendingEvents;
+	std::vector<InputEvent> frameEvents;
+
+	// Basculer en mode dmo avec le volant simul
+	ResultCode startDemoMode( Logger& logger );
+
+	// Ouvrir un joystick et l'ajouter  la vue fusionne
+	bool openDevice( int deviceIndex, const DeviceProfile& profile, bool primary, Logger& logger );
+
+	// Profil d'un joystick non ouvert: entre de la base, sinon profil gnrique pour un volant
+	// reconnu par son type ou son nom (nullptr si ce n'est pas un volant)
+	const DeviceProfile* findProfile( int deviceIndex ) const;
+
+	// Retrouver le priphrique d'un vnement SDL
+	InputDevice* findDevice( SDL_JoystickID instanceId );
+
+	// Branchement  chaud
+	void handleHotplug( RecordingManager& recorder, Logger& logger );
+	void disconnectDevice( size_t deviceIndex, RecordingManager& recorder, Logger& logger );
+	void reattachDevice( size_t deviceIndex, SDL_Joystick* joystick, RecordingManager& recorder, Logger& logger );
+	void saveCalibration( const InputDevice& device );
+
+	// Lire l'tat complet du priphrique ( l'ouverture)
+	void syncInputs();
+
+	// Appliquer la table de rponse  une valeur brute d'axe
+	void applyAxis( int axisIndex, Sint16 raw );
+
+	// Reconstruire les tables dont les rglages ont chang
+	void refreshResponseTables();
+
+	// Alimenter les calibrations actives avec les chantillons reus depuis la frame prcdente
+	void updateCalibrations();
+
+	// Alimenter l'analyse du signal avec les chantillons bruts reus depuis la frame prcdente
+	void updateSignalAnalysis();
+
+	// Priphrique qui porte un axe de la vue fusionne
+	InputDevice* findAxisDevice( int axisIndex, int& outLocalIndex );
+
 public:
 	DeviceManager();
 	~DeviceManager();
@@ -262,6 +1285,12 @@ public:
 	void       cleanup();
 	ResultCode initialize( Logger& logger );
 
+	// Charger les profils de priphriques
+	ResultCode loadDeviceDatabase( const std::string& filename, Logger& logger );
+
+	// Recevoir les vnements SDL du joystick
+	void processEvent( const SDL_Event& event );
+
 	// Mise  jour des entres
 	void updateInputs( RecordingManager& recorder, AutoTestManager& autoTest, Logger& logger );
 
@@ -269,14 +1298,268 @@ public:
 	ResultCode reloadDevice( Logger& logger );
 
 	// Getters
-	WheelInfo&             getWheelInfo();
-	std::vector<AxisInfo>& getAxes();
-	std::vector<bool>&     getButtons();
-	ForceManager&          getForceManager();
-	bool                   isUsingDemo() const;
+	WheelInfo&                     getWheelInfo();
+	std::vector<AxisInfo>&         getAxes();
+	ButtonBits&                    getButtons();
+	const ButtonBits&              getButtonTaps() const;
+	int                            getButtonCount() const;
+	const std::vector<InputEvent>& getFrameEvents() const;
+	ForceManager&                  getForceManager();
+	InputSampler&                  getSampler();
+	SimulatedWheel&                getSimulatedWheel();
+	bool                           isUsingDemo() const;
+	Uint32                         getLayoutVersion() const;
+
+	// Tous les priphriques ouverts, dans l'ordre de la vue fusionne
+	const std::vector<std::unique_ptr<InputDevice>>& getDevices() const;
+
+	// Calibration non bloquante: dmarrer, puis terminer pour appliquer les extrmes mesurs
+	void                  calibrateAxis( int axisIndex, Logger& logger );
+	void                  finishCalibration( int axisIndex, Logger& logger );
+	void                  cancelCalibration( int axisIndex );
+	const AxisCalibrator* getCalibrator( int axisIndex ) const;
+	bool                  isCalibrating() const;
+
+	// chantillonneur qui porte un axe et voie de l'axe dans ses chantillons (nullptr si l'axe n'est pas chantillonn)
+	InputSampler* getAxisSampler( int axisIndex, int& outLane );
+
+	// Qualit du signal des axes
+	AxisSignalAnalyzer* getSignalAnalyzer( int axisIndex );
+	const AxisHistory*  getAxisHistory( int axisIndex ) const;
+	void                resetSignalAnalysis();
+	ResultCode          exportSignalAnalysis( const std::string& filename ) const;
+};
+
+// Mesure de la latence aller-retour du retour de force
+class LatencyTester
+{
+private:
+	enum State
+	{
+		IDLE,
+		SETTLING,
+		WAITING_MOTION,
+		DONE
+	};
+
+	State                       state;
+	int                         iterations;
+	int                         completed;
+	int                         timeouts;
+	float                       stepLevel;
+	float                       threshold;
+	float                       timeoutMs;
+	float                       settleMs;
+	float                       direction;
+	Uint64                      stateStart;
+	Uint64                      stepTimestamp;
+	Uint64                      readIndex;
+	Sint16                      baseline;
+	std::vector<double>         latencies;
+	std::vector<RawInputSample> pendingSamples;
+	LatencyStats                stats;
+
+	void computeStats();
+
+public:
+	LatencyTester();
+
+	ResultCode start( int count, float level, float motionThreshold, InputSampler& sampler, Logger& logger );
+	void       stop( ForceManager& forceManager, Logger& logger );
+
+	// Faire avancer la mesure (appel  chaque frame)
+	void update( InputSampler& sampler, ForceManager& forceManager, Logger& logger );
+
+	bool                isRunning() const;
+	bool                hasResults() const;
+	int                 getCompleted() const;
+	int                 getIterations() const;
+	const LatencyStats& getStats() const;
+};
+
+// FFT relle radix 2: un signal de N points passe par une FFT complexe de N/2 points
+class RealFFT
+{
+private:
+	int                              size;
+	std::vector<int>                 bitReverse; // Permutation de la FFT complexe de size / 2 points
+	std::vector<std::complex<float>> twiddles;   // exp(-2i.pi.k / size), k < size / 2
+	std::vector<std::complex<float>> work;
+
+	// Papillons radix 2 de la FFT complexe de size / 2 points (work dj permut)
+	void butterflies();
+
+public:
+	RealFFT();
+
+	// size doit tre une puissance de deux (au moins 4)
+	bool setSize( int fftSize );
+	int  getSize() const;
+
+	// Raies 0  size / 2 du spectre d'un signal rel de size points
+	void forward( const float* input, std::vector<std::complex<float>>& output );
+
+	// Signal rel de size points  partir de ses raies 0  size / 2 (inverse de forward)
+	void inverse( const std::vector<std::complex<float>>& spectrum, float* output );
+};
+
+// Analyse spectrale des axes sur un thread de travail: fentre glissante sur le flux haute frquence,
+// ou moyenne de Welch sur un enregistrement complet. Le thread de l'interface ne fait que copier.
+class SpectrumAnalyzer
+{
+private:
+	std::thread             worker;
+	std::atomic<bool>       running;
+	std::atomic<bool>       busy;
+	mutable std::mutex      mutex;
+	std::condition_variable wake;
+
+	// Paramtres et donnes partags (protgs par mutex)
+	int                                   fftSize;
+	SpectrumWindow                        windowType;
+	std::vector<float>                    history; // Fentre glissante circulaire (SPECTRUM_MAX_SIZE valeurs)
+	std::vector<Uint64>                   historyTimes;
+	Uint64                                historyWrite;
+	Uint64                                newSamples;
+	bool                                  offlinePending;
+	std::vector<double>                   offlineTimes;
+	std::vector<float>                    offlineValues;
+	float                                 offlineRate;
+	bool                                  offlineHold; // Valeurs tenues entre deux transitions (sinon interpoles)
+	std::shared_ptr<const SpectrumResult> liveResult;
+	std::shared_ptr<const SpectrumResult> offlineResult;
+
+	// tat du thread de travail
+	RealFFT                          fft;
+	SpectrumWindow                   preparedWindow;
+	std::vector<float>               coefficients;
+	double                           coefficientSum;
+	std::vector<float>               frame;
+	std::vector<std::complex<float>> bins;
+	std::vector<double>              power;
+
+	void run();
+	void prepare( int size, SpectrumWindow type );
+
+	// Ajouter la puissance d'une fentre (moyenne retire)  la somme
+	void accumulate( const float* values );
 
-	// Calibrer un axe
-	void calibrateAxis( int axisIndex, Logger& logger );
+	std::shared_ptr<SpectrumResult> finish( int windowCount, float sampleRate ) const;
+	std::shared_ptr<SpectrumResult> analyzeSeries( std::vector<double>& times, std::vector<float>& values, float sampleRate, bool hold, int size, SpectrumWindow type );
+
+public:
+	SpectrumAnalyzer();
+	~SpectrumAnalyzer();
+
+	void start();
+	void stop();
+
+	void           configure( int size, SpectrumWindow type );
+	int            getSize() const;
+	SpectrumWindow getWindow() const;
+
+	// Ajouter les chantillons bruts d'une voie  la fentre glissante
+	void pushSamples( const std::vector<RawInputSample>& samples, int lane );
+	void clearHistory();
+
+	// Analyser une srie complte (horodatages en secondes, valeurs en pleine chelle [-1, 1])
+	void analyzeOffline( std::vector<double> times, std::vector<float> values, float sampleRate, bool hold );
+
+	std::shared_ptr<const SpectrumResult> getLiveResult() const;
+	std::shared_ptr<const SpectrumResult> getOfflineResult() const;
+	bool                                  isBusy() const;
+
+	static const char* getWindowName( SpectrumWindow type );
+};
+
+// Analyse des fronts de boutons: appuis, dures de maintien, intervalles et rebonds
+// Mmoire fixe et cot constant par transition, utilisable pendant la capture  pleine cadence
+class ButtonAnalyzer
+{
+private:
+	std::vector<ButtonTimingStats> stats; // MAX_BUTTONS entres, alloues une fois
+	double                         bounceWindow; // Secondes
+	Uint32                         transitionCount;
+
+	void applyTransition( ButtonTimingStats& button, bool pressed, double timestamp );
+
+public:
+	ButtonAnalyzer();
+
+	void reset();
+
+	// Fronts plus proches que cette fentre du front prcdent = rebonds de contact
+	void  setBounceWindowMs( float windowMs );
+	float getBounceWindowMs() const;
+
+	// Ajouter une transition horodate (secondes)
+	void addTransition( int button, bool pressed, double timestamp );
+
+	// Ajouter les transitions de boutons d'une frame
+	void addEvents( const std::vector<InputEvent>& events );
+
+	const ButtonTimingStats& getStats( int button ) const;
+	bool                     hasData() const;
+
+	// Exporter le rsum et les histogrammes des boutons actifs
+	ResultCode exportCSV( const std::string& filename, int buttonCount ) const;
+};
+
+// Mesure du taux de rapport  partir des vnements SDL du priphrique, horodats  leur rception
+// (filtre d'vnements, sur le thread principal qui seul met  jour les joysticks). Les vnements
+// d'un mme rapport arrivent ensemble et sont regroups. La rsolution est celle de la lecture des
+// joysticks par le thread principal (environ 1 ms pendant l'attente des vnements).
+class PollingRateMeter
+{
+public:
+	static constexpr double BIN_US        = 10.0; // Largeur des classes d'intervalles
+	static constexpr int    BIN_COUNT     = 2000; // Jusqu' 20 ms, la dernire classe est ouverte
+	static constexpr double REPORT_GAP_US = 50.0; // vnements plus proches: mme rapport
+
+private:
+	bool           running;
+	SDL_JoystickID instanceId;
+
+	// Rapports reus par le filtre d'vnements depuis la frame prcdente
+	std::mutex          eventMutex;
+	std::vector<Uint64> pendingReports;
+	std::vector<Uint64> reports;
+	Uint64              lastEvent;
+	bool                detached; // Priphrique dbranch pendant la mesure
+
+	// Rapports et intervalles (mmoire fixe)
+	std::vector<Uint32> histogram;
+	Uint64              reportCount;
+	Uint64              firstReport;
+	Uint64              lastReport;
+	Uint64              intervalCount;
+	double              intervalSumUs;
+	double              intervalMaxUs;
+
+	double getPercentileUs( double fraction ) const;
+
+	// Compter les rapports reus depuis la frame prcdente
+	void readReports();
+
+	static int SDLCALL onEvent( void* userdata, SDL_Event* event );
+
+public:
+	PollingRateMeter();
+	~PollingRateMeter();
+
+	// Mesurer le joystick donn (ouvert par le gestionnaire de priphriques)
+	ResultCode start( SDL_JoystickID joystickId );
+	void       stop();
+
+	// Compter les rapports reus depuis la frame prcdente; la mesure s'arrte si le priphrique est dbranch
+	void update();
+
+	bool         isRunning() const;
+	bool         hasResults() const;
+	PollingStats getStats() const;
+
+	// Histogramme regroup en barres jusqu' rangeMs
+	void getDisplayHistogram( std::vector<float>& bars, int barCount, double rangeMs ) const;
 };
 
 // Application principale
@@ -287,6 +1570,11 @@ private:
 	DeviceManager    deviceManager;
 	RecordingManager recordingManager;
 	AutoTestManager  autoTestManager;
+	LatencyTester    latencyTester;
+	ButtonAnalyzer   buttonAnalyzer;
+	SpectrumAnalyzer spectrumAnalyzer;
+	PollingRateMeter pollingMeter;
+	ThemeLibrary     themeLibrary;
 	Config           config;
 
 	// Variables pour l'interface
@@ -295,8 +1583,83 @@ private:
 	static const char*     testModes[];
 	char                   logFilename[128];
 	float                  collisionStrength;
+	int                    latencyIterations;
+	float                  latencyStepLevel;
+	float                  latencyThreshold;
+	int                    analyzedButton; // Bouton dont les histogrammes sont affichs (-1: aucun)
 	std::string            configFilename;
 
+	// Analyse spectrale: axe choisi et lecture du flux haute frquence
+	int                         spectrumAxis;
+	int                         spectrumSizeIndex;
+	bool                        spectrumLive;
+	Uint64                      spectrumReadIndex;
+	std::vector<RawInputSample> spectrumSamples;
+
+	// Transmettre les nouveaux chantillons de l'axe choisi  l'analyse spectrale
+	void feedSpectrum();
+
+	// Lancer l'analyse spectrale de l'axe choisi sur l'enregistrement courant
+	void analyzeRecordingSpectrum();
+
+	// Rendu  la demande: une entre ou le journal a chang depuis le dernier rendu
+	bool   renderRequested;
+	Uint64 lastLogCount;
+
+	// Libells construits une fois par disposition des priphriques: une frame stable n'alloue rien
+	std::vector<std::string> buttonLabels;
+	Uint32                   labelsVersion;
+	std::vector<float>       pollingBars;
+	Uint64                   frameAllocations; // Allocations de la dernire frame de l'interface
+
+	// Reconstruire les libells si les axes ou boutons ont chang
+	void updateLabels();
+
+	// Style ImGui crit pour cette version du thme (le style n'est pas rcrit  chaque frame)
+	Uint32 appliedThemeVersion;
+
+	// En-tte de section repliable aux couleurs du thme
+	bool sectionHeader( const char* label, ImGuiTreeNodeFlags flags = 0 );
+
+	// Tracs dfilants des axes: une colonne min/max par pixel
+	static constexpr Uint32 HISTORY_FRAME_MS = 33; // Dfilement sans nouvelle entre (~30 images/s)
+	bool                    showAxisHistory;
+	bool                    axisHistoryScrolling; // Un trac visible dfilait encore  la dernire frame
+	Uint32                  lastHistoryRender;
+	std::vector<float>      historyMin;
+	std::vector<float>      historyMax;
+
+	// Vrai si le trac est visible  l'cran
+	bool drawAxisHistory( const AxisHistory& history, bool unipolar, const ImVec4& color, const ImVec2& size );
+
+	// Navigation dans l'enregistrement: vue d'ensemble zoomable (une voie par axe)
+	char   recordingFilename[256];
+	double timelineStart;
+	double timelineEnd;
+	Uint32 timelineVersion; // La vue revient  l'enregistrement complet quand l'index est reconstruit
+	int    timelineLevel;   // Niveau de la pyramide le plus grossier lu  la dernire frame
+
+	void drawRecordingTimeline( float width );
+
+	// Comparaison de la capture courante (rfrence) avec un enregistrement charg, en arrire-plan
+	char                             comparisonFilename[256];
+	float                            comparisonThreshold;
+	std::future<RecordingComparison> comparisonTask;
+	RecordingComparison              comparison;
+
+	void startComparison();
+
+	// Analyse par lots d'un dossier d'enregistrements, en arrire-plan
+	BatchAnalyzer           batchAnalyzer;
+	char                    batchDirectory[256];
+	std::future<ResultCode> batchTask;
+
+	// Export du fichier d'enregistrement en CSV ou Arrow, en arrire-plan
+	std::future<ResultCode> exportTask;
+	std::string             exportFilename;
+
+	void startExport( bool arrow );
+
 	// Obtenir une chane de date/heure formate pour les noms de fichiers
 	std::string getCurrentTimeString();
 
@@ -307,9 +1670,18 @@ public:
 	// Initialiser l'application
 	ResultCode initialize();
 
+	// Transmettre un vnement SDL  l'application
+	void handleEvent( const SDL_Event& event );
+
 	// Boucle de mise  jour principale
 	void update();
 
+	// L'interface doit tre redessine (entres ou journal modifis, donnes animes)
+	bool needsRender();
+
+	// Une activit (enregistrement, test, mesure) demande des mises  jour  pleine cadence
+	bool isBusy() const;
+
 	// Charger la configuration
 	ResultCode loadConfig();
 
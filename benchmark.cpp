@@ -0,0 +1,424 @@
+#include "UI.h"
+#include <stdio.h>
+#include <string.h>
+#include <ctime>
+
+// Banc de mesure des chemins critiques: normalisation des axes, enregistrement, journal et retour de force.
+// Chaque mesure tourne sur des données synthétiques à plusieurs tailles, sans périphérique ni fenêtre, et
+// les résultats sont écrits en JSON pour suivre les régressions d'une version à l'autre:
+//   wheel_benchmark [résultats.json] [--quick]
+// --quick omet la plus grande taille de chaque série (intégration continue).
+
+// Résultat d'une mesure
+struct BenchmarkResult
+{
+	std::string name;
+	size_t      size;       // Taille des données synthétiques (échantillons, instantanés, messages, mises à jour)
+	size_t      operations; // Opérations mesurées
+	double      seconds;    // Meilleur temps sur les passes
+	double      bytes;      // Octets traités (0 si sans objet)
+};
+
+static std::vector<BenchmarkResult> benchmarkResults;
+
+// Fichiers temporaires (supprimés en fin de mesure)
+static const char* BENCHMARK_RECORDING = "wheel_benchmark.dat";
+static const char* BENCHMARK_LOG       = "wheel_benchmark.log";
+
+static double elapsedSeconds( Uint64 start )
+{
+	return (double)( SDL_GetPerformanceCounter() - start ) / (double)SDL_GetPerformanceFrequency();
+}
+
+// Meilleur temps de plusieurs passes (les grandes tailles n'en font qu'une)
+template<typename Pass>
+static double bestTime( int passes, Pass pass )
+{
+	double best = 0.0;
+	for( int i = 0; i < passes; ++i )
+	{
+		Uint64 start   = SDL_GetPerformanceCounter();
+		pass();
+		double seconds = elapsedSeconds( start );
+
+		if( i == 0 || seconds < best )
+		{
+			best = seconds;
+		}
+	}
+	return best;
+}
+
+static void addResult( const std::string& name, size_t size, size_t operations, double seconds, double bytes = 0.0 )
+{
+	benchmarkResults.push_back( { name, size, operations, seconds, bytes } );
+
+	double nsPerOperation = operations ? seconds * 1e9 / (double)operations : 0.0;
+	fprintf( stderr, "%-34s %9zu  %12.1f ns/op", name.c_str(), size, nsPerOperation );
+	if( bytes > 0.0 && seconds > 0.0 )
+	{
+		fprintf( stderr, "  %9.1f Mo/s", bytes / seconds / ( 1024.0 * 1024.0 ) );
+	}
+	fprintf( stderr, "\n" );
+}
+
+// Axes représentatifs d'un volant et de son pédalier (courbes, zones mortes, pédales inversées)
+static std::vector<AxisInfo> makeAxes()
+{
+	std::vector<AxisInfo> axes;
+	for( int i = 0; i < MAX_SAMPLED_AXES; ++i )
+	{
+		AxisInfo axis;
+		axis.name       = "Axe " + std::to_string( i );
+		axis.value      = 0.0f;
+		axis.min        = -1.0f;
+		axis.max        = 1.0f;
+		axis.deadzone   = 0.02f * (float)( i % 4 );
+		axis.rawValue   = 0.0f;
+		axis.inverted   = ( i % 3 ) == 1;
+		axis.curve      = 1.0f + 0.25f * (float)( i % 5 );
+		axis.saturation = ( i % 2 ) ? 0.95f : 1.0f;
+		axis.unipolar   = i >= 1 && i <= 3;
+		axes.push_back( axis );
+	}
+	return axes;
+}
+
+// Normalisation des axes: construction des tables de réponse, puis chemin de chaque transition reçue
+// (applyAxisResponse, appelé par DeviceManager::applyAxis) sur un flux synthétique d'événements
+static void benchmarkInputMapping( const std::vector<size_t>& sizes )
+{
+	std::vector<AxisInfo> axes = makeAxes();
+
+	const int                      rebuilds = 64;
+	std::vector<AxisResponseTable> tables( axes.size() );
+	double                         seconds  = bestTime( 3, [&]()
+	{
+		for( int r = 0; r < rebuilds; ++r )
+		{
+			for( size_t i = 0; i < axes.size(); ++i )
+			{
+				buildAxisResponseTable( axes[i], tables[i] );
+			}
+		}
+	} );
+	addResult( "mapping.buildResponseTable", axes.size(), rebuilds * axes.size(), seconds );
+
+	for( size_t eventCount : sizes )
+	{
+		// Transitions réparties sur les axes: rampes décalées avec quelques pas de bruit, comme un volant en mouvement
+		std::vector<InputEvent> events( eventCount );
+		for( size_t i = 0; i < eventCount; ++i )
+		{
+			InputEvent& event = events[i];
+			event.timestamp   = (double)i * 0.000125;
+			event.type        = INPUT_EVENT_AXIS;
+			event.index       = (Uint8)( i % axes.size() );
+			event.value       = (Sint16)(Uint16)( i * 7 + event.index * 8191 + ( i * 2654435761u >> 28 ) );
+		}
+
+		int    passes  = eventCount >= 1000000 ? 1 : 3;
+		double applied = bestTime( passes, [&]()
+		{
+			for( const auto& event : events )
+			{
+				applyAxisResponse( axes[event.index], tables[event.index], event.value );
+			}
+		} );
+		addResult( "mapping.applyAxis", eventCount, eventCount, applied, (double)eventCount * sizeof( InputEvent ) );
+	}
+
+	double checksum = 0.0;
+	for( const auto& axis : axes )
+	{
+		checksum += axis.value + axis.rawValue;
+	}
+	if( checksum > 1e9 )
+	{
+		fprintf( stderr, "\n" ); // Empêche l'élimination de la boucle d'application
+	}
+}
+
+// Enregistrement: ajout d'instantanés, recherche temporelle, sauvegarde et chargement
+static void benchmarkRecording( const std::vector<size_t>& sizes, Logger& logger )
+{
+	std::vector<AxisInfo> axes = makeAxes();
+	ButtonBits            buttons;
+	buttons.clear();
+
+	const size_t queryCount = 100000;
+
+	for( size_t snapshotCount : sizes )
+	{
+		int passes = snapshotCount >= 1000000 ? 1 : 3;
+
+		RecordingManager recording;
+		double           stopSeconds = 0.0;
+		double           addSeconds  = bestTime( passes, [&]()
+		{
+			recording.startRecording();
+			for( size_t i = 0; i < snapshotCount; ++i )
+			{
+				// Signal synthétique: rampes décalées et un bouton sur seize qui change
+				for( size_t a = 0; a < axes.size(); ++a )
+				{
+					axes[a].value = (float)( ( i + a * 997 ) % 2001 ) / 1000.0f - 1.0f;
+				}
+				buttons.set( (int)( i % 32 ), ( i & 16 ) != 0 );
+				recording.addSnapshot( axes, buttons, 32 );
+			}
+
+			// La vue d'ensemble est construite en arrière-plan à l'arrêt: mesurée jusqu'à sa publication
+			Uint64 start   = SDL_GetPerformanceCounter();
+			recording.stopRecording();
+			recording.waitForOverview();
+			double seconds = elapsedSeconds( start );
+			stopSeconds    = ( stopSeconds == 0.0 || seconds < stopSeconds ) ? seconds : stopSeconds;
+		} );
+		addResult( "recording.addSnapshot", snapshotCount, snapshotCount, addSeconds );
+		addResult( "recording.stopRecording", snapshotCount, 1, stopSeconds );
+
+		ResultCode result = recording.saveRecording( BENCHMARK_RECORDING );
+		if( result != SUCCESS )
+		{
+			logger.log( Logger::ERROR, "Banc de mesure: sauvegarde impossible dans " + std::string( BENCHMARK_RECORDING ) );
+			continue;
+		}
+
+		double saveSeconds = bestTime( passes, [&]()
+		{
+			recording.saveRecording( BENCHMARK_RECORDING );
+		} );
+
+		double fileSize = 0.0;
+		FILE*  file     = fopen( BENCHMARK_RECORDING, "rb" );
+		if( file )
+		{
+			fseek( file, 0, SEEK_END );
+			fileSize = (double)ftell( file );
+			fclose( file );
+		}
+		addResult( "recording.saveRecording", snapshotCount, 1, saveSeconds, fileSize );
+
+		RecordingManager loaded;
+		double           loadSeconds = bestTime( passes, [&]()
+		{
+			loaded.loadRecording( BENCHMARK_RECORDING );
+			loaded.waitForOverview();
+		} );
+		addResult( "recording.loadRecording", snapshotCount, 1, loadSeconds, fileSize );
+
+		// Instants pseudo-aléatoires (reproductibles) répartis sur toute la durée
+		std::vector<float> queries( queryCount );
+		float              duration = loaded.getTotalDuration();
+		Uint32             seed     = 12345;
+		for( float& query : queries )
+		{
+			seed  = seed * 1664525u + 1013904223u;
+			query = (float)( seed >> 8 ) / (float)( 1u << 24 ) * duration;
+		}
+
+		InputSnapshot snapshot;
+		double        checksum     = 0.0;
+		double        querySeconds = bestTime( 3, [&]()
+		{
+			for( float query : queries )
+			{
+				if( loaded.getSnapshotAtTime( query, snapshot ) )
+				{
+					checksum += snapshot.timestamp;
+				}
+			}
+		} );
+		addResult( "recording.getSnapshotAtTime", snapshotCount, queryCount, querySeconds );
+
+		if( checksum < 0.0 )
+		{
+			fprintf( stderr, "\n" ); // Empêche l'élimination de la boucle de recherche
+		}
+	}
+
+	remove( BENCHMARK_RECORDING );
+}
+
+// Journal: console (sortie standard redirigée vers le périphérique nul) et fichier
+static void benchmarkLogger( const std::vector<size_t>& sizes )
+{
+	for( size_t messageCount : sizes )
+	{
+		int passes = messageCount >= 100000 ? 1 : 3;
+
+		Logger console;
+		double consoleSeconds = bestTime( passes, [&]()
+		{
+			for( size_t i = 0; i < messageCount; ++i )
+			{
+				console.log( Logger::INFO, "Axe 0: valeur mise à jour" );
+			}
+		} );
+		addResult( "logger.log.console", messageCount, messageCount, consoleSeconds );
+
+		Logger toFile;
+		if( toFile.initialize( BENCHMARK_LOG, true, false ) != SUCCESS )
+		{
+			continue;
+		}
+
+		double fileSeconds = bestTime( passes, [&]()
+		{
+			for( size_t i = 0; i < messageCount; ++i )
+			{
+				toFile.log( Logger::INFO, "Axe 0: valeur mise à jour" );
+			}
+		} );
+		addResult( "logger.log.file", messageCount, messageCount, fileSeconds );
+
+		toFile.setLogToFile( false, "" );
+	}
+
+	remove( BENCHMARK_LOG );
+}
+
+// Retour de force: construction des paramètres des effets par le mixage logiciel.
+// Sans volant, update() recompile les effets modifiés et publie leurs paramètres sans démarrer le mixeur.
+static void benchmarkForce( const std::vector<size_t>& sizes, Logger& logger )
+{
+	for( size_t updateCount : sizes )
+	{
+		int passes = updateCount >= 100000 ? 1 : 3;
+
+		ForceManager force;
+		force.setSoftwareMixing( true, logger );
+
+		std::vector<ForceEffect>& effects = force.getEffects();
+		for( ForceEffect& effect : effects )
+		{
+			effect.enabled = true;
+		}
+
+		// Chaque mise à jour modifie tous les effets: recompilation complète
+		double compileSeconds = bestTime( passes, [&]()
+		{
+			for( size_t i = 0; i < updateCount; ++i )
+			{
+				for( ForceEffect& effect : effects )
+				{
+					effect.strength = ( i & 1 ) ? 40.0f : 60.0f;
+				}
+				force.update( logger );
+			}
+		} );
+		addResult( "force.compileEffects", updateCount, updateCount * effects.size(), compileSeconds );
+
+		// Paramètres inchangés: seule la publication vers le mixeur est payée
+		double publishSeconds = bestTime( passes, [&]()
+		{
+			for( size_t i = 0; i < updateCount; ++i )
+			{
+				force.update( logger );
+			}
+		} );
+		addResult( "force.publishUnchanged", updateCount, updateCount, publishSeconds );
+	}
+}
+
+static bool writeResults( const std::string& filename )
+{
+	std::ofstream file( filename );
+	if( !file.is_open() )
+	{
+		return false;
+	}
+
+	char      date[32];
+	time_t    now   = time( nullptr );
+	struct tm local = *localtime( &now );
+	strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%S", &local );
+
+#if defined( _MSC_VER )
+	std::string compiler = "MSVC " + std::to_string( _MSC_VER );
+#else
+	std::string compiler = __VERSION__;
+#endif
+
+	file << "{\n";
+	file << "\t\"date\": \"" << date << "\",\n";
+	file << "\t\"platform\": \"" << SDL_GetPlatform() << "\",\n";
+	file << "\t\"compiler\": \"" << compiler << "\",\n";
+	file << "\t\"cpuCount\": " << SDL_GetCPUCount() << ",\n";
+	file << "\t\"results\": [\n";
+
+	file.precision( 9 );
+	for( size_t i = 0; i < benchmarkResults.size(); ++i )
+	{
+		const BenchmarkResult& result = benchmarkResults[i];
+
+		double nsPerOperation      = result.operations ? result.seconds * 1e9 / (double)result.operations : 0.0;
+		double operationsPerSecond = result.seconds > 0.0 ? (double)result.operations / result.seconds : 0.0;
+		double bytesPerSecond      = result.seconds > 0.0 ? result.bytes / result.seconds : 0.0;
+
+		file << "\t\t{ \"name\": \"" << result.name << "\", \"size\": " << result.size
+			 << ", \"operations\": " << result.operations << ", \"seconds\": " << result.seconds
+			 << ", \"nsPerOperation\": " << nsPerOperation << ", \"operationsPerSecond\": " << operationsPerSecond
+			 << ", \"bytesPerSecond\": " << bytesPerSecond << " }"
+			 << ( i + 1 < benchmarkResults.size() ? ",\n" : "\n" );
+	}
+
+	file << "\t]\n";
+	file << "}\n";
+	return file.good();
+}
+
+int main( int argc, char* argv[] )
+{
+	std::string output = "benchmark_results.json";
+	bool        quick  = false;
+
+	for( int i = 1; i < argc; ++i )
+	{
+		if( strcmp( argv[i], "--quick" ) == 0 )
+		{
+			quick = true;
+		}
+		else
+		{
+			output = argv[i];
+		}
+	}
+
+	// Le journal écrit chaque message sur la sortie standard: elle ne doit pas peser sur les mesures
+#if defined( _WIN32 )
+	freopen( "NUL", "w", stdout );
+#else
+	freopen( "/dev/null", "w", stdout );
+#endif
+
+	std::vector<size_t> mappingSizes   = { 1024, 65536, 1048576 };
+	std::vector<size_t> recordingSizes = { 1000, 100000, 1000000 };
+	std::vector<size_t> loggerSizes    = { 1000, 10000, 100000 };
+	std::vector<size_t> forceSizes     = { 1000, 10000, 100000 };
+
+	if( quick )
+	{
+		mappingSizes.pop_back();
+		recordingSizes.pop_back();
+		loggerSizes.pop_back();
+		forceSizes.pop_back();
+	}
+
+	Logger logger;
+
+	benchmarkInputMapping( mappingSizes );
+	benchmarkRecording( recordingSizes, logger );
+	benchmarkLogger( loggerSizes );
+	benchmarkForce( forceSizes, logger );
+
+	if( !writeResults( output ) )
+	{
+		fprintf( stderr, "Impossible d'écrire %s\n", output.c_str() );
+		return 1;
+	}
+
+	fprintf( stderr, "Résultats écrits dans %s\n", output.c_str() );
+	return 0;
+}
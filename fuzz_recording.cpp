@@ -0,0 +1,17 @@
+#include "UI.h"
+
+// Cible libFuzzer du chargeur d'enregistrements (option CMake WHEELTEST_FUZZ, Clang ou MSVC).
+// Toute entrée doit être chargée ou rejetée proprement, sans dépassement ni allocation démesurée:
+//   fuzz_recording -rss_limit_mb=512 -max_len=65536 corpus/
+// Des fichiers record_*.dat valides forment un bon corpus de départ.
+extern "C" int LLVMFuzzerTestOneInput( const uint8_t* data, size_t size )
+{
+	RecordingManager recording;
+	if( recording.loadRecordingFromMemory( data, size ) == SUCCESS )
+	{
+		// Un enregistrement accepté doit être exploitable par le reste de l'application
+		InputSnapshot snapshot;
+		recording.getSnapshotAtTime( recording.getTotalDuration() * 0.5f, snapshot );
+	}
+	return 0;
+}
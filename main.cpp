@@ -3,6 +3,7 @@
 #include "imgui_impl_sdlrenderer2.h"
 #include <SDL.h>
 #include <stdio.h>
+#include <string.h>
 #include "UI.h"
 
 // Ajout des entêtes spécifiques pour Prospero (PS5) si nécessaire
@@ -21,8 +22,47 @@ int main( int argc, char** argv )
     sceKernelRegisterCallbackHandler(); // Exemple, à remplacer par l'API correcte
 #endif
 
+	// Mode lots: analyser un dossier d'enregistrements sans interface
+	//   --batch <dossier> [résumé.csv]
+	if( argc >= 3 && strcmp( argv[1], "--batch" ) == 0 )
+	{
+		BatchAnalyzer analyzer;
+		const char*   output = argc >= 4 ? argv[3] : "batch_summary.csv";
+		ResultCode    result = analyzer.run( argv[2] );
+		if( result == SUCCESS )
+		{
+			result = analyzer.exportCSV( output );
+		}
+
+		if( result != SUCCESS )
+		{
+			fprintf( stderr, "Erreur: analyse par lots de %s impossible (code %d)\n", argv[2], result );
+			return result;
+		}
+
+		printf( "%zu enregistrements analysés en %.2f s (%.1f enregistrements/s, %zu tâches volées), %zu avec anomalies -> %s\n",
+				analyzer.getFileCount(), analyzer.getElapsedSeconds(), analyzer.getThroughput(), analyzer.getStolenCount(),
+				analyzer.getAnomalyCount(), output );
+		return 0;
+	}
+
+	// Export d'un enregistrement pour les outils d'analyse (format choisi par l'extension)
+	//   --export <enregistrement.dat> <sortie.csv|sortie.arrow>
+	if( argc >= 4 && strcmp( argv[1], "--export" ) == 0 )
+	{
+		std::string output = argv[3];
+		bool        csv    = output.size() >= 4 && output.compare( output.size() - 4, 4, ".csv" ) == 0;
+		ResultCode  result = csv ? exportRecordingCSV( argv[2], output ) : exportRecordingArrow( argv[2], output );
+		if( result != SUCCESS )
+		{
+			fprintf( stderr, "Erreur: export de %s vers %s impossible (code %d)\n", argv[2], argv[3], result );
+			return result;
+		}
+		return 0;
+	}
+
 	// Configuration de SDL
-	if( SDL_Init( SDL_INIT_VIDEO | SDL_INIT_TIMER ) != 0 )
+	if( SDL_Init( SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_JOYSTICK | SDL_INIT_HAPTIC ) != 0 )
 	{
 		printf( "Erreur: %s\n", SDL_GetError() );
 		return -1;
@@ -96,20 +136,52 @@ int main( int argc, char** argv )
 		return ERROR_SDL_INIT_FAILED;
 	}
 
+	// Cadence adaptative: les entrées sont mises à jour à cadence fixe, l'interface n'est redessinée
+	// que lorsqu'elle change. L'échantillonnage et le retour de force ont leurs propres threads.
+	const Uint32 UPDATE_PERIOD_MS    = 16;  // Mise à jour des entrées (instantanés d'enregistrement, effets)
+	const Uint32 IDLE_PERIOD_MS      = 100; // Fenêtre réduite ou cachée, aucune activité en cours
+	const Uint32 UNFOCUSED_PERIOD_MS = 33;  // Rendu limité sans le focus
+	const Uint32 REFRESH_PERIOD_MS   = 500; // Rafraîchissement minimal (statistiques, FPS)
+	const int    INTERACTION_FRAMES  = 3;   // Frames après une interaction, le temps que l'interface se stabilise
+
+	Uint32 lastUpdate    = 0;
+	Uint32 lastRender    = 0;
+	int    pendingFrames = INTERACTION_FRAMES;
+
 	// Boucle principale
 	bool done = false;
 	while( !done )
 	{
-		// Gérer les événements SDL
+		Uint32 windowFlags = SDL_GetWindowFlags( window );
+		bool   hidden      = ( windowFlags & ( SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN ) ) != 0;
+		bool   focused     = ( windowFlags & SDL_WINDOW_INPUT_FOCUS ) != 0;
+		Uint32 period      = hidden && !app.isBusy() ? IDLE_PERIOD_MS : UPDATE_PERIOD_MS;
+
+		// Attendre le prochain événement ou la prochaine mise à jour au lieu de tourner à vide
+		Uint32    elapsed  = SDL_GetTicks() - lastUpdate;
 		SDL_Event event;
-		while( SDL_PollEvent( &event ) )
+		bool      hasEvent = elapsed < period ? SDL_WaitEventTimeout( &event, period - elapsed ) != 0 : SDL_PollEvent( &event ) != 0;
+
+		// Gérer les événements SDL
+		for( ; hasEvent; hasEvent = SDL_PollEvent( &event ) != 0 )
 		{
 			ImGui_ImplSDL2_ProcessEvent( &event );
+
+			// Souris, clavier, fenêtre, manette de navigation: redessiner tout de suite
+			bool joystickEvent = event.type >= SDL_JOYAXISMOTION && event.type < SDL_CONTROLLERAXISMOTION;
+			if( !joystickEvent )
+			{
+				pendingFrames = INTERACTION_FRAMES;
+			}
+
 			if( event.type == SDL_QUIT )
 				done = true;
 			if( event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == SDL_GetWindowID( window ) )
 				done = true;
 
+			// Transitions du joystick (axes et boutons horodatés)
+			app.handleEvent( event );
+
 #ifdef _SCE_TARGET_OS_PROSPERO
             // Gestion des événements spécifiques à la manette PS5
             if (event.type == SDL_CONTROLLERBUTTONDOWN && event.cbutton.button == SDL_CONTROLLER_BUTTON_BACK)
@@ -118,7 +190,29 @@ int main( int argc, char** argv )
 		}
 
 		// Mettre à jour la logique de l'application
-		app.update();
+		Uint32 now = SDL_GetTicks();
+		if( now - lastUpdate >= period )
+		{
+			lastUpdate = now;
+			app.update();
+			if( app.needsRender() )
+			{
+				pendingFrames = std::max( pendingFrames, 1 );
+			}
+		}
+
+		// Rien à redessiner: fenêtre invisible, ou interface inchangée depuis le dernier rafraîchissement
+		if( hidden || ( pendingFrames == 0 && now - lastRender < REFRESH_PERIOD_MS ) )
+		{
+			continue;
+		}
+		if( !focused && now - lastRender < UNFOCUSED_PERIOD_MS )
+		{
+			continue;
+		}
+
+		pendingFrames = std::max( pendingFrames - 1, 0 );
+		lastRender    = now;
 
 		// Débuter une nouvelle frame ImGui
 		ImGui_ImplSDLRenderer2_NewFrame();